@@ -99,7 +99,7 @@ $(call BUILD_SHARED_LIB_XDBG, \
 	$(lib/libbse.so), \
 	$(bse/libbse.objects), \
 	bse/ldscript.map | $>/lib/, \
-	$(BSEDEPS_LIBS) $(ALSA_LIBS) -lstdc++fs)
+	$(BSEDEPS_LIBS) $(ALSA_LIBS) -lstdc++fs -ldl)
 $(call INSTALL_DATA_RULE,			\
 	bse/headers,				\
 	$(DESTDIR)$(bse/include.headerdir),	\
@@ -158,30 +158,44 @@ ws_close (websocketpp::connection_hdl hdl)
                  it != ws_opened_connections.end() ? "" : " (unknown)");
   if (it != ws_opened_connections.end())
     ws_opened_connections.erase (it);
-  for (auto it = ws_instance_maps.begin(); it != ws_instance_maps.end(); ++it)
-    if (websocketpp_connection_hdl_equals (it->first, hdl))
-      {
-        Jsonipc::InstanceMap *imap = it->second;
-        ws_instance_maps.erase (it);
-        delete imap;
-        break;
-      }
+  // instance maps are used by the BSE thread, release after pending requests
+  Bse::jobs.async ([hdl] () {
+    for (auto it = ws_instance_maps.begin(); it != ws_instance_maps.end(); ++it)
+      if (websocketpp_connection_hdl_equals (it->first, hdl))
+        {
+          Jsonipc::InstanceMap *imap = it->second;
+          ws_instance_maps.erase (it);
+          delete imap;
+          break;
+        }
+  });
 }
 
 static websocketpp::connection_hdl *bse_current_websocket_hdl = NULL;
+static std::atomic<int> ws_pending_requests { 0 };
 
 static void
 ws_message (websocketpp::connection_hdl hdl, server::message_ptr msg)
 {
-  const std::string &message = msg->get_payload();
-  // send message to BSE thread and block until its been handled
-  Bse::jobs += [&message, &hdl] () {
-    bse_current_websocket_hdl = &hdl;
-    std::string reply = handle_jsonipc (message, hdl);
+  // requests are pipelined, the BSE thread handles them in order while the websocket
+  // thread keeps reading, only a deep backlog blocks the websocket thread
+  constexpr int MAX_PENDING_REQUESTS = 256;
+  auto handle_request = [msg, hdl] () {
+    websocketpp::connection_hdl chdl = hdl;
+    bse_current_websocket_hdl = &chdl;
+    std::string reply = handle_jsonipc (msg->get_payload(), chdl);
     bse_current_websocket_hdl = NULL;
+    ws_pending_requests--;
     if (!reply.empty())
-      websocket_server.send (hdl, reply, websocketpp::frame::opcode::text);
+      {
+        websocketpp::lib::error_code ec;
+        websocket_server.send (chdl, reply, websocketpp::frame::opcode::text, ec); // connection may be gone
+      }
   };
+  if (++ws_pending_requests < MAX_PENDING_REQUESTS)
+    Bse::jobs.async (handle_request);
+  else
+    Bse::jobs += handle_request;
 }
 
 /// Provide an IPC handler implementation that marshals and sends binary data onto the wire.
@@ -206,7 +220,7 @@ struct IpcHandlerImpl : Bse::IpcHandler {
   {
     BSE_ASSERT_RETURN (bse_current_websocket_hdl != nullptr, BinarySender());
     websocketpp::connection_hdl weak_hdl = *bse_current_websocket_hdl;
-    auto binary_sender = [weak_hdl] (std::string message) {
+    auto binary_sender = [weak_hdl] (const std::string &message) {
       websocketpp::lib::error_code ec;
       websocket_server.send (weak_hdl, message, websocketpp::frame::opcode::binary, ec);
       if (ec)
@@ -136,12 +136,433 @@ class BlockImpl : virtual public Bse::Block::Impl {
 static BlockImpl default_block_impl;
 } // Anon
 
+#if defined __x86_64__ || defined __amd64__
+#include <immintrin.h>
+
+#define BLOCK_AVX2      __attribute__ ((target ("avx2,fma")))
+#define BLOCK_AVX512    __attribute__ ((target ("avx512f")))
+
+namespace {
+
+// Unaligned loads and stores carry no penalty on the 64-byte aligned Processor::FloatBuffer
+// blocks, so no alignment fixups are needed and unaligned legacy callers stay correct.
+
+BLOCK_AVX2 static inline float
+avx2_reduce_add (__m256 v)
+{
+  __m128 s = _mm_add_ps (_mm256_castps256_ps128 (v), _mm256_extractf128_ps (v, 1));
+  s = _mm_add_ps (s, _mm_movehl_ps (s, s));
+  s = _mm_add_ss (s, _mm_movehdup_ps (s));
+  return _mm_cvtss_f32 (s);
+}
+
+BLOCK_AVX2 static inline float
+avx2_reduce_min (__m256 v)
+{
+  __m128 s = _mm_min_ps (_mm256_castps256_ps128 (v), _mm256_extractf128_ps (v, 1));
+  s = _mm_min_ps (s, _mm_movehl_ps (s, s));
+  s = _mm_min_ss (s, _mm_movehdup_ps (s));
+  return _mm_cvtss_f32 (s);
+}
+
+BLOCK_AVX2 static inline float
+avx2_reduce_max (__m256 v)
+{
+  __m128 s = _mm_max_ps (_mm256_castps256_ps128 (v), _mm256_extractf128_ps (v, 1));
+  s = _mm_max_ps (s, _mm_movehl_ps (s, s));
+  s = _mm_max_ss (s, _mm_movehdup_ps (s));
+  return _mm_cvtss_f32 (s);
+}
+
+/// Duplicate each of the 8 floats in @a v into @a lo (elements 0..3) and @a hi (elements 4..7).
+BLOCK_AVX2 static inline void
+avx2_duplicate (__m256 v, __m256 &lo, __m256 &hi)
+{
+  const __m256 l = _mm256_unpacklo_ps (v, v), h = _mm256_unpackhi_ps (v, v);
+  lo = _mm256_permute2f128_ps (l, h, 0x20);
+  hi = _mm256_permute2f128_ps (l, h, 0x31);
+}
+
+class BlockImplAVX2 : virtual public Bse::Block::Impl {
+  virtual const char*
+  impl_name ()
+  {
+    return "AVX2";
+  }
+  BLOCK_AVX2 virtual void
+  add (guint        n_values,
+       float       *ovalues,
+       const float *ivalues)
+  {
+    guint i = 0;
+    for (; i + 8 <= n_values; i += 8)
+      _mm256_storeu_ps (ovalues + i, _mm256_add_ps (_mm256_loadu_ps (ovalues + i), _mm256_loadu_ps (ivalues + i)));
+    for (; i < n_values; i++)
+      ovalues[i] += ivalues[i];
+  }
+  BLOCK_AVX2 virtual void
+  sub (guint        n_values,
+       float       *ovalues,
+       const float *ivalues)
+  {
+    guint i = 0;
+    for (; i + 8 <= n_values; i += 8)
+      _mm256_storeu_ps (ovalues + i, _mm256_sub_ps (_mm256_loadu_ps (ovalues + i), _mm256_loadu_ps (ivalues + i)));
+    for (; i < n_values; i++)
+      ovalues[i] -= ivalues[i];
+  }
+  BLOCK_AVX2 virtual void
+  mul (guint        n_values,
+       float       *ovalues,
+       const float *ivalues)
+  {
+    guint i = 0;
+    for (; i + 8 <= n_values; i += 8)
+      _mm256_storeu_ps (ovalues + i, _mm256_mul_ps (_mm256_loadu_ps (ovalues + i), _mm256_loadu_ps (ivalues + i)));
+    for (; i < n_values; i++)
+      ovalues[i] *= ivalues[i];
+  }
+  BLOCK_AVX2 virtual void
+  scale (guint        n_values,
+         float       *ovalues,
+         const float *ivalues,
+         const float  level)
+  {
+    const __m256 level_m = _mm256_set1_ps (level);
+    guint i = 0;
+    for (; i + 8 <= n_values; i += 8)
+      _mm256_storeu_ps (ovalues + i, _mm256_mul_ps (_mm256_loadu_ps (ivalues + i), level_m));
+    for (; i < n_values; i++)
+      ovalues[i] = ivalues[i] * level;
+  }
+  BLOCK_AVX2 virtual void
+  interleave2 (guint	       n_ivalues,
+               float          *ovalues,         /* length_ovalues = n_ivalues * 2 */
+               const float    *ivalues,
+               guint           offset)          /* 0=left, 1=right */
+  {
+    const __m256i mask = offset ? _mm256_setr_epi32 (0, -1, 0, -1, 0, -1, 0, -1) : _mm256_setr_epi32 (-1, 0, -1, 0, -1, 0, -1, 0);
+    guint i = 0;
+    for (; i + 8 <= n_ivalues; i += 8)
+      {
+        __m256 lo, hi;
+        avx2_duplicate (_mm256_loadu_ps (ivalues + i), lo, hi);
+        _mm256_maskstore_ps (ovalues + 2 * i, mask, lo);
+        _mm256_maskstore_ps (ovalues + 2 * i + 8, mask, hi);
+      }
+    for (; i < n_ivalues; i++)
+      ovalues[2 * i + offset] = ivalues[i];
+  }
+  BLOCK_AVX2 virtual void
+  interleave2_add (guint           n_ivalues,
+                   float          *ovalues,	/* length_ovalues = n_ivalues * 2 */
+                   const float    *ivalues,
+                   guint           offset)      /* 0=left, 1=right */
+  {
+    const __m256i mask = offset ? _mm256_setr_epi32 (0, -1, 0, -1, 0, -1, 0, -1) : _mm256_setr_epi32 (-1, 0, -1, 0, -1, 0, -1, 0);
+    guint i = 0;
+    for (; i + 8 <= n_ivalues; i += 8)
+      {
+        __m256 lo, hi;
+        avx2_duplicate (_mm256_loadu_ps (ivalues + i), lo, hi);
+        _mm256_maskstore_ps (ovalues + 2 * i, mask, _mm256_add_ps (_mm256_loadu_ps (ovalues + 2 * i), lo));
+        _mm256_maskstore_ps (ovalues + 2 * i + 8, mask, _mm256_add_ps (_mm256_loadu_ps (ovalues + 2 * i + 8), hi));
+      }
+    for (; i < n_ivalues; i++)
+      ovalues[2 * i + offset] += ivalues[i];
+  }
+  BLOCK_AVX2 virtual void
+  range (guint        n_values,
+         const float *ivalues,
+	 float&       min_value,
+	 float&       max_value)
+  {
+    if (!n_values)
+      {
+        min_value = max_value = 0;
+        return;
+      }
+    float minv = ivalues[0], maxv = ivalues[0];
+    guint i = 0;
+    if (n_values >= 8)
+      {
+        __m256 min_m = _mm256_loadu_ps (ivalues), max_m = min_m;
+        for (i = 8; i + 8 <= n_values; i += 8)
+          {
+            const __m256 v = _mm256_loadu_ps (ivalues + i);
+            min_m = _mm256_min_ps (min_m, v);
+            max_m = _mm256_max_ps (max_m, v);
+          }
+        minv = avx2_reduce_min (min_m);
+        maxv = avx2_reduce_max (max_m);
+      }
+    for (; i < n_values; i++)
+      {
+        minv = std::min (minv, ivalues[i]);
+        maxv = std::max (maxv, ivalues[i]);
+      }
+    min_value = minv;
+    max_value = maxv;
+  }
+  BLOCK_AVX2 virtual float
+  square_sum (guint        n_values,
+              const float *ivalues)
+  {
+    __m256 sum_m = _mm256_setzero_ps();
+    guint i = 0;
+    for (; i + 8 <= n_values; i += 8)
+      {
+        const __m256 v = _mm256_loadu_ps (ivalues + i);
+        sum_m = _mm256_fmadd_ps (v, v, sum_m);
+      }
+    float square_sum = avx2_reduce_add (sum_m);
+    for (; i < n_values; i++)
+      square_sum += ivalues[i] * ivalues[i];
+    return square_sum;
+  }
+  BLOCK_AVX2 virtual float
+  range_and_square_sum (guint        n_values,
+                        const float *ivalues,
+	                float&       min_value,
+	                float&       max_value)
+  {
+    if (!n_values)
+      {
+        min_value = max_value = 0;
+        return 0;
+      }
+    float minv = ivalues[0], maxv = ivalues[0], square_sum = 0;
+    guint i = 0;
+    if (n_values >= 8)
+      {
+        __m256 min_m = _mm256_loadu_ps (ivalues), max_m = min_m, sum_m = _mm256_mul_ps (min_m, min_m);
+        for (i = 8; i + 8 <= n_values; i += 8)
+          {
+            const __m256 v = _mm256_loadu_ps (ivalues + i);
+            sum_m = _mm256_fmadd_ps (v, v, sum_m);
+            min_m = _mm256_min_ps (min_m, v);
+            max_m = _mm256_max_ps (max_m, v);
+          }
+        square_sum = avx2_reduce_add (sum_m);
+        minv = avx2_reduce_min (min_m);
+        maxv = avx2_reduce_max (max_m);
+      }
+    for (; i < n_values; i++)
+      {
+        square_sum += ivalues[i] * ivalues[i];
+        minv = std::min (minv, ivalues[i]);
+        maxv = std::max (maxv, ivalues[i]);
+      }
+    min_value = minv;
+    max_value = maxv;
+    return square_sum;
+  }
+};
+static BlockImplAVX2 avx2_block_impl;
+
+// GCC-12 intrinsic headers trigger bogus warnings about _mm512_undefined_ps() (GCC PR105593)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+/// Mask selecting the first @a n of 16 elements.
+static inline __mmask16
+avx512_tail_mask (guint n)
+{
+  return n >= 16 ? 0xffff : (1 << n) - 1;
+}
+
+
+class BlockImplAVX512 : virtual public Bse::Block::Impl {
+  virtual const char*
+  impl_name ()
+  {
+    return "AVX512";
+  }
+  BLOCK_AVX512 virtual void
+  add (guint        n_values,
+       float       *ovalues,
+       const float *ivalues)
+  {
+    for (guint i = 0; i < n_values; i += 16)
+      {
+        const __mmask16 m = avx512_tail_mask (n_values - i);
+        _mm512_mask_storeu_ps (ovalues + i, m, _mm512_add_ps (_mm512_maskz_loadu_ps (m, ovalues + i), _mm512_maskz_loadu_ps (m, ivalues + i)));
+      }
+  }
+  BLOCK_AVX512 virtual void
+  sub (guint        n_values,
+       float       *ovalues,
+       const float *ivalues)
+  {
+    for (guint i = 0; i < n_values; i += 16)
+      {
+        const __mmask16 m = avx512_tail_mask (n_values - i);
+        _mm512_mask_storeu_ps (ovalues + i, m, _mm512_sub_ps (_mm512_maskz_loadu_ps (m, ovalues + i), _mm512_maskz_loadu_ps (m, ivalues + i)));
+      }
+  }
+  BLOCK_AVX512 virtual void
+  mul (guint        n_values,
+       float       *ovalues,
+       const float *ivalues)
+  {
+    for (guint i = 0; i < n_values; i += 16)
+      {
+        const __mmask16 m = avx512_tail_mask (n_values - i);
+        _mm512_mask_storeu_ps (ovalues + i, m, _mm512_mul_ps (_mm512_maskz_loadu_ps (m, ovalues + i), _mm512_maskz_loadu_ps (m, ivalues + i)));
+      }
+  }
+  BLOCK_AVX512 virtual void
+  scale (guint        n_values,
+         float       *ovalues,
+         const float *ivalues,
+         const float  level)
+  {
+    const __m512 level_m = _mm512_set1_ps (level);
+    for (guint i = 0; i < n_values; i += 16)
+      {
+        const __mmask16 m = avx512_tail_mask (n_values - i);
+        _mm512_mask_storeu_ps (ovalues + i, m, _mm512_mul_ps (_mm512_maskz_loadu_ps (m, ivalues + i), level_m));
+      }
+  }
+  BLOCK_AVX512 virtual void
+  interleave2 (guint	       n_ivalues,
+               float          *ovalues,         /* length_ovalues = n_ivalues * 2 */
+               const float    *ivalues,
+               guint           offset)          /* 0=left, 1=right */
+  {
+    const __m512i lo_index = _mm512_setr_epi32 (0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+    const __m512i hi_index = _mm512_setr_epi32 (8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15);
+    const __mmask16 channel = offset ? 0xaaaa : 0x5555;
+    guint i = 0;
+    for (; i + 16 <= n_ivalues; i += 16)
+      {
+        const __m512 v = _mm512_loadu_ps (ivalues + i);
+        _mm512_mask_storeu_ps (ovalues + 2 * i, channel, _mm512_permutexvar_ps (lo_index, v));
+        _mm512_mask_storeu_ps (ovalues + 2 * i + 16, channel, _mm512_permutexvar_ps (hi_index, v));
+      }
+    for (; i < n_ivalues; i++)
+      ovalues[2 * i + offset] = ivalues[i];
+  }
+  BLOCK_AVX512 virtual void
+  interleave2_add (guint           n_ivalues,
+                   float          *ovalues,	/* length_ovalues = n_ivalues * 2 */
+                   const float    *ivalues,
+                   guint           offset)      /* 0=left, 1=right */
+  {
+    const __m512i lo_index = _mm512_setr_epi32 (0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7);
+    const __m512i hi_index = _mm512_setr_epi32 (8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13, 14, 14, 15, 15);
+    const __mmask16 channel = offset ? 0xaaaa : 0x5555;
+    guint i = 0;
+    for (; i + 16 <= n_ivalues; i += 16)
+      {
+        const __m512 v = _mm512_loadu_ps (ivalues + i);
+        float *o = ovalues + 2 * i;
+        _mm512_mask_storeu_ps (o, channel, _mm512_add_ps (_mm512_loadu_ps (o), _mm512_permutexvar_ps (lo_index, v)));
+        _mm512_mask_storeu_ps (o + 16, channel, _mm512_add_ps (_mm512_loadu_ps (o + 16), _mm512_permutexvar_ps (hi_index, v)));
+      }
+    for (; i < n_ivalues; i++)
+      ovalues[2 * i + offset] += ivalues[i];
+  }
+  BLOCK_AVX512 virtual void
+  range (guint        n_values,
+         const float *ivalues,
+	 float&       min_value,
+	 float&       max_value)
+  {
+    if (!n_values)
+      {
+        min_value = max_value = 0;
+        return;
+      }
+    __m512 min_m = _mm512_set1_ps (ivalues[0]), max_m = min_m;
+    for (guint i = 0; i < n_values; i += 16)
+      {
+        const __mmask16 m = avx512_tail_mask (n_values - i);
+        const __m512 v = _mm512_maskz_loadu_ps (m, ivalues + i);
+        min_m = _mm512_mask_min_ps (min_m, m, min_m, v);
+        max_m = _mm512_mask_max_ps (max_m, m, max_m, v);
+      }
+    min_value = _mm512_reduce_min_ps (min_m);
+    max_value = _mm512_reduce_max_ps (max_m);
+  }
+  BLOCK_AVX512 virtual float
+  square_sum (guint        n_values,
+              const float *ivalues)
+  {
+    __m512 sum_m = _mm512_setzero_ps();
+    for (guint i = 0; i < n_values; i += 16)
+      {
+        const __m512 v = _mm512_maskz_loadu_ps (avx512_tail_mask (n_values - i), ivalues + i);
+        sum_m = _mm512_fmadd_ps (v, v, sum_m);
+      }
+    return _mm512_reduce_add_ps (sum_m);
+  }
+  BLOCK_AVX512 virtual float
+  range_and_square_sum (guint        n_values,
+                        const float *ivalues,
+	                float&       min_value,
+	                float&       max_value)
+  {
+    if (!n_values)
+      {
+        min_value = max_value = 0;
+        return 0;
+      }
+    __m512 min_m = _mm512_set1_ps (ivalues[0]), max_m = min_m, sum_m = _mm512_setzero_ps();
+    for (guint i = 0; i < n_values; i += 16)
+      {
+        const __mmask16 m = avx512_tail_mask (n_values - i);
+        const __m512 v = _mm512_maskz_loadu_ps (m, ivalues + i);
+        sum_m = _mm512_fmadd_ps (v, v, sum_m);
+        min_m = _mm512_mask_min_ps (min_m, m, min_m, v);
+        max_m = _mm512_mask_max_ps (max_m, m, max_m, v);
+      }
+    min_value = _mm512_reduce_min_ps (min_m);
+    max_value = _mm512_reduce_max_ps (max_m);
+    return _mm512_reduce_add_ps (sum_m);
+  }
+};
+static BlockImplAVX512 avx512_block_impl;
+#pragma GCC diagnostic pop
+
+} // Anon
+#endif // __x86_64__
+
+namespace {
+static Bse::Block::Impl*
+block_impl_select ()
+{
+  Bse::Block::Impl *impl = &default_block_impl;
+  for (auto candidate : Bse::Block::available_singletons())
+    impl = candidate;   // pick the widest supported implementation
+  return impl;
+}
+} // Anon
+
 namespace Bse {
 
+/// The widest implementation supported by the CPU, selected on first use.
 Block::Impl*
 Block::default_singleton ()
 {
-  return &default_block_impl;
+  static Impl *const impl = block_impl_select();
+  return impl;
+}
+
+/// List the implementations supported by the CPU, starting with the default implementation.
+std::vector<Block::Impl*>
+Block::available_singletons ()
+{
+  std::vector<Impl*> impls = { &default_block_impl };
+#if defined __x86_64__ || defined __amd64__
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma"))
+    impls.push_back (&avx2_block_impl);
+  if (__builtin_cpu_supports ("avx512f"))
+    impls.push_back (&avx512_block_impl);
+#endif
+  return impls;
 }
 
 Block::Impl *Block::singleton = &default_block_impl;
@@ -152,6 +573,13 @@ Block::current_singleton ()
   return Block::singleton;
 }
 
+/// Switch block operations to @a impl, e.g. to compare implementations from available_singletons().
+void
+Block::select_singleton (Impl *impl)
+{
+  Impl::substitute (impl);
+}
+
 Block::Impl::~Impl()
 {}
 
@@ -159,7 +587,7 @@ void
 Block::Impl::substitute (Impl *substitute_impl)
 {
   if (!substitute_impl)
-    substitute_impl = &default_block_impl;
+    substitute_impl = default_singleton();
   Block::singleton = substitute_impl;
 }
 
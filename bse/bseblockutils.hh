@@ -150,6 +150,8 @@ public:
   };
   static Impl*  default_singleton       ();
   static Impl*  current_singleton       ();
+  static std::vector<Impl*> available_singletons ();
+  static void   select_singleton        (Impl           *impl);
 private:
   static Impl  *singleton;
 };
@@ -84,5 +84,9 @@
 #define BSE_WAVE_CHUNK_PADDING          (8)
 #define BSE_DCACHE_BLOCK_SIZE           (4096)
 #define BSE_DCACHE_CACHE_MEMORY         (64 * 1024 * 1024)
+#define BSE_DCACHE_READAHEAD_NODES      (8)     /* nodes prefetched during sequential access */
+#define BSE_DCACHE_IO_THREADS           (2)
+#define BSE_DCACHE_PCM_MEMORY           (32 * 1024 * 1024)      /* decoded PCM tier, held in memory */
+#define BSE_DCACHE_PCM_SCRATCH          (512 * 1024 * 1024)     /* decoded PCM tier, spilled to scratch file */
 
 #endif /* __BSE_CONST_VALUES_H__ */
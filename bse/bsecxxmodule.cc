@@ -409,7 +409,7 @@ Effect::block_size() const
 uint
 Effect::max_block_size() const
 {
-  return BSE_ENGINE_MAX_BLOCK_SIZE;
+  return bse_engine_max_block_size();
 }
 
 Bse::MusicalTuning
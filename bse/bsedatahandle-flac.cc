@@ -226,6 +226,8 @@ public:
     setup->bit_depth = FLAC__stream_decoder_get_bits_per_sample (m_decoder);
     setup->mix_freq = FLAC__stream_decoder_get_sample_rate (m_decoder);
     setup->xinfos = bse_xinfos_add_float (setup->xinfos, "osc-freq", m_osc_freq);
+    setup->needs_cache = TRUE;
+    m_dhandle.content_id = gsl_hfile_content_id (m_rfile->hfile, string_format ("flac:%d:%d", m_file_byte_offset, m_file_byte_size).c_str());
 
     return Bse::Error::NONE;
   }
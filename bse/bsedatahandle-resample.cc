@@ -16,6 +16,13 @@ struct CDataHandleResample2 : public GslDataHandle
   DataHandleResample2* cxx_dh;
 };
 
+class DataHandleResampleN;
+
+struct CDataHandleResampleN : public GslDataHandle
+{
+  DataHandleResampleN* cxx_dh;
+};
+
 class DataHandleResample2
 {
 protected:
@@ -451,6 +458,217 @@ public:
   }
 };
 
+/* Arbitrary ratio resampling, every frame of output is computed from the
+ * input window around it, so seeking needs no filter history preparation.
+ */
+class DataHandleResampleN
+{
+  CDataHandleResampleN  m_dhandle;
+  GslDataHandle	       *m_src_handle;
+  double                m_mix_freq;
+  int                   m_precision_bits;
+  std::unique_ptr<ResamplerN> m_resampler;      /* stateless process_frames(), shared by all channels */
+  int64			m_pcm_frame;
+  vector<float>		m_pcm_data;
+  vector<float>		m_input_interleaved;
+  vector<float>		m_input;
+  vector<float>		m_output;
+  int64			m_frame_size;
+  bool			m_init_ok;
+public:
+  DataHandleResampleN (GslDataHandle *src_handle,
+                       double         mix_freq,
+                       int            precision_bits) :
+    m_src_handle (src_handle),
+    m_mix_freq (mix_freq),
+    m_precision_bits (precision_bits),
+    m_pcm_frame (-1),
+    m_frame_size (0),
+    m_init_ok (false)
+  {
+    assert_return (src_handle != NULL);
+    assert_return (mix_freq > 0);
+
+    memset (&m_dhandle, 0, sizeof (m_dhandle));
+    m_init_ok = gsl_data_handle_common_init (&m_dhandle, NULL);
+    if (m_init_ok)
+      {
+        gsl_data_handle_ref (m_src_handle);
+        m_dhandle.name = g_strconcat (m_src_handle->name, "// #resample /", NULL);
+      }
+  }
+  ~DataHandleResampleN()
+  {
+    if (m_init_ok)
+      {
+	gsl_data_handle_unref (m_src_handle);
+	gsl_data_handle_common_free (&m_dhandle);
+      }
+  }
+  Bse::Error
+  open (GslDataHandleSetup *setup)
+  {
+    Bse::Error error = gsl_data_handle_open (m_src_handle);
+    if (error != Bse::Error::NONE)
+      return error;
+
+    *setup = m_src_handle->setup; /* copies setup.xinfos by pointer */
+    const Resampler2::Precision precision = Resampler2::find_precision_for_bits (m_precision_bits);
+    m_resampler.reset (new ResamplerN (setup->mix_freq, m_mix_freq, precision));
+
+    const ResamplerN &resampler = *m_resampler;
+    setup->mix_freq = setup->mix_freq * resampler.phases() / resampler.step();
+    setup->n_values = resampler.output_length (setup->n_values / setup->n_channels) * setup->n_channels;
+    m_frame_size = 1024 * setup->n_channels;
+    m_pcm_frame = -1;
+    m_pcm_data.resize (m_frame_size);
+    m_output.resize (m_frame_size / setup->n_channels);
+    return Bse::Error::NONE;
+  }
+  void
+  close()
+  {
+    m_resampler.reset();
+    m_pcm_data.clear();
+    m_input_interleaved.clear();
+    m_input.clear();
+    m_output.clear();
+
+    m_dhandle.setup.xinfos = NULL;	/* cleanup pointer reference */
+    gsl_data_handle_close (m_src_handle);
+  }
+  int64
+  read_frame (int64 frame)
+  {
+    const int64 n_channels = m_dhandle.setup.n_channels;
+    const int64 first = frame * m_frame_size / n_channels, n_output = m_frame_size / n_channels;
+    const ResamplerN &resampler = *m_resampler;
+    const int64 n_input = resampler.input_length (first, n_output);
+    /* n_input varies by one sample between frames, so this only allocates for the first frames */
+    m_input_interleaved.resize (n_input * n_channels);
+    m_input.resize (n_input);
+    float *input_interleaved = &m_input_interleaved[0], *input = &m_input[0], *output = &m_output[0];
+
+    /* the filter needs input before and after the source data, which is zero */
+    int64 voffset = (resampler.input_index (first) - resampler.history()) * n_channels;
+    for (int64 i = 0; i < n_input * n_channels; )
+      {
+        int64 l = 1;
+        if (voffset + i >= 0 && voffset + i < m_src_handle->setup.n_values)
+          {
+            l = gsl_data_handle_read (m_src_handle, voffset + i, std::min (n_input * n_channels - i, m_src_handle->setup.n_values - voffset - i),
+                                      &input_interleaved[i]);
+            if (l < 0)
+              return l; /* pass on errors */
+          }
+        else
+          input_interleaved[i] = 0;
+        i += l;
+      }
+    for (int64 ch = 0; ch < n_channels; ch++)
+      {
+        for (int64 i = 0; i < n_input; i++)
+          input[i] = input_interleaved[i * n_channels + ch];
+        resampler.process_frames (input, first, n_output, output);
+        for (int64 i = 0; i < n_output; i++)
+          m_pcm_data[i * n_channels + ch] = output[i];
+      }
+    m_pcm_frame = frame;
+    return 1;
+  }
+  int64
+  read (int64  voffset,
+	int64  n_values,
+	float *values)
+  {
+    int64 frame = voffset / m_frame_size;
+    if (frame != m_pcm_frame)
+      {
+	int64 l = read_frame (frame);
+	if (l < 0)
+	  return l;
+      }
+    voffset -= m_pcm_frame * m_frame_size;
+    n_values = std::min (n_values, m_frame_size - voffset);
+    std::copy (m_pcm_data.begin() + voffset, m_pcm_data.begin() + voffset + n_values, values);
+    return n_values;
+  }
+  int64
+  get_state_length() const
+  {
+    int64 source_state_length = gsl_data_handle_get_state_length (m_src_handle);
+    // m_src_handle must be opened and have valid state size
+    assert_return (source_state_length >= 0, 0);
+    assert_return (m_resampler != nullptr, 0);
+
+    /* an input sample affects the output samples up to history() input samples later */
+    const ResamplerN &resampler = *m_resampler;
+    const int64 n_channels = m_dhandle.setup.n_channels;
+    const int64 state_frames = source_state_length / n_channels + resampler.history();
+    return resampler.output_length (state_frames) * n_channels;
+  }
+  static GslDataHandle*
+  dh_create (DataHandleResampleN *cxx_dh)
+  {
+    static GslDataHandleFuncs dh_vtable =
+    {
+      dh_open,
+      dh_read,
+      dh_close,
+      NULL,
+      dh_get_state_length,
+      dh_destroy,
+    };
+
+    if (cxx_dh->m_init_ok)
+      {
+	cxx_dh->m_dhandle.vtable = &dh_vtable;
+	cxx_dh->m_dhandle.cxx_dh = cxx_dh;	/* make casts work, later on */
+	return &cxx_dh->m_dhandle;
+      }
+    else
+      {
+	delete cxx_dh;
+	return NULL;
+      }
+  }
+private:
+/* for the "C" API (vtable) */
+  static DataHandleResampleN*
+  dh_cast (GslDataHandle *dhandle)
+  {
+    return static_cast<CDataHandleResampleN *> (dhandle)->cxx_dh;
+  }
+  static Bse::Error
+  dh_open (GslDataHandle *dhandle, GslDataHandleSetup *setup)
+  {
+    return dh_cast (dhandle)->open (setup);
+  }
+  static void
+  dh_close (GslDataHandle *dhandle)
+  {
+    dh_cast (dhandle)->close();
+  }
+  static void
+  dh_destroy (GslDataHandle *dhandle)
+  {
+    delete dh_cast (dhandle);
+  }
+  static int64
+  dh_read (GslDataHandle *dhandle,
+	   int64          voffset,
+	   int64          n_values,
+	   gfloat        *values)
+  {
+    return dh_cast (dhandle)->read (voffset, n_values, values);
+  }
+  static int64
+  dh_get_state_length (GslDataHandle *dhandle)
+  {
+    return dh_cast (dhandle)->get_state_length();
+  }
+};
+
 } // Bse
 
 using namespace Bse;
@@ -470,3 +688,12 @@ bse_data_handle_new_downsample2 (GslDataHandle *src_handle,
   DataHandleResample2 *cxx_dh = new DataHandleDownsample2 (src_handle, precision_bits);
   return DataHandleResample2::dh_create (cxx_dh);
 }
+
+GslDataHandle*
+bse_data_handle_new_resample (GslDataHandle *src_handle,
+                              double         mix_freq,
+                              int            precision_bits)
+{
+  DataHandleResampleN *cxx_dh = new DataHandleResampleN (src_handle, mix_freq, precision_bits);
+  return DataHandleResampleN::dh_create (cxx_dh);
+}
@@ -926,7 +926,7 @@ bse_trans_open (void)
 {
   BseTrans *trans;
 
-  trans = sfi_new_struct0 (BseTrans, 1);
+  trans = new BseTrans();
 
   trans->jobs_head = NULL;
   trans->jobs_tail = NULL;
@@ -1221,13 +1221,14 @@ bse_module_new_virtual (guint       n_iostreams,
 /* --- setup & trigger --- */
 static bool bse_engine_initialized = false;
 const uint  bse_engine_exvar_sample_freq = 48000;
-uint        bse_engine_exvar_block_size = BSE_ENGINE_MAX_BLOCK_SIZE;
+uint        bse_engine_exvar_block_size = 128;
+uint        bse_engine_exvar_max_block_size = 128;
 
-/// Adjust the block size used per render iteration.
+/// Adjust the block size used per render iteration, limited by bse_engine_max_block_size().
 void
 bse_engine_update_block_size (uint new_block_size)
 {
-  assert_return (new_block_size <= BSE_ENGINE_MAX_BLOCK_SIZE);
+  assert_return (new_block_size <= bse_engine_max_block_size());
   assert_return (new_block_size >= 16);
   assert_return ((new_block_size & (16 - 1)) == 0); // check multiple of 16 for SIMD
   bse_engine_exvar_block_size = new_block_size;
@@ -1320,6 +1321,9 @@ bse_engine_init()
 {
   assert_return (bse_engine_initialized == FALSE);
   bse_engine_initialized = TRUE;
+  /* buffer sizes are fixed from here on */
+  bse_engine_exvar_max_block_size = Bse::config_int ("block-size", bse_engine_exvar_max_block_size);
+  bse_engine_exvar_block_size = bse_engine_exvar_max_block_size;
   /* setup threading */
   Bse::MasterThread::start (bse_main_wakeup);
   /* first configure */
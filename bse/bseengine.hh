@@ -5,7 +5,7 @@
 #include <bse/bseenginenode.hh>
 
 /* --- constants --- */
-#define BSE_ENGINE_MAX_BLOCK_SIZE               (128)
+#define BSE_ENGINE_MAX_BLOCK_SIZE               (1024)  // upper limit for bse_engine_max_block_size()
 #define BSE_MODULE_N_OSTREAMS(module)           ((module)->n_ostreams)
 #define BSE_MODULE_N_ISTREAMS(module)           ((module)->n_istreams)
 #define BSE_MODULE_N_JSTREAMS(module)           ((module)->n_jstreams)
@@ -183,7 +183,26 @@ void       bse_engine_add_user_callback       (gpointer      data,
 void       bse_engine_wait_on_trans           (void);
 guint64    bse_engine_tick_stamp_from_systime (guint64       systime);
 void       bse_engine_update_block_size       (uint new_block_size);
+struct BseEngineJobStats {
+  guint64       n_dispatches;           /* master thread job dispatch cycles, about one per block */
+  guint64       n_jobs;                 /* jobs executed */
+  guint         max_dispatch_jobs;      /* most jobs executed in a single cycle */
+  guint64       n_transactions;         /* transactions executed */
+  guint64       latency_total;          /* nanoseconds from commit to execution, summed over transactions */
+  guint64       latency_max;            /* nanoseconds, longest commit to execution delay */
+};
+void       bse_engine_job_stats               (BseEngineJobStats *stats);
+struct BseEngineTelemetry {     /* memory layout matches Bse::EngineTelemetry, counters wrap around */
+  guint32       n_dispatches;
+  guint32       n_jobs;
+  guint32       max_dispatch_jobs;
+  guint32       n_transactions;
+  guint32       latency_usecs;
+  guint32       max_latency_usecs;
+};
+void       bse_engine_telemetry               (BseEngineTelemetry *telemetry);
 #define    bse_engine_block_size()            (0 + bse_engine_exvar_block_size)
+#define    bse_engine_max_block_size()        (0 + bse_engine_exvar_max_block_size)
 #define    bse_engine_sample_freq()           (0 + bse_engine_exvar_sample_freq)
 #define    bse_engine_control_raster()        (32) // legacy value
 #define    BSE_CONTROL_CHECK(index)           ((bse_engine_control_mask() & (index)) == 0)
@@ -204,5 +223,6 @@ void        bse_engine_dispatch               (void);
 /*< private >*/
 extern const uint bse_engine_exvar_sample_freq;
 extern uint       bse_engine_exvar_block_size;
+extern uint       bse_engine_exvar_max_block_size;
 
 #endif /* __BSE_ENGINE_H__ */
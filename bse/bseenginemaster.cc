@@ -12,29 +12,14 @@
 #include <string.h>
 #include <unistd.h>
 #include <sys/poll.h>
-#include <sys/time.h>
+#include <pthread.h>
+#include <sched.h>
 #include <errno.h>
 
 #define JOB_DEBUG(...)  Bse::debug ("job", __VA_ARGS__)
 #define TJOB_DEBUG(...) Bse::debug ("tjob", __VA_ARGS__)
 
 #define	NODE_FLAG_RECONNECT(node)  G_STMT_START { /*(node)->needs_reset = TRUE*/; } G_STMT_END
-/* --- time stamping (debugging) --- */
-#define	ToyprofStamp		struct timeval
-#define	toyprof_clock_name()	("Glibc gettimeofday(2)")
-#define toyprof_stampinit()	/* nothing */
-#define	toyprof_stamp(st)	gettimeofday (&(st), 0)
-#define	toyprof_stamp_ticks()	(1000000)
-static inline guint64
-toyprof_elapsed (ToyprofStamp fstamp,
-		 ToyprofStamp lstamp)
-{
-  guint64 first = fstamp.tv_sec * toyprof_stamp_ticks () + fstamp.tv_usec;
-  guint64 last  = lstamp.tv_sec * toyprof_stamp_ticks () + lstamp.tv_usec;
-  return last - first;
-}
-
-
 /* --- typedefs & structures --- */
 typedef struct _Poll Poll;
 struct _Poll
@@ -119,6 +104,36 @@ propagate_update_suspend (Bse::Module *node)
     }
 }
 
+static void
+master_schedule_consumer (Bse::Module *node)
+{
+  /* a new consumer only adds its unscheduled inputs to the schedule */
+  if (master_need_reflow || BSE_MODULE_IS_SCHEDULED (node))
+    master_need_reflow |= TRUE;
+  else
+    {
+      if (!master_schedule)
+        master_schedule = _engine_schedule_new ();
+      else
+        _engine_schedule_unsecure (master_schedule);
+      _engine_schedule_consumer_node (master_schedule, node);
+      _engine_schedule_secure (master_schedule);
+    }
+}
+
+static void
+master_schedule_iconnect (Bse::Module *node, guint istream)
+{
+  /* connections to nodes outside the schedule do not affect it */
+  if (master_need_reflow || !BSE_MODULE_IS_SCHEDULED (node))
+    return;
+  _engine_schedule_unsecure (master_schedule);
+  const gboolean scheduled = _engine_schedule_input_node (master_schedule, node, istream);
+  _engine_schedule_secure (master_schedule);
+  if (!scheduled)
+    master_need_reflow |= TRUE;
+}
+
 static void
 master_idisconnect_node (Bse::Module *node, uint istream)
 {
@@ -303,7 +318,8 @@ master_process_job (BseJob *job)
       node->local_active = 0;   /* by default not suspended */
       node->update_suspend = TRUE;
       node->needs_reset = TRUE;
-      master_need_reflow |= TRUE;
+      if (BSE_MODULE_IS_CONSUMER (node))  /* unconnected non-consumers are not scheduled */
+        master_schedule_consumer (node);
       break;
     case ENGINE_JOB_KILL_INPUTS:
       node = job->data.node;
@@ -384,10 +400,15 @@ master_process_job (BseJob *job)
       if (was_consumer != BSE_MODULE_IS_CONSUMER (node))
 	{
 	  if (BSE_MODULE_IS_CONSUMER (node))
-	    add_consumer (node);
+	    {
+	      add_consumer (node);
+	      master_schedule_consumer (node);
+	    }
 	  else
-	    remove_consumer (node);
-	  master_need_reflow |= TRUE;
+	    {
+	      remove_consumer (node);
+	      master_need_reflow |= TRUE;
+	    }
 	}
       break;
     case ENGINE_JOB_SUSPEND:
@@ -431,15 +452,19 @@ master_process_job (BseJob *job)
       /* remove from consumer list */
       was_consumer = BSE_MODULE_IS_CONSUMER (src_node);
       src_node->outputs[ostream].n_outputs += 1;
-      src_node->ostreams[ostream].connected = 0; /* scheduler update */
+      if (BSE_MODULE_IS_SCHEDULED (node))
+        src_node->ostreams[ostream].connected = 0; /* scheduler update */
       src_node->output_nodes = sfi_ring_append (src_node->output_nodes, node);
       NODE_FLAG_RECONNECT (node);
       NODE_FLAG_RECONNECT (src_node);
       /* update suspension state of input */
       propagate_update_suspend (src_node);
       if (was_consumer && !BSE_MODULE_IS_CONSUMER (src_node))
-	remove_consumer (src_node);
-      master_need_reflow |= TRUE;
+	{
+	  remove_consumer (src_node);
+	  master_need_reflow |= TRUE;
+	}
+      master_schedule_iconnect (node, istream);
       break;
     case ENGINE_JOB_JCONNECT:
       node = job->connection.dest_node;
@@ -458,7 +483,8 @@ master_process_job (BseJob *job)
       /* remove from consumer list */
       was_consumer = BSE_MODULE_IS_CONSUMER (src_node);
       src_node->outputs[ostream].n_outputs += 1;
-      src_node->ostreams[ostream].connected = 0; /* scheduler update */
+      if (BSE_MODULE_IS_SCHEDULED (node))
+        src_node->ostreams[ostream].connected = 0; /* scheduler update */
       src_node->output_nodes = sfi_ring_append (src_node->output_nodes, node);
       NODE_FLAG_RECONNECT (node);
       NODE_FLAG_RECONNECT (src_node);
@@ -466,7 +492,9 @@ master_process_job (BseJob *job)
       propagate_update_suspend (src_node);
       if (was_consumer && !BSE_MODULE_IS_CONSUMER (src_node))
 	remove_consumer (src_node);
-      master_need_reflow |= TRUE;
+      /* connections to nodes outside the schedule do not affect it */
+      if ((was_consumer && !BSE_MODULE_IS_CONSUMER (src_node)) || BSE_MODULE_IS_SCHEDULED (node))
+        master_need_reflow |= TRUE;
       break;
     case ENGINE_JOB_IDISCONNECT:
       node = job->connection.dest_node;
@@ -848,50 +876,70 @@ master_process_locked_node (Bse::Module *node,
     }
 }
 
-static bool bse_profile_modules = 0;	/* set to 1 in gdb to get profile output */
+static bool bse_profile_modules = 0;	/* set to 1 in gdb or use BSE_DEBUG=profile to get profile output */
 
+/// Slowest node of the current block, shared between master and slave threads.
 struct ProfileData {
-  uint64 profile_maxtime;
-  Bse::Module *profile_node;
+  std::mutex          mutex;
+  std::atomic<uint64> maxtime { 0 };    // nanoseconds
+  Bse::Module        *node = nullptr;
 };
+static ProfileData profile_data;
 
 static void
-thread_process_nodes (const uint n_values, ProfileData *profile)
+profile_node_duration (Bse::Module *node, uint64 duration)
 {
-  Bse::Module *node = _engine_pop_unprocessed_node ();
-  while (node)
+  if (duration <= profile_data.maxtime.load (std::memory_order_relaxed))
+    return;
+  std::lock_guard<std::mutex> locker (profile_data.mutex);
+  if (duration > profile_data.maxtime)
     {
-      ToyprofStamp profile_stamp1;
+      profile_data.maxtime = duration;
+      profile_data.node = node;
+    }
+}
 
-      if (UNLIKELY (profile))
-        toyprof_stamp (profile_stamp1);
+static void
+thread_process_nodes (const uint n_values, uint qindex)
+{
+  const bool profile = bse_profile_modules;
+  Bse::Module *node = _engine_pop_unprocessed_node (qindex);
+  while (node)
+    {
+      const uint64 stamp = UNLIKELY (profile) ? Bse::timestamp_benchmark() : 0;
 
       master_process_locked_node (node, n_values);
 
+      // record before pushing, so the master sees all durations after _engine_wait_on_unprocessed()
       if (UNLIKELY (profile))
-        {
-          ToyprofStamp profile_stamp2;
-          toyprof_stamp (profile_stamp2);
-          uint64 duration = toyprof_elapsed (profile_stamp1, profile_stamp2);
-          if (duration > profile->profile_maxtime)
-            {
-              profile->profile_maxtime = duration;
-              profile->profile_node = node;
-            }
-        }
+        profile_node_duration (node, Bse::timestamp_benchmark() - stamp);
 
       _engine_push_processed_node (node);
-      node = _engine_pop_unprocessed_node ();
+      node = _engine_pop_unprocessed_node (qindex);
     }
 }
 
 namespace BseInternal {
 static std::atomic<int>          slaves_running { false };
 static std::atomic<int>          slave_counter { 1 };
+static std::atomic<uint64>       slave_generation { 0 };
+static std::atomic<uint>         slaves_parked { 0 };
 static std::mutex                slave_mutex;
 static std::condition_variable   slave_condition;
 static std::vector<std::thread*> slave_threads;
 
+// Bind the calling thread to a single CPU core.
+static void
+engine_pin_thread (uint cpu)
+{
+  cpu_set_t cpuset;
+  CPU_ZERO (&cpuset);
+  CPU_SET (cpu, &cpuset);
+  const int err = pthread_setaffinity_np (pthread_self(), sizeof (cpuset), &cpuset);
+  if (err)
+    Bse::warning ("BSE: failed to pin thread %s to CPU %u: %s", Bse::this_thread_get_name(), cpu, strerror (err));
+}
+
 void
 engine_start_slaves ()
 {
@@ -899,8 +947,9 @@ engine_start_slaves ()
   slaves_running = true;
   const uint n_cpus = Bse::this_thread_online_cpus();
   const uint n_slaves = std::max (1u, n_cpus) - 1;
+  _engine_set_node_queue_threads (1 + n_slaves);
   for (uint i = 0; i < n_slaves; i++)
-    slave_threads.push_back (new std::thread (engine_run_slave));
+    slave_threads.push_back (new std::thread (engine_run_slave, 1 + i));
 }
 
 void
@@ -912,33 +961,48 @@ engine_stop_slaves ()
   slave_mutex.unlock();
   while (!slave_threads.empty())
     {
-      engine_wakeup_slaves();
+      slave_condition.notify_all();
       std::thread *slave = slave_threads.back();
       slave_threads.pop_back();
       slave->join();
       delete slave;
     }
+  _engine_set_node_queue_threads (1);
 }
 
 void
 engine_wakeup_slaves()
 {
-  slave_condition.notify_all();
+  slave_generation += 1;
+  if (slaves_parked)
+    {
+      std::lock_guard<std::mutex> slave_lock (slave_mutex);
+      slave_condition.notify_all();
+    }
 }
 
 void
-engine_run_slave ()
+engine_run_slave (uint qindex)
 {
   std::string myid = Bse::string_format ("DSP-#%u", ++slave_counter);
   Bse::this_thread_set_name (myid);
   Bse::TaskRegistry::add (myid, Bse::this_thread_getpid(), Bse::this_thread_gettid());
+  if (Bse::config_bool ("pin-dsp-threads"))
+    engine_pin_thread (qindex % std::max (1, Bse::this_thread_online_cpus()));
+  uint64 generation = slave_generation;
   while (slaves_running)
     {
-      thread_process_nodes (bse_engine_block_size(), NULL); // FIXME: merge profile data
+      thread_process_nodes (bse_engine_block_size(), qindex);
+      /* spin briefly to catch back-to-back blocks, then park */
+      const uint64 deadline = _engine_node_queue_spin_deadline();
+      while (generation == slave_generation && slaves_running && Bse::timestamp_realtime() < deadline)
+        BSE_CPU_RELAX();
       std::unique_lock<std::mutex> slave_lock (slave_mutex);
-      if (!slaves_running)
-        break;
-      slave_condition.wait (slave_lock);
+      slaves_parked += 1;
+      while (generation == slave_generation && slaves_running)
+        slave_condition.wait (slave_lock);
+      slaves_parked -= 1;
+      generation = slave_generation;
     }
   Bse::TaskRegistry::remove (Bse::this_thread_gettid());
 }
@@ -951,8 +1015,6 @@ master_process_flow (void)
   const guint64 current_stamp = Bse::TickStamp::current();
   guint n_values = bse_engine_block_size();
   guint64 final_counter = current_stamp + n_values;
-  ProfileData profile_data = { 0, NULL };
-  ProfileData *profile = bse_profile_modules ? &profile_data : NULL;
 
   assert_return (master_need_process == TRUE);
 
@@ -960,11 +1022,12 @@ master_process_flow (void)
 
   if (master_schedule)
     {
+      const uint64 block_usecs = n_values * uint64 (1000000) / bse_engine_sample_freq();
       _engine_schedule_restart (master_schedule);
-      _engine_set_schedule (master_schedule);
+      _engine_set_schedule (master_schedule, Bse::timestamp_realtime() + block_usecs);
       BseInternal::engine_wakeup_slaves();
 
-      thread_process_nodes (n_values, profile);
+      thread_process_nodes (n_values, 0);
 
       /* walk unscheduled nodes with flow jobs */
       Bse::Module *node = _engine_mnl_head ();
@@ -995,19 +1058,17 @@ master_process_flow (void)
             master_take_probes (node, current_stamp, n_values, PROBE_SCHEDULED);
         }
 
-      if (UNLIKELY (profile))
+      if (UNLIKELY (profile_data.node))
 	{
-	  if (profile->profile_node)
-	    {
-	      if (profile->profile_maxtime > uint64 (bse_profile_modules))
-		Bse::printout ("Excess Node: %p  Duration: %llu usecs     (%p)         \n",
-                               profile->profile_node, (long long unsigned int) profile->profile_maxtime,
-                               &profile->profile_node->klass);
-	      else
-		Bse::printout ("Slowest Node: %p  Duration: %llu usecs     (%p)         \r",
-                               profile->profile_node, (long long unsigned int) profile->profile_maxtime,
-                               &profile->profile_node->klass);
-	    }
+          const uint64 usecs = profile_data.maxtime / 1000;
+          if (usecs > uint64 (bse_profile_modules))
+            Bse::printout ("Excess Node: %p  Duration: %llu usecs     (%p)         \n",
+                           profile_data.node, (long long unsigned int) usecs, &profile_data.node->klass);
+          else
+            Bse::printout ("Slowest Node: %p  Duration: %llu usecs     (%p)         \r",
+                           profile_data.node, (long long unsigned int) usecs, &profile_data.node->klass);
+          profile_data.node = nullptr;
+          profile_data.maxtime = 0;
 	}
 
       _engine_unset_schedule (master_schedule);
@@ -1214,7 +1275,8 @@ MasterThread::master_thread()
   master_pollfds[0].events = G_IO_IN;
   master_n_pollfds = 1;
   master_pollfds_changed = TRUE;
-  toyprof_stampinit ();
+  if (Bse::debug_key_enabled ("profile"))
+    bse_profile_modules = true;
   while (master_thread_running)
     {
       BseEngineLoop loop;
@@ -44,6 +44,8 @@ namespace Bse {
 
 struct Job final {
   Job() {}
+  static void* operator new    (size_t size);    /* pooled, see bseengineutils.cc */
+  static void  operator delete (void *mem);
   EngineJobType job_id = ENGINE_JOB_NOP;
   Job          *next = NULL;
   union {
@@ -98,6 +100,9 @@ struct Trans {
   Job    *jobs_tail;
   uint	  comitted : 1;
   Trans  *cqt_next;	/* com-thread-queue */
+  uint64  commit_nsecs;	/* timestamp_benchmark() at commit */
+  static void* operator new    (size_t size);    /* pooled, see bseengineutils.cc */
+  static void  operator delete (void *mem);
 };
 union EngineTimedJob {
   struct {
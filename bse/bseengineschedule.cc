@@ -10,6 +10,9 @@
 static void schedule_node	   (EngineSchedule *schedule, Bse::Module *node, uint leaf_level);
 static void schedule_cycle	   (EngineSchedule *schedule, SfiRing *cycle_nodes, uint leaf_level);
 static void subschedule_query_node (EngineSchedule *schedule, Bse::Module *node, EngineQuery *query);
+static void subschedule_child      (EngineSchedule *schedule, Bse::Module *node, EngineQuery *query,
+                                    Bse::Module *child, guint child_ostream);
+static void subschedule_update_suspend (Bse::Module *node);
 
 
 /* --- functions --- */
@@ -370,6 +373,49 @@ _engine_schedule_consumer_node (EngineSchedule *schedule,
   schedule_node (schedule, node, query.leaf_level);
 }
 
+/* schedule a new input connection of an already scheduled node without
+ * rebuilding the schedule, the input's subgraph is added if necessary.
+ * returns FALSE if the connection requires a full reschedule, i.e. if
+ * node's leaf level would have to be raised (this includes new cycles).
+ */
+gboolean
+_engine_schedule_input_node (EngineSchedule *schedule,
+			     Bse::Module     *node,
+			     guint           istream)
+{
+  EngineQuery query = { 0, };
+
+  assert_return (schedule != NULL, FALSE);
+  assert_return (schedule->secured == FALSE, FALSE);
+  assert_return (node != NULL, FALSE);
+  assert_return (istream < BSE_MODULE_N_ISTREAMS (node), FALSE);
+
+  Bse::Module *child = node->inputs[istream].src_node;
+  guint child_ostream = node->inputs[istream].src_stream;
+  if (!BSE_MODULE_IS_SCHEDULED (node) || BSE_MODULE_IS_VIRTUAL (node) || !child || BSE_MODULE_IS_VIRTUAL (child))
+    return FALSE;
+  subschedule_child (schedule, node, &query, child, child_ostream);
+  if (query.cycles || query.leaf_level > node->sched_leaf_level)
+    {
+      SfiRing *walk;
+      for (walk = query.cycles; walk; walk = sfi_ring_walk (walk, query.cycles))
+	{
+	  EngineCycle *cycle = (EngineCycle*) walk->data;
+	  sfi_ring_free (cycle->nodes);
+	  sfi_delete_struct (EngineCycle, cycle);
+	}
+      sfi_ring_free (query.cycles);
+      sfi_ring_free (query.cycle_nodes);
+      return FALSE;
+    }
+  node->istreams[istream].connected = TRUE;
+  node->inputs[istream].real_node = child;
+  node->inputs[istream].real_stream = child_ostream;
+  /* already scheduled inputs are not revisited, refresh their suspension state */
+  subschedule_update_suspend (child);
+  return TRUE;
+}
+
 
 /* --- depth scheduling --- */
 static gboolean
@@ -455,6 +501,23 @@ update_suspension_state (Bse::Module *node)
     }
 }
 
+static void
+subschedule_update_suspend (Bse::Module *node)
+{
+  guint i, j;
+
+  /* walk the inputs flagged by propagate_update_suspend() */
+  if (!node->update_suspend)
+    return;
+  update_suspension_state (node);
+  for (i = 0; i < BSE_MODULE_N_ISTREAMS (node); i++)
+    if (node->inputs[i].src_node)
+      subschedule_update_suspend (node->inputs[i].src_node);
+  for (j = 0; j < BSE_MODULE_N_JSTREAMS (node); j++)
+    for (i = 0; i < node->jstreams[j].jcount; i++)
+      subschedule_update_suspend (node->jinputs[j][i].src_node);
+}
+
 static SfiRing*
 merge_untagged_node_lists_uniq (SfiRing *ring1,
 				SfiRing *ring2)
@@ -618,7 +681,7 @@ subschedule_skip_virtuals (EngineSchedule *schedule, Bse::Module *node, uint *os
   return node;
 }
 
-static inline void
+static void
 subschedule_child (EngineSchedule *schedule,
 		   Bse::Module     *node,
 		   EngineQuery    *query,
@@ -35,6 +35,9 @@ void		_engine_schedule_clear		(EngineSchedule	*schedule);
 void		_engine_schedule_destroy	(EngineSchedule	*schedule);
 void		_engine_schedule_consumer_node	(EngineSchedule	*schedule,
 						 Bse::Module	*node);
+gboolean	_engine_schedule_input_node	(EngineSchedule	*schedule,
+						 Bse::Module	*node,
+						 guint		 istream);
 void		_engine_schedule_secure		(EngineSchedule	*schedule);
 Bse::Module*	_engine_schedule_pop_node	(EngineSchedule	*schedule);
 SfiRing*	_engine_schedule_pop_cycle	(EngineSchedule	*schedule);
@@ -11,6 +11,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <errno.h>
+#include <thread>
 
 #define LOG_INTERN      SfiLogger ("internals", NULL, NULL)
 
@@ -24,13 +25,13 @@ _engine_alloc_ostreams (guint n)
 {
   if (n)
     {
-      uint i = sizeof (BseOStream) * n + sizeof (gfloat) * BSE_ENGINE_MAX_BLOCK_SIZE * n;
+      uint i = sizeof (BseOStream) * n + sizeof (gfloat) * bse_engine_max_block_size() * n;
       BseOStream *streams = (BseOStream*) g_malloc0 (i);
       float *buffers = (float*) (streams + n);
       for (i = 0; i < n; i++)
 	{
 	  streams[i].values = buffers;
-	  buffers += BSE_ENGINE_MAX_BLOCK_SIZE;
+	  buffers += bse_engine_max_block_size();
 	}
       return streams;
     }
@@ -140,14 +141,103 @@ bse_engine_free_transaction (BseTrans *trans)
       bse_engine_free_job (job);
       job = tmp;
     }
-  sfi_delete_struct (BseTrans, trans);
+  delete trans;
+}
+
+/* --- job allocation --- */
+/* Jobs and transactions are created on committing threads and collected on
+ * the user thread, so their memory is recycled through process wide free
+ * lists. Each list owns a fixed static slab of slots and is a lock-free
+ * stack of slot indices; the head carries a generation count in its upper
+ * half which is bumped by every push and pop to rule out ABA. The slabs are
+ * never destructed, so late frees during shutdown remain safe, and requests
+ * beyond the slab capacity fall back to malloc.
+ */
+namespace {
+template<size_t SIZE>
+struct EngineFreeList {
+  static constexpr uint    N_SLOTS = 1024;
+  static constexpr size_t  ALIGN = alignof (std::max_align_t);
+  static constexpr size_t  SLOT_SIZE = (SIZE + ALIGN - 1) / ALIGN * ALIGN;
+  static constexpr guint64 INDEX_MASK = 0xffffffff;
+  alignas (ALIGN) char slab[N_SLOTS * SLOT_SIZE];
+  std::atomic<uint>    slot_next[N_SLOTS];  /* 1-based index of the next free slot, 0 terminates */
+  std::atomic<guint64> free_head;           /* generation << 32 | 1-based slot index */
+  std::atomic<uint>    n_touched;           /* slots handed out at least once */
+  void*
+  alloc ()
+  {
+    guint64 head = free_head.load (std::memory_order_acquire);
+    for (uint index = head & INDEX_MASK; index; index = head & INDEX_MASK)
+      {
+        const guint64 next = slot_next[index - 1].load (std::memory_order_relaxed);
+        if (free_head.compare_exchange_weak (head, ((head >> 32) + 1) << 32 | next, std::memory_order_acquire, std::memory_order_acquire))
+          return slab + (index - 1) * SLOT_SIZE;
+      }
+    if (n_touched.load (std::memory_order_relaxed) < N_SLOTS)
+      {
+        const uint index = n_touched.fetch_add (1, std::memory_order_relaxed);
+        if (index < N_SLOTS)
+          return slab + index * SLOT_SIZE;
+      }
+    return g_malloc (SIZE);
+  }
+  void
+  release (void *mem)
+  {
+    char *const cmem = (char*) mem;
+    if (cmem < slab || cmem >= slab + sizeof (slab))
+      {
+        g_free (mem);
+        return;
+      }
+    const uint index = (cmem - slab) / SLOT_SIZE + 1;
+    guint64 head = free_head.load (std::memory_order_relaxed);
+    do
+      slot_next[index - 1].store (head & INDEX_MASK, std::memory_order_relaxed);
+    while (!free_head.compare_exchange_weak (head, ((head >> 32) + 1) << 32 | index, std::memory_order_release, std::memory_order_relaxed));
+  }
+};
+static EngineFreeList<sizeof (Bse::Job)>   engine_job_pool;
+static EngineFreeList<sizeof (Bse::Trans)> engine_trans_pool;
+} // Anon
+
+void*
+Bse::Job::operator new (size_t size)
+{
+  assert_return (size == sizeof (Job), NULL);
+  return engine_job_pool.alloc();
+}
+
+void
+Bse::Job::operator delete (void *mem)
+{
+  engine_job_pool.release (mem);
+}
+
+void*
+Bse::Trans::operator new (size_t size)
+{
+  assert_return (size == sizeof (Trans), NULL);
+  return engine_trans_pool.alloc();
+}
+
+void
+Bse::Trans::operator delete (void *mem)
+{
+  engine_trans_pool.release (mem);
 }
 
 
 /* --- job transactions --- */
+/* Committing threads push transactions onto a lock-free intake stack. The
+ * master thread takes the whole intake at once when it runs out of jobs,
+ * restores commit order and links the jobs of all fetched transactions.
+ * The mutex only guards the hand-over to the active and trash lists, which
+ * are shared with bse_engine_wait_on_trans() and the garbage collector.
+ */
+static std::atomic<BseTrans*> cqueue_trans_intake { NULL };
 static std::mutex      cqueue_trans_mutex;
-static BseTrans       *cqueue_trans_pending_head = NULL;
-static BseTrans       *cqueue_trans_pending_tail = NULL;
 static std::condition_variable cqueue_trans_cond;
 static BseTrans       *cqueue_trans_trash_head = NULL;
 static BseTrans       *cqueue_trans_trash_tail = NULL;
@@ -156,25 +246,29 @@ static BseTrans       *cqueue_trans_active_tail = NULL;
 static BseJob         *cqueue_trans_job = NULL;
 static Bse::EngineTimedJob *cqueue_tjobs_trash_head = NULL;
 static Bse::EngineTimedJob *cqueue_tjobs_trash_tail = NULL;
-static guint64         cqueue_commit_base_stamp = 1;
+static std::atomic<guint64> cqueue_commit_base_stamp { 1 };
+/* job statistics, written by the master thread only */
+static guint                 cqueue_dispatch_jobs = 0;
+static std::atomic<guint64>  cqueue_stats_n_dispatches { 0 };
+static std::atomic<guint64>  cqueue_stats_n_jobs { 0 };
+static std::atomic<guint>    cqueue_stats_max_dispatch_jobs { 0 };
+static std::atomic<guint64>  cqueue_stats_n_transactions { 0 };
+static std::atomic<guint64>  cqueue_stats_latency_total { 0 };
+static std::atomic<guint64>  cqueue_stats_latency_max { 0 };
+static std::atomic<BseEngineTelemetry*> cqueue_telemetry { NULL };
+
 guint64
 _engine_enqueue_trans (BseTrans *trans)
 {
   assert_return (trans != NULL, 0);
   assert_return (trans->comitted == TRUE, 0);
   assert_return (trans->jobs_head != NULL, 0);
-  cqueue_trans_mutex.lock();
-  if (cqueue_trans_pending_tail)
-    {
-      cqueue_trans_pending_tail->cqt_next = trans;
-      cqueue_trans_pending_tail->jobs_tail->next = trans->jobs_head;
-    }
-  else
-    cqueue_trans_pending_head = trans;
-  cqueue_trans_pending_tail = trans;
-  guint64 base_stamp = cqueue_commit_base_stamp;
-  cqueue_trans_mutex.unlock();
-  cqueue_trans_cond.notify_all();
+  trans->commit_nsecs = Bse::timestamp_benchmark();
+  BseTrans *head = cqueue_trans_intake.load (std::memory_order_relaxed);
+  do
+    trans->cqt_next = head;
+  while (!cqueue_trans_intake.compare_exchange_weak (head, trans, std::memory_order_release, std::memory_order_relaxed));
+  const guint64 base_stamp = cqueue_commit_base_stamp.load (std::memory_order_relaxed);
   return base_stamp + bse_engine_block_size();  /* returns tick_stamp of when this transaction takes effect */
 }
 
@@ -182,22 +276,14 @@ void
 _engine_wait_on_trans (void)
 {
   std::unique_lock<std::mutex> cqueue_trans_guard (cqueue_trans_mutex);
-  while (cqueue_trans_pending_head || cqueue_trans_active_head)
+  while (cqueue_trans_intake.load (std::memory_order_acquire) || cqueue_trans_active_head)
     cqueue_trans_cond.wait (cqueue_trans_guard);
 }
 
 gboolean
 _engine_job_pending (void)
 {
-  gboolean pending = cqueue_trans_job != NULL;
-
-  if (!pending)
-    {
-      cqueue_trans_mutex.lock();
-      pending = cqueue_trans_pending_head != NULL;
-      cqueue_trans_mutex.unlock();
-    }
-  return pending;
+  return cqueue_trans_job != NULL || cqueue_trans_intake.load (std::memory_order_relaxed) != NULL;
 }
 
 void
@@ -217,6 +303,40 @@ _engine_free_trans (BseTrans *trans)
   cqueue_trans_mutex.unlock();
 }
 
+/* move committed transactions into the active list, needs cqueue_trans_mutex */
+static void
+cqueue_fetch_intake_L (void)
+{
+  BseTrans *trans = cqueue_trans_intake.exchange (NULL, std::memory_order_acquire);
+  BseTrans *head = NULL, *tail = trans;
+  const guint64 now = trans ? Bse::timestamp_benchmark() : 0;
+  guint64 latency_total = 0, latency_max = cqueue_stats_latency_max.load (std::memory_order_relaxed);
+  guint n_trans = 0;
+  while (trans)         /* intake is LIFO, restore commit order */
+    {
+      BseTrans *next = trans->cqt_next;
+      trans->cqt_next = head;
+      if (head)
+        trans->jobs_tail->next = head->jobs_head;
+      head = trans;
+      const guint64 latency = now > trans->commit_nsecs ? now - trans->commit_nsecs : 0;
+      latency_total += latency;
+      latency_max = MAX (latency_max, latency);
+      n_trans++;
+      trans = next;
+    }
+  cqueue_trans_active_head = head;
+  cqueue_trans_active_tail = tail;
+  if (n_trans)
+    {
+      cqueue_stats_n_transactions.store (cqueue_stats_n_transactions.load (std::memory_order_relaxed) + n_trans,
+                                         std::memory_order_relaxed);
+      cqueue_stats_latency_total.store (cqueue_stats_latency_total.load (std::memory_order_relaxed) + latency_total,
+                                        std::memory_order_relaxed);
+      cqueue_stats_latency_max.store (latency_max, std::memory_order_relaxed);
+    }
+}
+
 BseJob*
 _engine_pop_job (gboolean update_commit_stamp)
 {
@@ -256,16 +376,19 @@ _engine_pop_job (gboolean update_commit_stamp)
             cqueue_trans_trash_head = cqueue_trans_active_head;
           cqueue_trans_trash_tail = cqueue_trans_active_tail;
 	  /* fetch new transaction */
-	  cqueue_trans_active_head = cqueue_trans_pending_head;
-	  cqueue_trans_active_tail = cqueue_trans_pending_tail;
-	  cqueue_trans_pending_head = NULL;
-	  cqueue_trans_pending_tail = NULL;
+	  cqueue_fetch_intake_L ();
           cqueue_trans_job = cqueue_trans_active_head ? cqueue_trans_active_head->jobs_head : NULL;
           if (!cqueue_trans_job && update_commit_stamp)
-            cqueue_commit_base_stamp = Bse::TickStamp::current();        /* last job has been handed out */
+            cqueue_commit_base_stamp.store (Bse::TickStamp::current(), std::memory_order_relaxed); /* last job has been handed out */
 	  cqueue_trans_mutex.unlock();
 	  cqueue_trans_cond.notify_all();
 	}
+      else if (!trash_tjobs_head && !cqueue_trans_intake.load (std::memory_order_relaxed))
+        {
+          /* idle, no need to lock */
+          if (update_commit_stamp)
+            cqueue_commit_base_stamp.store (Bse::TickStamp::current(), std::memory_order_relaxed);
+        }
       else	/* not currently processing a transaction */
 	{
 	  cqueue_trans_mutex.lock();
@@ -279,13 +402,10 @@ _engine_pop_job (gboolean update_commit_stamp)
               cqueue_tjobs_trash_tail = trash_tjobs_tail;
             }
 	  /* fetch new transaction */
-	  cqueue_trans_active_head = cqueue_trans_pending_head;
-	  cqueue_trans_active_tail = cqueue_trans_pending_tail;
-	  cqueue_trans_pending_head = NULL;
-	  cqueue_trans_pending_tail = NULL;
+	  cqueue_fetch_intake_L ();
           cqueue_trans_job = cqueue_trans_active_head ? cqueue_trans_active_head->jobs_head : NULL;
           if (!cqueue_trans_job && update_commit_stamp)
-            cqueue_commit_base_stamp = Bse::TickStamp::current();        /* last job has been handed out */
+            cqueue_commit_base_stamp.store (Bse::TickStamp::current(), std::memory_order_relaxed); /* last job has been handed out */
 	  cqueue_trans_mutex.unlock();
 	}
     }
@@ -295,13 +415,74 @@ _engine_pop_job (gboolean update_commit_stamp)
     {
       BseJob *job = cqueue_trans_job;
       cqueue_trans_job = job->next;
+      cqueue_dispatch_jobs++;
       return job;
     }
 
   /* no pending jobs... */
+  if (update_commit_stamp)      /* end of this dispatch cycle */
+    {
+      cqueue_stats_n_dispatches.store (cqueue_stats_n_dispatches.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      if (cqueue_dispatch_jobs)
+        {
+          cqueue_stats_n_jobs.store (cqueue_stats_n_jobs.load (std::memory_order_relaxed) + cqueue_dispatch_jobs,
+                                     std::memory_order_relaxed);
+          if (cqueue_dispatch_jobs > cqueue_stats_max_dispatch_jobs.load (std::memory_order_relaxed))
+            cqueue_stats_max_dispatch_jobs.store (cqueue_dispatch_jobs, std::memory_order_relaxed);
+          cqueue_dispatch_jobs = 0;
+        }
+      BseEngineTelemetry *telemetry = cqueue_telemetry.load (std::memory_order_acquire);
+      if (telemetry)
+        {
+          telemetry->n_dispatches = cqueue_stats_n_dispatches.load (std::memory_order_relaxed);
+          telemetry->n_jobs = cqueue_stats_n_jobs.load (std::memory_order_relaxed);
+          telemetry->max_dispatch_jobs = cqueue_stats_max_dispatch_jobs.load (std::memory_order_relaxed);
+          telemetry->n_transactions = cqueue_stats_n_transactions.load (std::memory_order_relaxed);
+          telemetry->latency_usecs = cqueue_stats_latency_total.load (std::memory_order_relaxed) / 1000;
+          telemetry->max_latency_usecs = MIN (cqueue_stats_latency_max.load (std::memory_order_relaxed) / 1000, G_MAXUINT32);
+        }
+    }
   return NULL;
 }
 
+/**
+ * @param stats	location to store job statistics
+ *
+ * Retrieve counters about the jobs executed by the engine master thread,
+ * such as jobs per dispatch cycle and the latency between transaction
+ * commits and their execution.
+ * This function is MT-safe and may be called from any thread.
+ */
+void
+bse_engine_job_stats (BseEngineJobStats *stats)
+{
+  assert_return (stats != NULL);
+  stats->n_dispatches = cqueue_stats_n_dispatches.load (std::memory_order_relaxed);
+  stats->n_jobs = cqueue_stats_n_jobs.load (std::memory_order_relaxed);
+  stats->max_dispatch_jobs = cqueue_stats_max_dispatch_jobs.load (std::memory_order_relaxed);
+  stats->n_transactions = cqueue_stats_n_transactions.load (std::memory_order_relaxed);
+  stats->latency_total = cqueue_stats_latency_total.load (std::memory_order_relaxed);
+  stats->latency_max = cqueue_stats_latency_max.load (std::memory_order_relaxed);
+}
+
+/**
+ * @param telemetry	memory to receive job statistics or NULL
+ *
+ * Install memory, usually located in shared memory, that the master thread
+ * updates with the job statistics after each dispatch cycle, see
+ * bse_engine_job_stats().
+ * The memory must stay valid after it has been replaced, since the master
+ * thread may still be writing to it.
+ * This function is MT-safe and may be called from any thread.
+ */
+void
+bse_engine_telemetry (BseEngineTelemetry *telemetry)
+{
+  if (telemetry)
+    *telemetry = BseEngineTelemetry();
+  cqueue_telemetry.store (telemetry, std::memory_order_release);
+}
+
 
 /* --- user thread garbage collection --- */
 /**
@@ -353,10 +534,33 @@ bse_engine_has_garbage (void)
 
 
 /* --- node processing queue --- */
-static std::mutex        pqueue_mutex;
+/* Nodes of the current schedule are dealt out round-robin in leaf-level order
+ * into one queue per processing thread. Each thread pops from its own queue first
+ * and steals from the queues of other threads once its own is exhausted. Queues
+ * are filled by the master before slaves are woken up and only consumed during
+ * a block, so a single atomic read cursor per queue suffices.
+ */
+struct alignas (64) EngineNodeQueue {
+  std::vector<Bse::Module*> nodes;
+  std::atomic<uint>         head { 0 };
+  Bse::Module*
+  pop ()
+  {
+    if (head.load (std::memory_order_relaxed) >= nodes.size())
+      return NULL;
+    const uint h = head.fetch_add (1, std::memory_order_acq_rel);
+    return h < nodes.size() ? nodes[h] : NULL;
+  }
+};
+static std::mutex        pqueue_mutex;  /* protects pqueue_schedule and trash jobs */
 static EngineSchedule   *pqueue_schedule = NULL;
-static guint             pqueue_n_nodes = 0;
-static guint             pqueue_n_cycles = 0;
+static std::vector<EngineNodeQueue*> pqueue_queues;
+static std::atomic<uint> pqueue_n_threads { 1 };
+static std::atomic<bool> pqueue_active { false };
+static std::atomic<uint> pqueue_n_busy { 0 };
+static std::atomic<uint> pqueue_n_remaining { 0 };
+static std::atomic<bool> pqueue_master_parked { false };
+static std::atomic<uint64> pqueue_spin_deadline { 0 };
 static std::condition_variable pqueue_done_cond;
 static Bse::EngineTimedJob    *pqueue_trash_tjobs_head = NULL;
 static Bse::EngineTimedJob    *pqueue_trash_tjobs_tail = NULL;
@@ -382,8 +586,22 @@ engine_fetch_process_queue_trash_jobs_U (Bse::EngineTimedJob **trash_tjobs_head,
   else
     *trash_tjobs_head = *trash_tjobs_tail = NULL;
 }
+/// Configure the number of threads (master and slaves) that pop nodes from the process queue.
 void
-_engine_set_schedule (EngineSchedule *sched)
+_engine_set_node_queue_threads (uint n_threads)
+{
+  pqueue_n_threads = MAX (1, n_threads);
+}
+#define ENGINE_SPIN_USECS       (20)    /* upper bound for busy waiting before threads park */
+/// Time in µseconds (see Bse::timestamp_realtime()) until which idle processing threads may busy wait.
+/// The spin period is bounded to a few µseconds, so threads park soon after running out of work.
+uint64
+_engine_node_queue_spin_deadline (void)
+{
+  return MIN (pqueue_spin_deadline.load (std::memory_order_relaxed), Bse::timestamp_realtime() + ENGINE_SPIN_USECS);
+}
+void
+_engine_set_schedule (EngineSchedule *sched, uint64 spin_deadline)
 {
   assert_return (sched != NULL);
   assert_return (sched->secured == TRUE);
@@ -397,6 +615,29 @@ _engine_set_schedule (EngineSchedule *sched)
   pqueue_schedule = sched;
   sched->in_pqueue = TRUE;
   pqueue_mutex.unlock();
+  /* threads still stealing from the last block must leave before queues are refilled */
+  while (pqueue_n_busy.load() > 0)
+    BSE_CPU_RELAX();
+  const uint n_queues = pqueue_n_threads;
+  while (pqueue_queues.size() < n_queues)
+    pqueue_queues.push_back (new EngineNodeQueue());
+  while (pqueue_queues.size() > n_queues)
+    {
+      delete pqueue_queues.back();
+      pqueue_queues.pop_back();
+    }
+  for (EngineNodeQueue *queue : pqueue_queues)
+    {
+      queue->nodes.clear();
+      queue->head = 0;
+    }
+  /* deal out nodes in leaf-level order, so each queue preserves the schedule ordering */
+  uint n_nodes = 0;
+  for (Bse::Module *node = _engine_schedule_pop_node (sched); node; node = _engine_schedule_pop_node (sched))
+    pqueue_queues[n_nodes++ % n_queues]->nodes.push_back (node);
+  pqueue_n_remaining = n_nodes;
+  pqueue_spin_deadline.store (spin_deadline, std::memory_order_relaxed);
+  pqueue_active = true;
 }
 void
 _engine_unset_schedule (EngineSchedule *sched)
@@ -410,8 +651,9 @@ _engine_unset_schedule (EngineSchedule *sched)
       Bse::warning ("%s: schedule(%p) not currently set", __func__, sched);
       return;
     }
-  if (UNLIKELY (pqueue_n_nodes || pqueue_n_cycles))
+  if (UNLIKELY (pqueue_n_remaining))
     Bse::warning ("%s: schedule(%p) still busy", __func__, sched);
+  pqueue_active = false;
   sched->in_pqueue = FALSE;
   pqueue_schedule = NULL;
   /* see engine_fetch_process_queue_trash_jobs_U() on the limitations regarding pqueue trash jobs */
@@ -431,18 +673,21 @@ _engine_unset_schedule (EngineSchedule *sched)
       cqueue_trans_mutex.unlock();
     }
 }
+/// Pop the next node from queue `qindex`, or steal one from other queues.
 Bse::Module*
-_engine_pop_unprocessed_node (void)
+_engine_pop_unprocessed_node (uint qindex)
 {
-  Bse::Module *node;
-  pqueue_mutex.lock();
-  node = pqueue_schedule ? _engine_schedule_pop_node (pqueue_schedule) : NULL;
-  if (node)
+  Bse::Module *node = NULL;
+  pqueue_n_busy += 1;
+  if (pqueue_active)
     {
-      pqueue_n_nodes += 1;
-      node->lock();
+      const uint n_queues = pqueue_queues.size();
+      for (uint i = 0; i < n_queues && !node; i++)
+        node = pqueue_queues[(qindex + i) % n_queues]->pop();
     }
-  pqueue_mutex.unlock();
+  pqueue_n_busy -= 1;
+  if (node)
+    node->lock();
   return node;
 }
 static inline void
@@ -472,16 +717,20 @@ void
 _engine_push_processed_node (Bse::Module *node)
 {
   assert_return (node != NULL);
-  assert_return (pqueue_n_nodes > 0);
+  assert_return (pqueue_n_remaining > 0);
   assert_return (BSE_MODULE_IS_SCHEDULED (node));
-  pqueue_mutex.lock();
-  assert_return (pqueue_n_nodes > 0);        /* paranoid */
-  collect_user_jobs_L (node);
-  pqueue_n_nodes -= 1;
+  if (UNLIKELY (node->tjob_head != NULL))
+    {
+      pqueue_mutex.lock();
+      collect_user_jobs_L (node);
+      pqueue_mutex.unlock();
+    }
   node->unlock();
-  if (!pqueue_n_nodes && !pqueue_n_cycles && BSE_ENGINE_SCHEDULE_NONPOPABLE (pqueue_schedule))
-    pqueue_done_cond.notify_one();
-  pqueue_mutex.unlock();
+  if (pqueue_n_remaining.fetch_sub (1) == 1 && pqueue_master_parked)
+    {
+      std::lock_guard<std::mutex> pqueue_guard (pqueue_mutex);
+      pqueue_done_cond.notify_one();
+    }
 }
 
 SfiRing*
@@ -494,7 +743,6 @@ void
 _engine_push_processed_cycle (SfiRing *cycle)
 {
   assert_return (cycle != NULL);
-  assert_return (pqueue_n_cycles > 0);
   Bse::Module *node = (Bse::Module*) cycle->data;
   assert_return (BSE_MODULE_IS_SCHEDULED (node));
 }
@@ -502,9 +750,21 @@ _engine_push_processed_cycle (SfiRing *cycle)
 void
 _engine_wait_on_unprocessed (void)
 {
-  std::unique_lock<std::mutex> pqueue_guard (pqueue_mutex);
-  while (pqueue_n_nodes || pqueue_n_cycles || !BSE_ENGINE_SCHEDULE_NONPOPABLE (pqueue_schedule))
-    pqueue_done_cond.wait (pqueue_guard);
+  /* spin briefly while slaves are about to finish, then park */
+  const uint64 deadline = _engine_node_queue_spin_deadline();
+  while (pqueue_n_remaining.load (std::memory_order_acquire))
+    {
+      if (Bse::timestamp_realtime() >= deadline)
+        {
+          std::unique_lock<std::mutex> pqueue_guard (pqueue_mutex);
+          pqueue_master_parked = true;
+          while (pqueue_n_remaining)
+            pqueue_done_cond.wait (pqueue_guard);
+          pqueue_master_parked = false;
+          break;
+        }
+      BSE_CPU_RELAX();
+    }
 }
 
 
@@ -643,3 +903,43 @@ _engine_recycle_const_values (bool remove_all)
     delete[] it.second;
   engine_const_value_map.clear();
 }
+
+// == Job Pool Tests ==
+namespace { // Anon
+
+BSE_INTEGRITY_TEST (bse_engine_test_job_pool);
+static void
+bse_engine_test_job_pool()
+{
+  static EngineFreeList<64> pool;
+  // memory released on another thread is recycled
+  void *mem[8];
+  std::thread producer ([&mem] () { for (auto &m : mem) m = pool.alloc(); });
+  producer.join();
+  for (auto m : mem)
+    pool.release (m);
+  for (size_t i = 0; i < 8; i++)
+    assert_return (pool.alloc() == mem[7 - i]);
+  for (auto m : mem)
+    pool.release (m);
+  // concurrent users never share a slot
+  std::atomic<uint> n_shared { 0 };
+  std::vector<std::thread> threads;
+  for (uint t = 1; t <= 4; t++)
+    threads.emplace_back ([t, &n_shared] () {
+        for (uint i = 0; i < 20000; i++)
+          {
+            volatile uint *owner = (uint*) pool.alloc();
+            *owner = t;
+            std::this_thread::yield();
+            if (*owner != t)
+              n_shared++;
+            pool.release ((void*) owner);
+          }
+      });
+  for (auto &thread : threads)
+    thread.join();
+  assert_return (n_shared == 0);
+}
+
+} // Anon
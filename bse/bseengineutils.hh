@@ -41,9 +41,12 @@ gboolean	_engine_job_pending	(void);
 
 
 /* --- node processing queue --- */
-void	    _engine_set_schedule		(EngineSchedule	*schedule);
+void	    _engine_set_node_queue_threads	(uint		 n_threads);
+uint64	    _engine_node_queue_spin_deadline	(void);
+void	    _engine_set_schedule		(EngineSchedule	*schedule,
+						 uint64		 spin_deadline);
 void	    _engine_unset_schedule		(EngineSchedule	*schedule);
-Bse::Module* _engine_pop_unprocessed_node	(void);
+Bse::Module* _engine_pop_unprocessed_node	(uint		 qindex);
 void	    _engine_push_processed_node		(Bse::Module	*node);
 SfiRing*    _engine_pop_unprocessed_cycle	(void);
 void	    _engine_push_processed_cycle	(SfiRing	*cycle);
@@ -3,8 +3,11 @@
 #include "bseladspamodule.hh"
 #include "bsecategories.hh"
 #include "bse/internal.hh"
+#include "bse/storage.hh"
+#include "bse/testing.hh"
 #include <bse/sfi.hh>
 #include <string.h>
+#include <unistd.h>
 #include "ladspa.hh"
 
 #define LDEBUG(...)     Bse::debug ("ladspa", __VA_ARGS__)
@@ -186,14 +189,114 @@ ladspa_plugin_reinit_type_ids (BseLadspaPlugin           *self,
   return NULL;
 }
 
+/* type label and name as used for registration, labels of broken types are empty */
+struct LadspaTypeEntry {
+  String label, name;
+};
+typedef std::vector<LadspaTypeEntry> LadspaTypeList;
+
+static void
+ladspa_plugin_scan_types (const gchar               *fname,
+                          LADSPA_Descriptor_Function ldf,
+                          LadspaTypeList            &tlist)
+{
+  for (guint i = 0; ; i++)
+    {
+      const LADSPA_Descriptor *cld = ldf (i);
+      if (!cld)
+	break;
+      BseLadspaInfo *bli = bse_ladspa_info_assemble (fname, cld);
+      LadspaTypeEntry entry;
+      if (!bli->broken)
+        {
+          entry.label = cld->Label;
+          entry.name = bli->name;
+        }
+      tlist.push_back (entry);
+      bse_ladspa_info_free (bli);
+    }
+}
+
+/* load type list from the descriptor cache, valid as long as the plugin is unmodified */
+static bool
+ladspa_types_cache_load (const gchar    *fname,
+                         const String   &key,
+                         LadspaTypeList &tlist)
+{
+  String payload;
+  if (!Bse::beastbse_cachefile_read (Bse::beastbse_cachefile_path ("ladspa", fname), key, payload))
+    return false;
+  const Bse::StringVector lines = Bse::string_split (payload, "\n");
+  /* lines: n_types, label and name per type, empty last line */
+  if (lines.size() < 2 || !lines.back().empty())
+    return false;
+  const size_t n_types = Bse::string_to_uint (lines[0]);
+  if (lines.size() != 2 + 2 * n_types)
+    return false;       /* truncated */
+  for (size_t i = 0; i < n_types; i++)
+    {
+      LadspaTypeEntry entry;
+      entry.label = Bse::string_from_cquote (lines[1 + i * 2]);
+      entry.name = Bse::string_from_cquote (lines[2 + i * 2]);
+      tlist.push_back (entry);
+    }
+  return true;
+}
+
+static void
+ladspa_types_cache_store (const gchar          *fname,
+                          const String         &key,
+                          const LadspaTypeList &tlist)
+{
+  const String path = Bse::beastbse_cachefile_path ("ladspa", fname);
+  if (path.empty())
+    return;
+  String data = key + Bse::string_format ("%u\n", tlist.size());
+  for (const LadspaTypeEntry &entry : tlist)
+    data += Bse::string_to_cquote (entry.label) + "\n" + Bse::string_to_cquote (entry.name) + "\n";
+  Bse::beastbse_cachefile_write (path, data);
+}
+
+BSE_INTEGRITY_TEST (bse_ladspa_test_types_cache);
+static void
+bse_ladspa_test_types_cache()
+{
+  char fname[] = "/tmp/bseladspa-cache-XXXXXX";
+  const int fd = mkstemp (fname);
+  TASSERT (fd >= 0);
+  TASSERT (write (fd, "ladspa", 6) == 6);
+  LadspaTypeList tlist (3), loaded;
+  tlist[0].label = "amp_mono";
+  tlist[0].name = "Mono \"Amplifier\"";
+  tlist[2].label = "delay_5s";     // tlist[1] is a broken descriptor
+  tlist[2].name = "Simple\nDelay";
+  // round trip
+  const String key = Bse::beastbse_cachefile_key ("LADSPA-TYPES-1", fname);
+  ladspa_types_cache_store (fname, key, tlist);
+  TASSERT (ladspa_types_cache_load (fname, key, loaded));
+  TASSERT (loaded.size() == tlist.size());
+  for (size_t i = 0; i < tlist.size(); i++)
+    {
+      TCMP (loaded[i].label, ==, tlist[i].label);
+      TCMP (loaded[i].name, ==, tlist[i].name);
+    }
+  // modifying the plugin file invalidates its cache entry
+  TASSERT (write (fd, "!", 1) == 1);
+  close (fd);
+  loaded.clear();
+  TASSERT (!ladspa_types_cache_load (fname, Bse::beastbse_cachefile_key ("LADSPA-TYPES-1", fname), loaded));
+  unlink (Bse::beastbse_cachefile_path ("ladspa", fname).c_str());
+  unlink (fname);
+}
+
 static const gchar*
-ladspa_plugin_init_type_ids (BseLadspaPlugin           *self,
-			     LADSPA_Descriptor_Function ldf)
+ladspa_plugin_init_type_ids (BseLadspaPlugin      *self,
+			     const LadspaTypeList &tlist)
 {
   gchar *prefix = NULL, *error = NULL;
   guint i;
   /* check for multi module plugins */
-  if (ldf (0) && ldf (1))
+  if (tlist.size() >= 2)
     {
       guint k, was_char = FALSE;
       prefix = strrchr (self->fname, '/');
@@ -210,29 +313,24 @@ ladspa_plugin_init_type_ids (BseLadspaPlugin           *self,
 	else
 	  was_char = FALSE;
     }
-  for (i = 0; ; i++)
+  for (i = 0; i < tlist.size(); i++)
     {
-      const LADSPA_Descriptor *cld = ldf (i);
-      guint j;
-      if (!cld)
-	break;
-      j = self->n_types++;
+      const LadspaTypeEntry &entry = tlist[i];
+      guint j = self->n_types++;
       self->types = (BseLadspaTypeInfo*) g_realloc (self->types, self->n_types * sizeof (self->types[0]));
       self->types[j].type = 0;
-      self->types[j].info = bse_ladspa_info_assemble (self->fname, cld);
-      if (!self->types[j].info->broken)
+      self->types[j].info = NULL;
+      if (!entry.label.empty())
 	{
 	  gchar *string, *name;
 	  guint k;
-	  name = g_strconcat (LADSPA_TYPE_NAME, cld->Label, NULL);
+	  name = g_strconcat (LADSPA_TYPE_NAME, entry.label.c_str(), NULL);
 	  for (k = 0; name[k]; k++)
 	    if (!is_alnum (name[k]))
 	      name[k] = '_';
           LDEBUG ("%s: registering plugin named: %s", self->fname, name);
 	  if (g_type_from_name (name) != 0)
 	    {
-	      bse_ladspa_info_free (self->types[j].info);
-	      self->types[j].info = NULL;
               LDEBUG ("%s: ignoring duplicate plugin type: %s",  self->fname, name);
 	      g_free (name);
 	      continue;
@@ -240,7 +338,7 @@ ladspa_plugin_init_type_ids (BseLadspaPlugin           *self,
 	  self->types[j].type = bse_type_register_dynamic (BSE_TYPE_LADSPA_MODULE, name,
                                                            G_TYPE_PLUGIN (self));
 	  g_free (name);
-	  string = g_strdup (self->types[j].info->name);
+	  string = g_strdup (entry.name.c_str());
 	  for (k = 0; string[k]; k++)
 	    if (string[k] == '_')
 	      string[k] = '-';
@@ -254,11 +352,6 @@ ladspa_plugin_init_type_ids (BseLadspaPlugin           *self,
 	  bse_categories_register (name, NULL, self->types[j].type, NULL);
 	  g_free (name);
 	}
-      else
-	{
-	  bse_ladspa_info_free (self->types[j].info);
-	  self->types[j].info = NULL;
-	}
     }
   g_free (prefix);
   return error;
@@ -461,6 +554,7 @@ bse_ladspa_info_assemble (const gchar  *file_path,
     bli->copyright = cld->Copyright;
   bli->interactive = (cld->Properties & LADSPA_PROPERTY_REALTIME) != 0;
   bli->rt_capable = (cld->Properties & LADSPA_PROPERTY_HARD_RT_CAPABLE) != 0;
+  bli->inplace_broken = LADSPA_IS_INPLACE_BROKEN (cld->Properties) != 0;
 
   if (!cld->PortCount)
     {
@@ -603,26 +697,36 @@ bse_ladspa_plugin_check_load (const gchar *file_name)
   if (ladspa_plugin_find (file_name))
     return "Plugin already registered";
 
-  /* load module once */
-  gmodule = g_module_open (file_name, GModuleFlags (G_MODULE_BIND_LOCAL | G_MODULE_BIND_LAZY));
-  if (!gmodule)
-    return g_module_error ();
-  /* check whether this is a LADSPA module */
-  LADSPA_Descriptor_Function ldf = NULL;
-  if (!g_module_symbol (gmodule, "ladspa_descriptor", (void**) &ldf) || !ldf)
+  /* plugins listed in the descriptor cache are registered without loading them */
+  LadspaTypeList tlist;
+  const String cachekey = Bse::beastbse_cachefile_key ("LADSPA-TYPES-1", file_name);
+  if (!ladspa_types_cache_load (file_name, cachekey, tlist))
     {
+      /* load module once */
+      gmodule = g_module_open (file_name, GModuleFlags (G_MODULE_BIND_LOCAL | G_MODULE_BIND_LAZY));
+      if (!gmodule)
+        return g_module_error ();
+      /* check whether this is a LADSPA module */
+      LADSPA_Descriptor_Function ldf = NULL;
+      if (!g_module_symbol (gmodule, "ladspa_descriptor", (void**) &ldf) || !ldf)
+        {
+          g_module_close (gmodule);
+          return "Plugin without ladspa_descriptor";
+        }
+      ladspa_plugin_scan_types (file_name, ldf, tlist);
       g_module_close (gmodule);
-      return "Plugin without ladspa_descriptor";
+      if (!cachekey.empty())
+        ladspa_types_cache_store (file_name, cachekey, tlist);
     }
+  else
+    LDEBUG ("%s: using cached plugin types", file_name);
 
-  /* create plugin and register types */
+  /* create plugin and register types, the module is loaded upon first use */
   self = (BseLadspaPlugin*) bse_object_new (BSE_TYPE_LADSPA_PLUGIN, NULL);
   self->fname = g_strdup (file_name);
-  self->gmodule = gmodule;
-  error = ladspa_plugin_init_type_ids (self, ldf);
+  error = ladspa_plugin_init_type_ids (self, tlist);
 
   /* keep plugin if types were successfully registered */
-  ladspa_plugin_unload (self);
   if (self->n_types)
     {
       ladspa_plugins = g_slist_prepend (ladspa_plugins, self);
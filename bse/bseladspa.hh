@@ -56,6 +56,7 @@ struct BseLadspaInfo {
   guint	         broken : 1;
   guint	         interactive : 1;	/* low-latency request */
   guint	         rt_capable : 1;	/* hard realtime capability */
+  guint	         inplace_broken : 1;	/* inputs and outputs must not share buffers */
   guint	         n_cports;
   BseLadspaPort *cports;
   guint	         n_aports;
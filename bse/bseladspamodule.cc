@@ -320,7 +320,8 @@ typedef struct
   BseLadspaInfo *bli;
   void          *handle;
   uint	         activated : 1;
-  float	        *ibuffers;
+  uint	         n_obuffer_scratch;	/* scaled inputs that may use output buffers */
+  float	        *ibuffers;		/* scratch for the remaining scaled inputs */
   float          cvalues[1];	/* flexible array */
 } LadspaData;
 #define	LADSPA_DATA_SIZE(bli)	  (sizeof (LadspaData) + (MAX (bli->n_cports, 1) - 1) * sizeof (float))
@@ -384,8 +385,8 @@ ladspa_module_process (BseModule *module,
 {
   LadspaData *ldata = (LadspaData*) module->user_data;
   BseLadspaInfo *bli = ldata->bli;
-  uint i, nis = 0, nos = 0;
-  /* connect audio ports and copy audio buffers */
+  uint i, nis = 0, nos = 0, nscaled = 0;
+  /* connect audio ports, engine buffers are used directly unless inputs need scaling */
   for (i = 0; i < bli->n_aports; i++)
     if (bli->aports[i].output)
       {
@@ -394,26 +395,35 @@ ladspa_module_process (BseModule *module,
       }
     else
       {
-	float *ibuffer = ldata->ibuffers + nis * BSE_ENGINE_MAX_BLOCK_SIZE;
 	const float *srcbuf = BSE_MODULE_IBUFFER (module, nis);
-	uint j;
 	if (bli->aports[i].rate_relative)
-	  for (j = 0; j < n_values; j++)
-	    ibuffer[j] = srcbuf[j] * BSE_SIGNAL_TO_FREQ_FACTOR;
-	else
-	  memcpy (ibuffer, srcbuf, sizeof (ibuffer[0]) * n_values);
+	  {
+	    /* in-place capable plugins get scaled inputs in their output buffers */
+	    float *ibuffer = nscaled < ldata->n_obuffer_scratch ? BSE_MODULE_OBUFFER (module, nscaled) :
+			     ldata->ibuffers + (nscaled - ldata->n_obuffer_scratch) * bse_engine_max_block_size();
+	    uint j;
+	    for (j = 0; j < n_values; j++)
+	      ibuffer[j] = srcbuf[j] * BSE_SIGNAL_TO_FREQ_FACTOR;
+	    bli->connect_port (ldata->handle, bli->aports[i].port_index, ibuffer);
+	    nscaled++;
+	  }
+	else	/* LADSPA plugins must not write to input ports */
+	  bli->connect_port (ldata->handle, bli->aports[i].port_index, const_cast<float*> (srcbuf));
 	nis++;
       }
   /* process ladspa plugin */
   ldata->bli->run (ldata->handle, n_values);
   /* adjust rate_relative output buffers */
   for (i = 0, nos = 0; i < bli->n_aports; i++)
-    if (bli->aports[i].output && bli->aports[i].rate_relative)
+    if (bli->aports[i].output)
       {
-	float *obuf = BSE_MODULE_OBUFFER (module, nos);
-	uint j;
-	for (j = 0; j < n_values; j++)
-	  obuf[j] *= BSE_SIGNAL_FROM_FREQ_FACTOR;
+	if (bli->aports[i].rate_relative)
+	  {
+	    float *obuf = BSE_MODULE_OBUFFER (module, nos);
+	    uint j;
+	    for (j = 0; j < n_values; j++)
+	      obuf[j] *= BSE_SIGNAL_FROM_FREQ_FACTOR;
+	  }
 	nos++;
       }
 }
@@ -432,6 +442,21 @@ ladspa_module_free_data (void                 *data,
   g_free (ldata->ibuffers);
 }
 
+static void
+ladspa_data_alloc_scratch (LadspaData *ldata,
+			   uint        n_ostreams)
+{
+  BseLadspaInfo *bli = ldata->bli;
+  uint i, n_scaled = 0;
+  /* allocate scratch buffers for scaled inputs, audio ports are connected in process() */
+  for (i = 0; i < bli->n_aports; i++)
+    if (bli->aports[i].input && bli->aports[i].rate_relative)
+      n_scaled++;
+  ldata->n_obuffer_scratch = bli->inplace_broken ? 0 : MIN (n_scaled, n_ostreams);
+  if (n_scaled > ldata->n_obuffer_scratch)
+    ldata->ibuffers = g_new (float, (n_scaled - ldata->n_obuffer_scratch) * bse_engine_max_block_size());
+}
+
 static void
 ladspa_derived_context_create (BseSource *source,
 			       uint       context_handle,
@@ -475,12 +500,7 @@ ladspa_derived_context_create (BseSource *source,
     bli->connect_port (ldata->handle, bli->cports[i].port_index, ldata->cvalues + i);
   /* initialize control ports */
   bse_block_copy_float (LADSPA_CVALUES_COUNT (bli), ldata->cvalues, self->cvalues);
-  /* allocate input audio buffers */
-  ldata->ibuffers = g_new (float, klass->gsl_class->n_istreams * BSE_ENGINE_MAX_BLOCK_SIZE);
-  /* connect input audio ports */
-  for (i = 0, nis = 0; i < bli->n_aports; i++)
-    if (bli->aports[i].input)
-      bli->connect_port (ldata->handle, bli->aports[i].port_index, ldata->ibuffers + nis++ * BSE_ENGINE_MAX_BLOCK_SIZE);
+  ladspa_data_alloc_scratch (ldata, klass->gsl_class->n_ostreams);
 
   module = bse_module_new (klass->gsl_class, ldata);
   bse_trans_add (trans, bse_job_integrate (module));
@@ -489,3 +509,120 @@ ladspa_derived_context_create (BseSource *source,
   /* chain parent class' handler */
   BSE_SOURCE_CLASS (derived_parent_class)->context_create (source, context_handle, trans);
 }
+
+/* --- port wiring tests --- */
+#include "bse/testing.hh"
+
+namespace { // Anon
+
+/* stub plugin with a scaled and a plain input, a plain and a scaled output */
+struct LadspaTestPlugin {
+  float *ports[4];
+};
+enum { TEST_PORT_SCALED_IN, TEST_PORT_IN, TEST_PORT_OUT, TEST_PORT_SCALED_OUT };
+
+static void
+ladspa_test_connect_port (void *instance, gulong port_index, float *location)
+{
+  ((LadspaTestPlugin*) instance)->ports[port_index] = location;
+}
+
+static void
+ladspa_test_run (void *instance, gulong n_samples)
+{
+  float **ports = ((LadspaTestPlugin*) instance)->ports;
+  for (uint j = 0; j < n_samples; j++)
+    {
+      /* read all inputs before writing outputs, so buffers may be shared */
+      const float a = ports[TEST_PORT_SCALED_IN][j], b = ports[TEST_PORT_IN][j];
+      ports[TEST_PORT_OUT][j] = a * 0.5 + b;
+      ports[TEST_PORT_SCALED_OUT][j] = a - b * 0.25;
+    }
+}
+
+static void
+ladspa_test_cleanup (void *instance)
+{}
+
+class LadspaTestModule : public Bse::Module {
+public:
+  explicit LadspaTestModule (const BseModuleClass &klass) : Bse::Module (klass) {}
+  void     process          (uint n_values) override {}
+  void     reset            () override {}
+};
+
+BSE_INTEGRITY_TEST (bse_ladspa_module_test_port_wiring);
+static void
+bse_ladspa_module_test_port_wiring()
+{
+  static const BseModuleClass test_module_class = {
+    2,				/* n_istreams */
+    0,				/* n_jstreams */
+    2,				/* n_ostreams */
+    ladspa_module_process,	/* process */
+    NULL,			/* process_defer */
+    ladspa_module_reset,	/* reset */
+    ladspa_module_free_data,	/* free */
+    Bse::ModuleFlag::EXPENSIVE,	/* cost */
+  };
+  BseLadspaPort aports[4] = {};
+  for (uint i = 0; i < 4; i++)
+    {
+      aports[i].port_index = i;
+      aports[i].audio_channel = TRUE;
+      aports[i].input = i == TEST_PORT_SCALED_IN || i == TEST_PORT_IN;
+      aports[i].output = !aports[i].input;
+      aports[i].rate_relative = i == TEST_PORT_SCALED_IN || i == TEST_PORT_SCALED_OUT;
+    }
+  BseLadspaInfo info = {}, *bli = &info;
+  bli->n_aports = 4;
+  bli->aports = aports;
+  bli->connect_port = ladspa_test_connect_port;
+  bli->run = ladspa_test_run;
+  bli->cleanup = ladspa_test_cleanup;
+  const uint n_values = bse_engine_block_size();
+  std::vector<float> in0 (n_values), in1 (n_values);
+  for (uint j = 0; j < n_values; j++)
+    {
+      in0[j] = sin (j * 0.05) * 0.9;
+      in1[j] = cos (j * 0.13) * 0.7;
+    }
+  const std::vector<float> in0_copy = in0, in1_copy = in1;
+  /* expected results, from copying every input like the plugin had private buffers */
+  std::vector<float> ref_in0 (n_values), ref_in1 = in1, ref_out (n_values), ref_scaled_out (n_values);
+  for (uint j = 0; j < n_values; j++)
+    ref_in0[j] = in0[j] * BSE_SIGNAL_TO_FREQ_FACTOR;
+  LadspaTestPlugin refplugin = { { ref_in0.data(), ref_in1.data(), ref_out.data(), ref_scaled_out.data() } };
+  ladspa_test_run (&refplugin, n_values);
+  for (uint j = 0; j < n_values; j++)
+    ref_scaled_out[j] *= BSE_SIGNAL_FROM_FREQ_FACTOR;
+  for (bool inplace_broken : { false, true })
+    {
+      bli->inplace_broken = inplace_broken;
+      LadspaTestPlugin plugin = { { NULL, } };
+      LadspaData *ldata = (LadspaData*) g_malloc0 (LADSPA_DATA_SIZE (bli));
+      ldata->bli = bli;
+      ldata->handle = &plugin;
+      ladspa_data_alloc_scratch (ldata, test_module_class.n_ostreams);
+      LadspaTestModule module (test_module_class);
+      module.user_data = ldata;
+      module.istreams[0].values = in0.data();
+      module.istreams[1].values = in1.data();
+      ladspa_module_process (&module, n_values);
+      /* plain inputs are passed through, scaled inputs use an output buffer unless in-place is broken */
+      TASSERT (plugin.ports[TEST_PORT_IN] == in1.data());
+      TASSERT (plugin.ports[TEST_PORT_OUT] == BSE_MODULE_OBUFFER (&module, 0));
+      TASSERT (plugin.ports[TEST_PORT_SCALED_OUT] == BSE_MODULE_OBUFFER (&module, 1));
+      if (inplace_broken)
+        TASSERT (plugin.ports[TEST_PORT_SCALED_IN] == ldata->ibuffers);
+      else
+        TASSERT (plugin.ports[TEST_PORT_SCALED_IN] == BSE_MODULE_OBUFFER (&module, 0) && ldata->ibuffers == NULL);
+      TASSERT (in0 == in0_copy && in1 == in1_copy);
+      TASSERT (memcmp (BSE_MODULE_OBUFFER (&module, 0), ref_out.data(), n_values * sizeof (float)) == 0);
+      TASSERT (memcmp (BSE_MODULE_OBUFFER (&module, 1), ref_scaled_out.data(), n_values * sizeof (float)) == 0);
+      ladspa_module_free_data (ldata, &test_module_class);
+      g_free (ldata);
+    }
+}
+
+} // Anon
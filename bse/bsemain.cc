@@ -8,6 +8,7 @@
 #include "bsecategories.hh"
 #include "bsemidireceiver.hh"
 #include "bsemathsignal.hh"
+#include "bseblockutils.hh"
 #include "driver.hh"
 #include "gsldatacache.hh"
 #include "bseengine.hh"
@@ -158,7 +159,8 @@ bse_main_loop_thread (Bse::AsyncBlockingQueue<int> *init_queue)
   assert_return (bse_main_context == NULL);
   bse_main_context = g_main_context_new ();
 
-  // basic components
+  // basic components, block operations switch to the widest implementation the CPU supports
+  Bse::Block::select_singleton (Bse::Block::default_singleton());
   bse_globals_init ();
   bse_type_init ();
   bse_cxx_init ();
@@ -241,6 +243,9 @@ bse_main_loop_thread (Bse::AsyncBlockingQueue<int> *init_queue)
   engine_source = nullptr;
   bse_engine_user_thread_collect ();
 
+  // stop data cache I/O threads
+  _gsl_shutdown_data_caches();
+
   // process pending cleanups if needed, but avoid endless loops
   for (size_t i = 0; i < 1000; i++)
     if (g_main_context_pending (bse_main_context))
@@ -335,6 +340,11 @@ JobQueue::call_remote (const std::function<void()> &job)
   bse_main_enqueue (wrapper);
   sem.wait();
 }
+void
+JobQueue::async (const std::function<void()> &job)
+{
+  bse_main_enqueue (job);
+}
 JobQueue jobs;
 } // Bse
 
@@ -403,6 +413,16 @@ config_init (const StringVector &args)
         gconfig["stand-alone"] = string_to_bool (value) ? "1" : "0";
       else if (kv_split (kv, &value) == "jobs")
         gconfig["jobs"] = string_from_int (string_to_int (value));
+      else if (kv_split (kv, &value) == "pin-dsp-threads")
+        gconfig["pin-dsp-threads"] = string_to_bool (value) ? "1" : "0";
+      else if (kv_split (kv, &value) == "block-size")
+        gconfig["block-size"] = string_from_int (string_to_int (value));
+      else if (kv_split (kv, &value) == "dcache-memory")
+        gconfig["dcache-memory"] = string_from_int (string_to_int (value));
+      else if (kv_split (kv, &value) == "dcache-pcm-memory")
+        gconfig["dcache-pcm-memory"] = string_from_int (string_to_int (value));
+      else if (kv_split (kv, &value) == "dcache-pcm-scratch")
+        gconfig["dcache-pcm-scratch"] = string_from_int (string_to_int (value));
     }
   // apply config
   if (string_to_bool (gconfig["fatal-warnings"]))
@@ -414,6 +434,8 @@ config_init (const StringVector &args)
   // sanitize settings
   if (string_to_int (gconfig["jobs"]) <= 0)
     gconfig["jobs"] = string_from_int (get_n_processors());
+  const int64 block_size = string_to_int (gconfig["block-size"]);  // multiple of 16 for SIMD
+  gconfig["block-size"] = string_from_int (block_size > 0 ? CLAMP ((block_size + 15) & ~15, 16, BSE_ENGINE_MAX_BLOCK_SIZE) : 128);
   if (const String r = gconfig["allow-randomization"]; r.empty())
     gconfig["allow-randomization"] = "1";
   // assign
@@ -62,6 +62,8 @@ public:
         return result;
       }
   }
+  /// Execute a lambda job in the Bse main loop without waiting, jobs are run in order.
+  static void async (const std::function<void()> &job);
 };
 /// Execute a lambda job in the Bse main loop and wait for its result.
 extern JobQueue jobs;
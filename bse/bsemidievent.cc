@@ -5,6 +5,8 @@
 #include "bsecxxplugin.hh"
 #include "bse/internal.hh"
 #include <errno.h>
+#include <string.h>
+#include <atomic>
 
 
 /* --- functions --- */
@@ -53,6 +55,58 @@ bse_midi_signal_name (Bse::MidiSignal signal)
 
 
 /* --- BseMidiEvents --- */
+/* Events are allocated by MIDI decoders and the sequencer and are released
+ * by the receivers, often on another thread. So they are recycled through a
+ * process wide lock-free stack of slot indices into a static slab, like the
+ * engine job pools. The head carries a generation count in its upper half
+ * to rule out ABA, the slab is never destructed, and allocations beyond its
+ * capacity fall back to malloc.
+ */
+namespace {
+struct MidiEventFreeList {
+  static constexpr uint    N_SLOTS = 1024;
+  static constexpr guint64 INDEX_MASK = 0xffffffff;
+  BseMidiEvent         slab[N_SLOTS];
+  std::atomic<uint>    slot_next[N_SLOTS];  /* 1-based index of the next free slot, 0 terminates */
+  std::atomic<guint64> free_head;           /* generation << 32 | 1-based slot index */
+  std::atomic<uint>    n_touched;           /* slots handed out at least once */
+  BseMidiEvent*
+  alloc ()
+  {
+    guint64 head = free_head.load (std::memory_order_acquire);
+    for (uint index = head & INDEX_MASK; index; index = head & INDEX_MASK)
+      {
+        const guint64 next = slot_next[index - 1].load (std::memory_order_relaxed);
+        if (free_head.compare_exchange_weak (head, ((head >> 32) + 1) << 32 | next, std::memory_order_acquire, std::memory_order_acquire))
+          return &slab[index - 1];
+      }
+    if (n_touched.load (std::memory_order_relaxed) < N_SLOTS)
+      {
+        const uint index = n_touched.fetch_add (1, std::memory_order_relaxed);
+        if (index < N_SLOTS)
+          return &slab[index];
+      }
+    return sfi_new_struct (BseMidiEvent, 1);
+  }
+  void
+  release (BseMidiEvent *event)
+  {
+    if (event < slab || event >= slab + N_SLOTS)
+      {
+        sfi_delete_struct (BseMidiEvent, event);
+        return;
+      }
+    const uint index = event - slab + 1;
+    guint64 head = free_head.load (std::memory_order_relaxed);
+    do
+      slot_next[index - 1].store (head & INDEX_MASK, std::memory_order_relaxed);
+    while (!free_head.compare_exchange_weak (head, ((head >> 32) + 1) << 32 | index, std::memory_order_release, std::memory_order_relaxed));
+  }
+};
+static_assert (std::is_trivially_destructible<MidiEventFreeList>::value, "late frees need the slab");
+static MidiEventFreeList midi_event_pool;
+} // Anon
+
 /**
  * @param event BseMidiEvent structure
  *
@@ -92,7 +146,7 @@ bse_midi_free_event (BseMidiEvent *event)
       break;
     default: ;
     }
-  sfi_delete_struct (BseMidiEvent, event);
+  midi_event_pool.release (event);
 }
 
 BseMidiEvent*
@@ -109,10 +163,18 @@ bse_midi_copy_event (const BseMidiEvent *src)
   return event;
 }
 
+/**
+ * Allocate a zero initialized BseMidiEvent, release with bse_midi_free_event().
+ * Events are recycled through a process wide pool, so steady state allocations
+ * don't hit malloc.
+ * This function is MT-safe and may be called from any thread.
+ */
 BseMidiEvent*
 bse_midi_alloc_event (void)
 {
-  return sfi_new_struct0 (BseMidiEvent, 1);
+  BseMidiEvent *event = midi_event_pool.alloc();
+  memset (event, 0, sizeof (*event));
+  return event;
 }
 
 BseMidiEvent*
@@ -190,7 +252,7 @@ bse_midi_event_signal (uint              midi_channel,
     case Bse::MidiSignal::CONSTANT_NEGATIVE_CENTER:
     case Bse::MidiSignal::CONSTANT_NEGATIVE_HIGH:
       /* these are special signals that don't map to MIDI events */
-      sfi_delete_struct (BseMidiEvent, event);
+      midi_event_pool.release (event);
       return NULL;
     default:
       if (signal_int >= 128)   /* literal controls */
@@ -115,6 +115,8 @@ typedef struct
     /* implementation specific */
     guint   zprefix;
   } data;
+  /*< private >*/
+  gpointer         next_pending;        /* link for lock-free receiver queues */
 } BseMidiEvent;
 
 
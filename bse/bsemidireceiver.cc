@@ -6,10 +6,12 @@
 #include "bsemathsignal.hh"
 #include "bsecxxutils.hh"
 #include "bse/internal.hh"
+#include "bse/testing.hh"
 #include <string.h>
 #include <bse/gbsearcharray.hh>
 #include <map>
 #include <set>
+#include <thread>
 
 namespace {
 using namespace Bse;
@@ -347,6 +349,96 @@ midi_channel_compare (const guint        midi_channel,
 }
 
 
+/* --- midi event queue --- */
+/* Producers push events onto a lock-free intake stack, the consumer moves
+ * them into a binary min-heap ordered by tick stamp and arrival, so pushing
+ * never contends with event processing and sorting is O(log n) per event.
+ */
+class MidiEventQueue {
+  struct Entry {
+    guint64       stamp;
+    guint64       sequence;     // keeps events with equal stamps in push order
+    BseMidiEvent *event;
+    bool operator> (const Entry &o) const { return stamp > o.stamp || (stamp == o.stamp && sequence > o.sequence); }
+  };
+  std::atomic<BseMidiEvent*> intake_;
+  std::atomic<uint>          n_pending_;
+  std::vector<Entry>         heap_;
+  guint64                    sequence_ = 0;
+public:
+  MidiEventQueue() :
+    intake_ (NULL), n_pending_ (0)
+  {
+    heap_.reserve (256);
+  }
+  ~MidiEventQueue()
+  {
+    collect();
+    for (auto &e : heap_)
+      bse_midi_free_event (e.event);
+  }
+  /// Add @a event to the queue, lock-free and MT-safe.
+  void
+  push (BseMidiEvent *event)
+  {
+    n_pending_++;
+    BseMidiEvent *head = intake_.load (std::memory_order_relaxed);
+    do
+      event->next_pending = head;
+    while (!intake_.compare_exchange_weak (head, event, std::memory_order_release, std::memory_order_relaxed));
+  }
+  /// Move pushed events into the heap, only one consumer may call this at a time.
+  void
+  collect ()
+  {
+    BseMidiEvent *list = intake_.exchange (NULL, std::memory_order_acquire);
+    BseMidiEvent *fifo = NULL;
+    while (list)        // intake is LIFO, restore push order
+      {
+        BseMidiEvent *next = (BseMidiEvent*) list->next_pending;
+        list->next_pending = fifo;
+        fifo = list;
+        list = next;
+      }
+    for (; fifo; fifo = (BseMidiEvent*) fifo->next_pending)
+      {
+        heap_.push_back (Entry { fifo->delta_time, sequence_++, fifo });
+        std::push_heap (heap_.begin(), heap_.end(), std::greater<Entry>());
+      }
+  }
+  /// Check for unprocessed events, MT-safe.
+  bool
+  pending () const
+  {
+    return n_pending_ > 0;
+  }
+  /// Earliest collected event or NULL.
+  BseMidiEvent*
+  top () const
+  {
+    return heap_.empty() ? NULL : heap_.front().event;
+  }
+  BseMidiEvent*
+  pop ()
+  {
+    std::pop_heap (heap_.begin(), heap_.end(), std::greater<Entry>());
+    BseMidiEvent *event = heap_.back().event;
+    heap_.pop_back();
+    n_pending_--;
+    return event;
+  }
+  /// Check if a collected event is pending on @a midi_channel.
+  bool
+  has_channel (guint midi_channel) const
+  {
+    for (const auto &e : heap_)
+      if (e.event->channel == midi_channel)
+        return true;
+    return false;
+  }
+};
+
+
 /* --- midi receiver --- */
 struct MidiReceiver
 {
@@ -356,7 +448,7 @@ struct MidiReceiver
   uint	           n_cmodules;
   BseModule      **cmodules;            // control signals
   Channels         midi_channels;
-  SfiRing         *events;              // contains BseMidiEvent*
+  MidiEventQueue   events;
   uint		   ref_count;
   BseMidiNotifier *notifier;
   SfiRing	  *notifier_events;
@@ -365,7 +457,6 @@ public:
   {
     n_cmodules = 0;
     cmodules = NULL;
-    events = NULL;
     ref_count = 1;
     notifier = NULL;
     notifier_events = NULL;
@@ -375,11 +466,6 @@ public:
     assert_return (ref_count == 0);
     for (Channels::iterator it = midi_channels.begin(); it != midi_channels.end(); it++)
       delete *it;
-    while (events)
-      {
-        BseMidiEvent *event = (BseMidiEvent*) sfi_ring_pop_head (&events);
-        bse_midi_free_event (event);
-      }
     while (notifier_events)
       {
         BseMidiEvent *event = (BseMidiEvent*) sfi_ring_pop_head (&notifier_events);
@@ -1294,17 +1380,6 @@ static gint	midi_receiver_process_event_L  (BseMidiReceiver        *self,
 static vector<BseMidiReceiver*> farm_residents;
 
 /* --- function --- */
-static gint
-events_cmp (gconstpointer a,
-            gconstpointer b,
-            gpointer      data)
-{
-  const BseMidiEvent *e1 = (const BseMidiEvent *) a;
-  const BseMidiEvent *e2 = (const BseMidiEvent *) b;
-
-  return e1->delta_time < e2->delta_time ? -1 : e1->delta_time != e2->delta_time;
-}
-
 void
 bse_midi_receiver_enter_farm (BseMidiReceiver *self)
 {
@@ -1323,7 +1398,7 @@ bse_midi_receiver_farm_distribute_event (BseMidiEvent *event)
 
   BSE_MIDI_RECEIVER_LOCK ();
   for (vector<BseMidiReceiver*>::iterator it = farm_residents.begin(); it != farm_residents.end(); it++)
-    (*it)->events = sfi_ring_insert_sorted ((*it)->events, bse_midi_copy_event (event), events_cmp, NULL);
+    (*it)->events.push (bse_midi_copy_event (event));
   BSE_MIDI_RECEIVER_UNLOCK ();
 }
 
@@ -1331,15 +1406,17 @@ void
 bse_midi_receiver_farm_process_events (guint64 max_tick_stamp)
 {
   gboolean seen_event;
+  BSE_MIDI_RECEIVER_LOCK ();
+  for (vector<BseMidiReceiver*>::iterator it = farm_residents.begin(); it != farm_residents.end(); it++)
+    (*it)->events.collect();
   do
     {
       seen_event = FALSE;
-      BSE_MIDI_RECEIVER_LOCK ();
       for (vector<BseMidiReceiver*>::iterator it = farm_residents.begin(); it != farm_residents.end(); it++)
         seen_event |= midi_receiver_process_event_L (*it, max_tick_stamp);
-      BSE_MIDI_RECEIVER_UNLOCK ();
     }
   while (seen_event);
+  BSE_MIDI_RECEIVER_UNLOCK ();
 }
 
 void
@@ -1360,9 +1437,7 @@ bse_midi_receiver_push_event (BseMidiReceiver *self,
   assert_return (self != NULL);
   assert_return (event != NULL);
 
-  BSE_MIDI_RECEIVER_LOCK ();
-  self->events = sfi_ring_insert_sorted (self->events, event, events_cmp, NULL);
-  BSE_MIDI_RECEIVER_UNLOCK ();
+  self->events.push (event);    // lock-free
 }
 
 void
@@ -1373,13 +1448,12 @@ bse_midi_receiver_process_events (BseMidiReceiver *self,
 
   assert_return (self != NULL);
 
+  BSE_MIDI_RECEIVER_LOCK ();
+  self->events.collect();
   do
-    {
-      BSE_MIDI_RECEIVER_LOCK ();
-      seen_event = midi_receiver_process_event_L (self, max_tick_stamp);
-      BSE_MIDI_RECEIVER_UNLOCK ();
-    }
+    seen_event = midi_receiver_process_event_L (self, max_tick_stamp);
   while (seen_event);
+  BSE_MIDI_RECEIVER_UNLOCK ();
 }
 
 
@@ -1913,13 +1987,12 @@ bse_midi_receiver_voices_pending (BseMidiReceiver *self,
                                   guint            midi_channel)
 {
   MidiChannel *mchannel;
-  SfiRing *ring = NULL;
   guint i, active = 0;
 
   assert_return (self != NULL, FALSE);
   assert_return (midi_channel > 0, FALSE);
 
-  if (self->events)
+  if (self->events.pending())
     return TRUE;
 
   BSE_MIDI_RECEIVER_LOCK ();
@@ -1933,11 +2006,8 @@ bse_midi_receiver_voices_pending (BseMidiReceiver *self,
         active = active || (mchannel->voices[i] && !check_voice_switch_available_L (mchannel->voices[i]));
     }
   /* find pending events */
-  for (ring = self->events; ring && !active; ring = sfi_ring_next (ring, self->events))
-    {
-      BseMidiEvent *event = (BseMidiEvent *) ring->data;
-      active += event->channel == midi_channel;
-    }
+  if (!active)
+    active = self->events.has_channel (midi_channel);
   BSE_MIDI_RECEIVER_UNLOCK ();
 
   return active > 0;
@@ -2095,15 +2165,15 @@ midi_receiver_process_event_L (BseMidiReceiver *self,
   BseMidiEvent *event;
   gboolean need_wakeup = FALSE;
 
-  if (!self->events)
+  event = self->events.top();
+  if (!event)
     return FALSE;
 
-  event = (BseMidiEvent *) self->events->data;
   if (event->delta_time <= max_tick_stamp)
     {
       BseTrans *trans = bse_trans_open ();
       MidiChannel *mchannel = self->peek_channel (event->channel);
-      self->events = sfi_ring_remove_node (self->events, self->events);
+      self->events.pop();
       uint event_status = event->status;
       if (mchannel && mchannel->call_event_handlers (event, trans))
         event_status = 0; // already handled
@@ -2195,3 +2265,83 @@ midi_receiver_process_event_L (BseMidiReceiver *self,
 
   return TRUE;
 }
+
+// == MidiEventQueue Tests ==
+namespace { // Anon
+
+static BseMidiEvent*
+test_event (guint channel, guint64 stamp, float index)
+{
+  BseMidiEvent *event = bse_midi_alloc_event();
+  event->status = BSE_MIDI_NOTE_ON;
+  event->channel = channel;
+  event->delta_time = stamp;
+  event->data.note.frequency = index;
+  return event;
+}
+
+BSE_INTEGRITY_TEST (bse_midi_test_event_queue);
+static void
+bse_midi_test_event_queue()
+{
+  MidiEventQueue queue;
+  // events are popped in stamp order
+  const guint64 stamps[] = { 50, 10, 40, 20, 30 };
+  for (auto stamp : stamps)
+    queue.push (test_event (1, stamp, 0));
+  TASSERT (queue.pending() && !queue.top());
+  queue.collect();
+  for (guint64 stamp = 10; stamp <= 50; stamp += 10)
+    {
+      BseMidiEvent *event = queue.pop();
+      TCMP (event->delta_time, ==, stamp);
+      bse_midi_free_event (event);
+    }
+  TASSERT (!queue.pending() && !queue.top());
+  // events with equal stamps keep their push order, also across collect() calls
+  for (uint i = 0; i < 8; i++)
+    {
+      queue.push (test_event (1, 7, i));
+      if (i == 4)
+        queue.collect();
+    }
+  queue.push (test_event (1, 3, 99));
+  queue.collect();
+  BseMidiEvent *event = queue.pop();
+  TCMP (event->data.note.frequency, ==, 99);
+  bse_midi_free_event (event);
+  for (uint i = 0; i < 8; i++)
+    {
+      event = queue.pop();
+      TCMP (event->data.note.frequency, ==, i);
+      bse_midi_free_event (event);
+    }
+  // concurrent producers lose no events, and each producer's order is kept
+  constexpr uint N_THREADS = 4, N_EVENTS = 5000;
+  std::vector<std::thread> producers;
+  for (uint t = 1; t <= N_THREADS; t++)
+    producers.emplace_back ([&queue, t] () {
+        for (uint i = 0; i < N_EVENTS; i++)
+          queue.push (test_event (t, i / 10, i));
+      });
+  for (auto &thread : producers)
+    thread.join();
+  queue.collect();
+  float last_index[N_THREADS + 1] = { -1, -1, -1, -1, -1 };
+  guint64 last_stamp = 0;
+  uint n_events = 0;
+  while (queue.top())
+    {
+      event = queue.pop();
+      TCMP (event->delta_time, >=, last_stamp);
+      TCMP (event->data.note.frequency, >, last_index[event->channel]);
+      last_stamp = event->delta_time;
+      last_index[event->channel] = event->data.note.frequency;
+      bse_midi_free_event (event);
+      n_events++;
+    }
+  TCMP (n_events, ==, N_THREADS * N_EVENTS);
+  TASSERT (!queue.pending());
+}
+
+} // Anon
@@ -20,9 +20,8 @@ static_assert (Bse::AudioSignal::MAX_RENDER_BLOCK_SIZE == BSE_ENGINE_MAX_BLOCK_S
 
 // == BsePCMModuleData ==
 struct BsePCMModuleData {
-  const uint      max_values = 0; // BSE_ENGINE_MAX_BLOCK_SIZE * 2 (stereo)
+  const uint      max_values = 0; // bse_engine_max_block_size() * 2 (stereo)
   float          *const buffer = nullptr;
-  float          *const bound = nullptr;
   Bse::PcmDriver *pcm_driver = nullptr;
   BsePcmWriter   *pcm_writer = nullptr;
   bool            pcm_input_checked = false;
@@ -33,7 +32,7 @@ struct BsePCMModuleData {
 };
 
 BsePCMModuleData::BsePCMModuleData (uint nv) :
-  max_values (nv), buffer (new float[max_values] ()), bound (buffer + max_values)
+  max_values (nv), buffer (new float[max_values] ())
 {}
 
 BsePCMModuleData::~BsePCMModuleData()
@@ -106,7 +105,7 @@ bse_pcm_omodule_process (BseModule *module,
 {
   BsePCMModuleData *mdata = (BsePCMModuleData*) module->user_data;
   gfloat *d = mdata->buffer;
-  gfloat *b = mdata->bound;
+  const gfloat *const b = mdata->buffer + n_values * BSE_PCM_MODULE_N_JSTREAMS;
   const gfloat *src;
   guint i;
 
@@ -114,8 +113,7 @@ bse_pcm_omodule_process (BseModule *module,
 
   Bse::AudioSignal::Engine *engine = mdata->engine;
   engine->make_schedule();
-  engine->render_block();
-  assert_return (n_values == Bse::AudioSignal::MAX_RENDER_BLOCK_SIZE);
+  engine->render_block (n_values);
 
   if (BSE_MODULE_JSTREAM (module, BSE_PCM_MODULE_JSTREAM_LEFT).n_connections)
     src = BSE_MODULE_JBUFFER (module, BSE_PCM_MODULE_JSTREAM_LEFT, 0);
@@ -202,7 +200,7 @@ bse_pcm_omodule_insert (BseTrans *trans)
 
   assert_return (trans != NULL, NULL);
 
-  BsePCMModuleData *mdata = new BsePCMModuleData (BSE_ENGINE_MAX_BLOCK_SIZE * BSE_PCM_MODULE_N_JSTREAMS);
+  BsePCMModuleData *mdata = new BsePCMModuleData (bse_engine_max_block_size() * BSE_PCM_MODULE_N_JSTREAMS);
   BseModule *module = bse_module_new (&pcm_omodule_class, mdata);
 
   bse_trans_add (trans,
@@ -265,11 +263,10 @@ bse_pcm_imodule_process (BseModule *module,     /* EngineThread */
       assert_return (l == n_values * BSE_PCM_MODULE_N_OSTREAMS);
     }
   else
-    memset (mdata->buffer, 0, mdata->max_values * sizeof (float));
+    memset (mdata->buffer, 0, n_values * BSE_PCM_MODULE_N_OSTREAMS * sizeof (float));
 
-  /* due to suspend/resume, we may be called with partial read requests */
-  const gfloat *s = mdata->buffer + mdata->max_values - (n_values * BSE_PCM_MODULE_N_OSTREAMS);
-  const gfloat *b = mdata->bound;
+  const gfloat *s = mdata->buffer;
+  const gfloat *const b = mdata->buffer + n_values * BSE_PCM_MODULE_N_OSTREAMS;
   do
     {
       *left++ = *s++;
@@ -306,7 +303,7 @@ bse_pcm_imodule_insert (BseTrans *trans)
 
   assert_return (trans != NULL, NULL);
 
-  BsePCMModuleData *mdata = new BsePCMModuleData (BSE_ENGINE_MAX_BLOCK_SIZE * BSE_PCM_MODULE_N_OSTREAMS);
+  BsePCMModuleData *mdata = new BsePCMModuleData (bse_engine_max_block_size() * BSE_PCM_MODULE_N_OSTREAMS);
   BseModule *module = bse_module_new (&pcm_imodule_class, mdata);
 
   bse_trans_add (trans,
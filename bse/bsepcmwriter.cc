@@ -8,6 +8,9 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <condition_variable>
+
+#define PDEBUG(...)     Bse::debug ("pcmwriter", __VA_ARGS__)
 
 // == prototypes ==
 static void	   bse_pcm_writer_init			(BsePcmWriter      *pdev);
@@ -18,6 +21,131 @@ static void	   bse_pcm_writer_finalize		(GObject           *object);
 static std::atomic<uint64> atomic_trigger_tick {-uint64 (1)};
 static gpointer parent_class = NULL;
 
+// == PcmWriterThread ==
+namespace Bse {
+
+/// Disk writer thread, fed by the engine through a lock-free single producer, single consumer ring buffer.
+class PcmWriterThread {
+  const int                     fd_;
+  std::vector<int16>            ring_;
+  const size_t                  mask_;
+  alignas (64) std::atomic<size_t> head_ { 0 };       // advanced by the engine thread
+  alignas (64) std::atomic<size_t> tail_ { 0 };       // advanced by the writer thread
+  std::atomic<uint64>           dropped_ { 0 };
+  std::atomic<size_t>           peak_fill_ { 0 };
+  std::atomic<uint64>           n_bytes_ { 0 };
+  std::atomic<bool>             failed_ { false };
+  std::atomic<bool>             running_ { true };
+  size_t                        partial_bytes_ = 0;     // bytes of ring_[tail_] already written, writer thread only
+  std::mutex                    mutex_;
+  std::condition_variable       cond_;
+  std::thread                   thread_;
+  void
+  write_pending ()
+  {
+    size_t tail = tail_.load (std::memory_order_relaxed);
+    const size_t head = head_.load (std::memory_order_acquire);
+    while (tail != head && !failed_)
+      {
+        const size_t offset = tail & mask_;
+        const size_t n_values = std::min (head - tail, ring_.size() - offset);
+        // a short write may end within a sample, its remaining bytes go out with the next write
+        const char *bytes = reinterpret_cast<const char*> (&ring_[offset]) + partial_bytes_;
+        const size_t n_bytes = n_values * sizeof (ring_[0]) - partial_bytes_;
+        ssize_t l;
+        do
+          l = write (fd_, bytes, n_bytes);
+        while (l < 0 && errno == EINTR);
+        if (l <= 0)
+          {
+            Bse::info ("failed to write %u bytes to WAV file: %s", n_bytes, g_strerror (errno));
+            failed_ = true;
+            break;
+          }
+        n_bytes_ += l;
+        const size_t done = partial_bytes_ + l;
+        partial_bytes_ = done % sizeof (ring_[0]);
+        tail += done / sizeof (ring_[0]);       // keeps a partially written sample queued
+        tail_.store (tail, std::memory_order_release);
+      }
+  }
+  void
+  run ()
+  {
+    const char *const myid = "BsePcmWriter";
+    this_thread_set_name (myid);
+    TaskRegistry::add (myid, this_thread_getpid(), this_thread_gettid());
+    uint64 last_dropped = 0;
+    std::unique_lock<std::mutex> lock (mutex_);
+    while (running_)
+      {
+        cond_.wait_for (lock, std::chrono::milliseconds (50));
+        lock.unlock();
+        write_pending();
+        const uint64 dropped = dropped_;
+        if (dropped != last_dropped)
+          PDEBUG ("ring buffer overflow: peak fill %u%%, dropped %u samples", peak_fill_ * 100 / ring_.size(), dropped);
+        last_dropped = dropped;
+        lock.lock();
+      }
+    lock.unlock();
+    write_pending();
+    TaskRegistry::remove (this_thread_gettid());
+  }
+public:
+  explicit
+  PcmWriterThread (int fd, uint n_channels, uint sample_freq) :
+    fd_ (fd), ring_ (size_t (1) << g_bit_storage (2 * n_channels * sample_freq - 1)), mask_ (ring_.size() - 1)
+  {
+    thread_ = std::thread (&PcmWriterThread::run, this);
+  }
+  ~PcmWriterThread ()
+  {
+    assert_return (!thread_.joinable());
+  }
+  /// Stop the writer thread after all queued samples have been written.
+  void
+  stop ()
+  {
+    return_unless (thread_.joinable());
+    {
+      std::lock_guard<std::mutex> locker (mutex_);
+      running_ = false;
+    }
+    cond_.notify_one();
+    thread_.join();
+    PDEBUG ("closing: wrote %u bytes, peak fill %u%%, dropped %u samples", n_bytes_, peak_fill_ * 100 / ring_.size(), dropped_);
+    if (dropped_)
+      Bse::info ("PCM recording dropped %u samples, the disk could not keep up", dropped_);
+  }
+  /// Queue @a n_values for writing, called from the engine thread, never blocks or allocates.
+  void
+  push (const float *values, size_t n_values)
+  {
+    return_unless (!failed_);
+    const size_t head = head_.load (std::memory_order_relaxed);
+    const size_t fill = head - tail_.load (std::memory_order_acquire);
+    const size_t n_queue = std::min (n_values, ring_.size() - fill);
+    const size_t offset = head & mask_;
+    const size_t n_first = std::min (n_queue, ring_.size() - offset);
+    gsl_conv_from_float_clip (GSL_WAVE_FORMAT_SIGNED_16, G_BYTE_ORDER, values, &ring_[offset], n_first);
+    gsl_conv_from_float_clip (GSL_WAVE_FORMAT_SIGNED_16, G_BYTE_ORDER, values + n_first, &ring_[0], n_queue - n_first);
+    head_.store (head + n_queue, std::memory_order_release);
+    if (n_queue < n_values)
+      dropped_ += n_values - n_queue;
+    if (fill + n_queue > peak_fill_.load (std::memory_order_relaxed))
+      peak_fill_.store (fill + n_queue, std::memory_order_relaxed);
+    // kick the writer early once a quarter of the ring buffer is filled
+    const size_t quarter = ring_.size() / 4;
+    if (fill < quarter && fill + n_queue >= quarter)
+      cond_.notify_one();
+  }
+  bool   failed  () const { return failed_; }
+  uint64 n_bytes () const { return n_bytes_; }
+};
+
+} // Bse
+
 // == functions ==
 BSE_BUILTIN_TYPE (BsePcmWriter)
 {
@@ -50,6 +178,7 @@ static void
 bse_pcm_writer_init (BsePcmWriter *self)
 {
   new (&self->mutex) std::mutex();
+  self->writer_thread = nullptr;
 }
 
 static void
@@ -81,6 +210,7 @@ bse_pcm_writer_open (BsePcmWriter *self,
   assert_return (sample_freq >= 1000, Bse::Error::INTERNAL);
   self->mutex.lock();
   self->n_bytes = 0;
+  self->n_queued = 0;
   self->recorded_maximum = recorded_maximum;
   self->start_tick = atomic_trigger_tick;
   fd = open (file, O_WRONLY | O_CREAT | O_TRUNC, 0666);
@@ -98,6 +228,7 @@ bse_pcm_writer_open (BsePcmWriter *self,
       return bse_error_from_errno (errno, Bse::Error::FILE_OPEN_FAILED);
     }
   self->fd = fd;
+  self->writer_thread = new Bse::PcmWriterThread (fd, n_channels, sample_freq);
   self->open = TRUE;
   self->broken = FALSE;
   self->mutex.unlock();
@@ -109,6 +240,11 @@ bse_pcm_writer_close (BsePcmWriter *self)
   assert_return (BSE_IS_PCM_WRITER (self));
   assert_return (self->open);
   self->mutex.lock();
+  self->writer_thread->stop();  // flushes queued samples
+  self->n_bytes = self->writer_thread->n_bytes();
+  self->broken = self->writer_thread->failed();
+  delete self->writer_thread;
+  self->writer_thread = nullptr;
   bse_wave_file_patch_length (self->fd, self->n_bytes);
   close (self->fd);
   self->fd = -1;
@@ -131,11 +267,10 @@ bse_pcm_writer_write (BsePcmWriter *self, size_t n_values, const float *values,
   assert_return (self->open);
   return_unless (n_values);
   assert_return (values != NULL);
+  // only the engine thread accesses start_tick and n_queued once the writer is attached
   if (UNLIKELY (start_stamp + n_values <= self->start_tick))
     {
-      self->mutex.lock();
       self->start_tick = atomic_trigger_tick;
-      self->mutex.unlock();
       if (start_stamp + n_values <= self->start_tick)
         return; // writer not yet activated
     }
@@ -146,36 +281,15 @@ bse_pcm_writer_write (BsePcmWriter *self, size_t n_values, const float *values,
       values += delta;
       start_stamp += delta;
     }
-  self->mutex.lock();
-  const uint bw = 2; /* 16bit */
-  if (!self->broken && (!self->recorded_maximum || self->n_bytes < bw * self->recorded_maximum))
+  if (self->recorded_maximum)
     {
-      guint j;
-      guint8 *dest = g_new (guint8, n_values * bw);
-      uint n_bytes = gsl_conv_from_float_clip (GSL_WAVE_FORMAT_SIGNED_16,
-                                               G_BYTE_ORDER,
-                                               values,
-                                               dest,
-                                               n_values);
-      if (self->recorded_maximum)
-        n_bytes = bw * MIN (n_bytes / bw, self->recorded_maximum - self->n_bytes / bw);
-      do
-	j = write (self->fd, dest, n_bytes);
-      while (j < 0 && errno == EINTR);
-      if (j > 0)
-        {
-          self->n_bytes += j;
-          if (self->recorded_maximum && self->n_bytes >= bw * self->recorded_maximum)
-            bse_idle_next (bsethread_halt_recording, NULL);
-        }
-      g_free (dest);
-      if (j < 0 && errno)
-	{
- 	  Bse::info ("failed to write %u bytes to WAV file: %s", n_bytes, g_strerror (errno));
-	  self->broken = TRUE;
-	}
+      return_unless (self->n_queued < self->recorded_maximum);
+      n_values = MIN (n_values, self->recorded_maximum - self->n_queued);
     }
-  self->mutex.unlock();
+  self->writer_thread->push (values, n_values);
+  self->n_queued += n_values;
+  if (self->recorded_maximum && self->n_queued >= self->recorded_maximum)
+    bse_idle_next (bsethread_halt_recording, NULL);
 }
 
 namespace Bse {
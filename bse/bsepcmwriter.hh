@@ -13,6 +13,10 @@
 #define BSE_PCM_WRITER_GET_CLASS(object) (G_TYPE_INSTANCE_GET_CLASS ((object), BSE_TYPE_PCM_WRITER, BsePcmWriterClass))
 
 
+namespace Bse {
+class PcmWriterThread;
+} // Bse
+
 /* --- BsePcmWriter  --- */
 struct BsePcmWriter : BseItem {
   std::mutex	mutex;
@@ -22,6 +26,8 @@ struct BsePcmWriter : BseItem {
   Bse::uint64	n_bytes;
   Bse::uint64   recorded_maximum;
   Bse::uint64   start_tick;
+  Bse::uint64   n_queued;
+  Bse::PcmWriterThread *writer_thread;
 };
 struct BsePcmWriterClass : BseItemClass
 {};
@@ -29,7 +35,7 @@ struct BsePcmWriterClass : BseItemClass
 Bse::Error bse_pcm_writer_open	(BsePcmWriter *pdev, const gchar *file, guint n_channels,
                                  guint sample_freq, Bse::uint64 recorded_maximum);
 void	   bse_pcm_writer_close	(BsePcmWriter *pdev);
-/* writing is lock protected */
+/* writing queues into a ring buffer, disk I/O happens in a writer thread */
 void	   bse_pcm_writer_write	(BsePcmWriter *pdev, size_t n_values,
                                  const float *values, Bse::uint64 start_stamp);
 
@@ -5,6 +5,8 @@
 #include "bseenums.hh"
 #include "bsemain.hh"
 #include "bse/internal.hh"
+#include "bse/storage.hh"
+#include "bse/testing.hh"
 #include <gmodule.h>
 #include <string.h>
 #include <fcntl.h>
@@ -429,6 +431,33 @@ bse_plugin_reinit_types (BsePlugin *plugin)
   g_free (types);
 }
 
+static void
+bse_plugin_add_type (BsePlugin              *plugin,
+                     GType                   type,
+                     const char             *options,
+                     const BseExportStrings *export_strings,
+                     const char             *category,
+                     const guint8           *pixstream)
+{
+  const char *i18n_category = NULL;
+  guint n;
+  if (options && options[0])
+    bse_type_add_options (type, options);
+  n = plugin->n_types++;
+  plugin->types = g_renew (GType, plugin->types, plugin->n_types);
+  plugin->types[n] = type;
+  if (export_strings->blurb && export_strings->blurb[0])
+    bse_type_add_blurb (type, export_strings->blurb, export_strings->file, export_strings->line);
+  if (export_strings->authors && export_strings->authors[0])
+    bse_type_add_authors (type, export_strings->authors);
+  if (export_strings->license && export_strings->license[0])
+    bse_type_add_license (type, export_strings->license);
+  if (export_strings->i18n_category && export_strings->i18n_category[0])
+    i18n_category = export_strings->i18n_category;
+  if (category)
+    bse_categories_register (category, i18n_category, type, pixstream);
+}
+
 static void
 bse_plugin_init_types (BsePlugin *plugin)
 {
@@ -507,30 +536,199 @@ bse_plugin_init_types (BsePlugin *plugin)
         }
       if (type)
         {
-          const char *i18n_category = NULL;
-          guint n;
-          if (node->options && node->options[0])
-            bse_type_add_options (type, node->options);
-          n = plugin->n_types++;
-          plugin->types = g_renew (GType, plugin->types, plugin->n_types);
-          plugin->types[n] = type;
+          BseExportStrings export_strings = { 0, };
           node->type = type;
           if (node->fill_strings)
-            {
-              BseExportStrings export_strings = { 0, };
-              node->fill_strings (&export_strings);
-              if (export_strings.blurb && export_strings.blurb[0])
-                bse_type_add_blurb (type, export_strings.blurb, export_strings.file, export_strings.line);
-              if (export_strings.authors && export_strings.authors[0])
-                bse_type_add_authors (type, export_strings.authors);
-              if (export_strings.license && export_strings.license[0])
-                bse_type_add_license (type, export_strings.license);
-              if (export_strings.i18n_category && export_strings.i18n_category[0])
-                i18n_category = export_strings.i18n_category;
-            }
-          if (node->category)
-            bse_categories_register (node->category, i18n_category, type, node->pixstream);
+            node->fill_strings (&export_strings);
+          bse_plugin_add_type (plugin, type, node->options, &export_strings, node->category, node->pixstream);
+        }
+    }
+}
+
+/* --- type cache --- */
+/* plugin types which can be registered without loading the plugin */
+struct PluginTypeEntry {
+  guint  ntype = 0, line = 0;
+  String name, parent, options, category, pixstream;
+  String blurb, authors, license, i18n_category, file;
+};
+typedef std::vector<PluginTypeEntry> PluginTypeList;
+#define PLUGIN_TYPE_CACHE_LINES (12)    /* lines per PluginTypeEntry */
+
+static bool
+bse_plugin_collect_types (BsePlugin      *plugin,
+                          PluginTypeList &tlist)
+{
+  /* hooks, boxed types and resident types need plugin code at registration time */
+  if (plugin->resident_types || plugin->use_count)
+    return false;
+  for (BseExportNode *node = plugin->chain; node && node->ntype; node = node->next)
+    {
+      if (node->ntype == BSE_EXPORT_NODE_LINK)
+        continue;
+      if ((node->ntype != BSE_EXPORT_NODE_ENUM && node->ntype != BSE_EXPORT_NODE_CLASS) || !node->type)
+        return false;
+      PluginTypeEntry entry;
+      entry.ntype = node->ntype;
+      entry.name = node->name;
+      if (node->ntype == BSE_EXPORT_NODE_CLASS)
+        entry.parent = ((BseExportNodeClass*) node)->parent;
+      entry.options = node->options ? node->options : "";
+      entry.category = node->category ? node->category : "";
+      /* pixstreams are GdkPixdata streams with a big endian total length in their header */
+      if (node->pixstream && strncmp ((const char*) node->pixstream, "GdkP", 4) == 0)
+        {
+          const guint8 *l = node->pixstream + 4;
+          const guint length = l[0] << 24 | l[1] << 16 | l[2] << 8 | l[3];
+          if (length >= 24)
+            entry.pixstream = String ((const char*) node->pixstream, length);
         }
+      BseExportStrings export_strings = { 0, };
+      if (node->fill_strings)
+        node->fill_strings (&export_strings);
+      entry.blurb = export_strings.blurb ? export_strings.blurb : "";
+      entry.authors = export_strings.authors ? export_strings.authors : "";
+      entry.license = export_strings.license ? export_strings.license : "";
+      entry.i18n_category = export_strings.i18n_category ? export_strings.i18n_category : "";
+      entry.file = export_strings.file ? export_strings.file : "";
+      entry.line = export_strings.line;
+      tlist.push_back (entry);
+    }
+  return tlist.size() && tlist.size() == plugin->n_types;
+}
+
+static void
+plugin_types_cache_store (const gchar          *fname,
+                          const String         &key,
+                          const PluginTypeList &tlist)
+{
+  const String path = Bse::beastbse_cachefile_path ("plugins", fname);
+  if (path.empty())
+    return;
+  String data = key + Bse::string_format ("%u\n", tlist.size());
+  for (const PluginTypeEntry &entry : tlist)
+    {
+      data += Bse::string_format ("%u\n%u\n", entry.ntype, entry.line);
+      for (const String *field : { &entry.name, &entry.parent, &entry.options, &entry.category, &entry.pixstream,
+                                   &entry.blurb, &entry.authors, &entry.license, &entry.i18n_category, &entry.file })
+        data += Bse::string_to_cquote (*field) + "\n";
+    }
+  Bse::beastbse_cachefile_write (path, data);
+}
+
+/* load type list from the type cache, valid as long as the plugin and BSE are unmodified */
+static bool
+plugin_types_cache_load (const gchar    *fname,
+                         const String   &key,
+                         PluginTypeList &tlist)
+{
+  String payload;
+  if (!Bse::beastbse_cachefile_read (Bse::beastbse_cachefile_path ("plugins", fname), key, payload))
+    return false;
+  const Bse::StringVector lines = Bse::string_split (payload, "\n");
+  /* lines: n_types, fields per type, empty last line */
+  if (lines.size() < 2 || !lines.back().empty())
+    return false;
+  const size_t n_types = Bse::string_to_uint (lines[0]);
+  if (!n_types || lines.size() != 2 + PLUGIN_TYPE_CACHE_LINES * n_types)
+    return false;       /* truncated */
+  for (size_t i = 0; i < n_types; i++)
+    {
+      const String *l = &lines[1 + i * PLUGIN_TYPE_CACHE_LINES];
+      PluginTypeEntry entry;
+      entry.ntype = Bse::string_to_uint (*l++);
+      entry.line = Bse::string_to_uint (*l++);
+      for (String *field : { &entry.name, &entry.parent, &entry.options, &entry.category, &entry.pixstream,
+                             &entry.blurb, &entry.authors, &entry.license, &entry.i18n_category, &entry.file })
+        *field = Bse::string_from_cquote (*l++);
+      tlist.push_back (entry);
+    }
+  /* types must be registrable, otherwise the plugin needs to be loaded to figure why not */
+  for (const PluginTypeEntry &entry : tlist)
+    {
+      if (entry.name.empty() || g_type_from_name (entry.name.c_str()))
+        return false;
+      if (entry.ntype == BSE_EXPORT_NODE_CLASS)
+        {
+          const GType parent = g_type_from_name (entry.parent.c_str());
+          if (!parent || !BSE_TYPE_IS_OBJECT (parent))
+            return false;
+        }
+      else if (entry.ntype != BSE_EXPORT_NODE_ENUM)
+        return false;
+    }
+  return true;
+}
+
+BSE_INTEGRITY_TEST (bse_plugin_test_types_cache);
+static void
+bse_plugin_test_types_cache()
+{
+  char fname[] = "/tmp/bseplugin-cache-XXXXXX";
+  const int fd = mkstemp (fname);
+  TASSERT (fd >= 0);
+  TASSERT (write (fd, "plugin", 6) == 6);
+  PluginTypeList tlist (2), loaded;
+  tlist[0].ntype = BSE_EXPORT_NODE_CLASS;
+  tlist[0].name = "BseTestCachedPluginClass";
+  tlist[0].parent = "BseSource";
+  tlist[0].category = "/Modules/Test/Cached";
+  tlist[0].blurb = "Multi\nline \"blurb\"";
+  tlist[0].file = "cached.cc";
+  tlist[0].line = 17;
+  tlist[1].ntype = BSE_EXPORT_NODE_ENUM;
+  tlist[1].name = "BseTestCachedPluginEnum";
+  // round trip
+  const String key = Bse::beastbse_cachefile_key ("PLUGIN-TYPES-1", fname);
+  plugin_types_cache_store (fname, key, tlist);
+  TASSERT (plugin_types_cache_load (fname, key, loaded));
+  TASSERT (loaded.size() == tlist.size());
+  for (size_t i = 0; i < tlist.size(); i++)
+    {
+      TCMP (loaded[i].ntype, ==, tlist[i].ntype);
+      TCMP (loaded[i].line, ==, tlist[i].line);
+      TCMP (loaded[i].name, ==, tlist[i].name);
+      TCMP (loaded[i].parent, ==, tlist[i].parent);
+      TCMP (loaded[i].category, ==, tlist[i].category);
+      TCMP (loaded[i].blurb, ==, tlist[i].blurb);
+      TCMP (loaded[i].file, ==, tlist[i].file);
+    }
+  // modifying the plugin file invalidates its cache entry
+  TASSERT (write (fd, "!", 1) == 1);
+  close (fd);
+  loaded.clear();
+  TASSERT (!plugin_types_cache_load (fname, Bse::beastbse_cachefile_key ("PLUGIN-TYPES-1", fname), loaded));
+  unlink (Bse::beastbse_cachefile_path ("plugins", fname).c_str());
+  unlink (fname);
+}
+
+static void
+bse_plugin_init_cached_types (BsePlugin            *plugin,
+                              const PluginTypeList &tlist)
+{
+  /* register types from cache, enum choice getters are set upon reinit_types */
+  for (const PluginTypeEntry &entry : tlist)
+    {
+      GType type;
+      if (entry.ntype == BSE_EXPORT_NODE_ENUM)
+        {
+          type = bse_type_register_dynamic (G_TYPE_ENUM, entry.name.c_str(), G_TYPE_PLUGIN (plugin));
+          g_value_register_transform_func (SFI_TYPE_CHOICE, type, sfi_value_choice2enum_simple);
+          g_value_register_transform_func (type, SFI_TYPE_CHOICE, sfi_value_enum2choice);
+        }
+      else /* BSE_EXPORT_NODE_CLASS */
+        type = bse_type_register_dynamic (g_type_from_name (entry.parent.c_str()),
+                                          entry.name.c_str(), G_TYPE_PLUGIN (plugin));
+      BseExportStrings export_strings = { 0, };
+      export_strings.blurb = entry.blurb.c_str();
+      export_strings.authors = entry.authors.c_str();
+      export_strings.license = entry.license.c_str();
+      export_strings.i18n_category = entry.i18n_category.c_str();
+      export_strings.file = entry.file.empty() ? NULL : entry.file.c_str();
+      export_strings.line = entry.line;
+      bse_plugin_add_type (plugin, type, entry.options.c_str(), &export_strings,
+                           entry.category.empty() ? NULL : entry.category.c_str(),
+                           entry.pixstream.empty() ? NULL : (const guint8*) entry.pixstream.data());
     }
 }
 
@@ -604,6 +802,18 @@ bse_plugin_check_load (const gchar *const_file_name)
   else
     file_name = g_strdup (const_file_name);
   PDEBUG ("register: %s", file_name);
+  /* plugins with cached types are registered without loading them */
+  const String cachekey = Bse::beastbse_cachefile_key ("PLUGIN-TYPES-1", file_name);
+  PluginTypeList tlist;
+  if (plugin_types_cache_load (file_name, cachekey, tlist))
+    {
+      BsePlugin *plugin = (BsePlugin*) bse_object_new (BSE_TYPE_PLUGIN, NULL);
+      plugin->fname = file_name;
+      bse_plugin_init_cached_types (plugin, tlist);
+      bse_plugins = g_slist_prepend (bse_plugins, plugin);
+      PDEBUG ("registered-from-cache: %s", file_name);
+      return NULL;
+    }
   /* load module */
   BsePlugin *plugin = (BsePlugin*) bse_object_new (BSE_TYPE_PLUGIN, NULL);
   plugin->fname = g_strdup (file_name);
@@ -647,6 +857,9 @@ bse_plugin_check_load (const gchar *const_file_name)
 
       /* register BSE module types */
       bse_plugin_init_types (plugin);
+      tlist.clear();
+      if (!cachekey.empty() && bse_plugin_collect_types (plugin, tlist))
+        plugin_types_cache_store (file_name, cachekey, tlist);
 
       bse_plugins = g_slist_prepend (bse_plugins, plugin);
       if (plugin->use_count == 0)
@@ -869,3 +869,204 @@ Resampler2::test_filter_impl (bool verbose)
       return true;
     }
 }
+
+/* --- ResamplerN --- */
+namespace { // Anon
+
+/* zeroth order modified Bessel function of the first kind, for the Kaiser window */
+static double
+bessel_i0 (double x)
+{
+  double sum = 1, term = 1;
+  for (uint k = 1; term > sum * 1e-17; k++)
+    {
+      term *= (x / (2 * k)) * (x / (2 * k));
+      sum += term;
+    }
+  return sum;
+}
+
+/* Kaiser window beta for a given stopband attenuation in dB */
+static double
+kaiser_beta (double attenuation)
+{
+  if (attenuation > 50)
+    return 0.1102 * (attenuation - 8.7);
+  if (attenuation > 21)
+    return 0.5842 * pow (attenuation - 21, 0.4) + 0.07886 * (attenuation - 21);
+  return 0;
+}
+
+/* dot product of input and taps, n_taps must be a multiple of 4 */
+template<bool USE_SSE> static inline float
+polyphase_process_one_sample (const float *input,
+                              const float *taps,
+                              uint         n_taps)
+{
+#ifdef __SSE__
+  if (USE_SSE)
+    {
+      /* two accumulators hide the latency of the additions */
+      __m128 acc0 = _mm_mul_ps (_mm_loadu_ps (input), _mm_loadu_ps (taps));
+      __m128 acc1 = _mm_setzero_ps();
+      uint i = 4;
+      for (; i + 8 <= n_taps; i += 8)
+        {
+          acc0 = _mm_add_ps (acc0, _mm_mul_ps (_mm_loadu_ps (input + i), _mm_loadu_ps (taps + i)));
+          acc1 = _mm_add_ps (acc1, _mm_mul_ps (_mm_loadu_ps (input + i + 4), _mm_loadu_ps (taps + i + 4)));
+        }
+      if (i < n_taps)
+        acc1 = _mm_add_ps (acc1, _mm_mul_ps (_mm_loadu_ps (input + i), _mm_loadu_ps (taps + i)));
+      F4Vector sum;
+      sum.v = _mm_add_ps (acc0, acc1);
+      return sum.f[0] + sum.f[1] + sum.f[2] + sum.f[3];
+    }
+#endif
+  return fir_process_one_sample<float> (input, taps, n_taps);
+}
+
+template<bool USE_SSE> static void
+polyphase_process_frames (const float *input,
+                          const float *taps,
+                          uint         n_taps,
+                          uint         n_phases,
+                          uint         step,
+                          uint64       phase,
+                          uint         n_output_samples,
+                          float       *output)
+{
+  for (uint i = 0; i < n_output_samples; i++)
+    {
+      output[i] = polyphase_process_one_sample<USE_SSE> (input, taps + phase * n_taps, n_taps);
+      phase += step;
+      input += phase / n_phases;
+      phase %= n_phases;
+    }
+}
+
+} // Anon
+
+ResamplerN::ResamplerN (double                input_rate,
+                        double                output_rate,
+                        Resampler2::Precision precision,
+                        bool                  use_sse_if_available) :
+  use_sse_ (Resampler2::sse_available() && use_sse_if_available)
+{
+  assert_return (input_rate > 0 && output_rate > 0);
+  /* approximate input_rate / output_rate by the continued fraction M / L with L <= MAX_PHASES */
+  uint64 m0 = 0, m1 = 1, l0 = 1, l1 = 0;
+  double x = input_rate / output_rate;
+  for (uint i = 0; i < 64; i++)
+    {
+      double a = floor (x);
+      if (a > 1e9 || l0 + a * l1 > MAX_PHASES)
+        {
+          /* the best semiconvergent within MAX_PHASES, if it beats the last convergent */
+          a = l1 ? floor ((MAX_PHASES - l0) / double (l1)) : 0;
+          if (a > 0 && fabs ((a * m1 + m0) / (a * l1 + l0) - input_rate / output_rate) < fabs (m1 / double (l1) - input_rate / output_rate))
+            m1 = a * m1 + m0, l1 = a * l1 + l0;
+          break;
+        }
+      const uint64 m2 = a * m1 + m0, l2 = a * l1 + l0;
+      m0 = m1, m1 = m2, l0 = l1, l1 = l2;
+      if (fabs (m1 / double (l1) * output_rate - input_rate) <= 1e-9 * input_rate || x - a < 1e-9)
+        break;
+      x = 1 / (x - a);
+    }
+  n_phases_ = l1;
+  step_ = m1;
+  assert_return (n_phases_ > 0 && step_ > 0);
+  /* stretch the kernel for downsampling, so its cutoff moves to the output Nyquist frequency */
+  const double scale = std::min (1.0, n_phases_ / double (step_));
+  const double cutoff = 0.5 * scale;    // cycles per input sample
+  double attenuation = 0;
+  switch (precision)
+    {
+    case Resampler2::PREC_LINEAR: n_taps_ = 2; break;
+    case Resampler2::PREC_48DB:   n_taps_ = 16; attenuation = 48;  break;
+    case Resampler2::PREC_72DB:   n_taps_ = 24; attenuation = 72;  break;
+    case Resampler2::PREC_96DB:   n_taps_ = 32; attenuation = 96;  break;
+    case Resampler2::PREC_120DB:  n_taps_ = 44; attenuation = 120; break;
+    case Resampler2::PREC_144DB:  n_taps_ = 52; attenuation = 144; break;
+    }
+  assert_return (n_taps_ > 0);
+  if (n_taps_ > 2)
+    n_taps_ = (uint (ceil (n_taps_ / scale)) + 3) & ~3;
+  else
+    use_sse_ = false;                   // SSE kernels need multiples of 4 taps
+  const double beta = kaiser_beta (attenuation), half_width = n_taps_ / 2.0;
+  taps_.resize (size_t (n_phases_) * n_taps_);
+  for (uint p = 0; p < n_phases_; p++)
+    {
+      float *ptaps = &taps_[size_t (p) * n_taps_];
+      const double frac = p / double (n_phases_);
+      double sum = 0;
+      for (uint j = 0; j < n_taps_; j++)
+        {
+          const double d = double (j) - history() - frac;      // distance to the output position
+          double h;
+          if (n_taps_ == 2)
+            h = 1 - fabs (d);                           // linear interpolation
+          else
+            {
+              const double w = d / half_width;
+              const double window = bessel_i0 (beta * sqrt (std::max (0.0, 1 - w * w))) / bessel_i0 (beta);
+              const double sinc = d == 0 ? 1 : sin (M_PI * 2 * cutoff * d) / (M_PI * 2 * cutoff * d);
+              h = 2 * cutoff * sinc * window;
+            }
+          ptaps[j] = h;
+          sum += h;
+        }
+      for (uint j = 0; j < n_taps_; j++)        // unity DC gain for every phase
+        ptaps[j] /= sum;
+    }
+  reset();
+}
+
+void
+ResamplerN::process_frames (const float *input,
+                            int64        output_index,
+                            uint         n_output_samples,
+                            float       *output) const
+{
+  const int64 p = output_index * step_;
+  const uint64 phase = p - input_index (output_index) * n_phases_;
+  if (use_sse_)
+    polyphase_process_frames<true> (input, &taps_[0], n_taps_, n_phases_, step_, phase, n_output_samples, output);
+  else
+    polyphase_process_frames<false> (input, &taps_[0], n_taps_, n_phases_, step_, phase, n_output_samples, output);
+}
+
+uint
+ResamplerN::process_block (const float *input,
+                           uint         n_input_samples,
+                           float       *output)
+{
+  pending_.insert (pending_.end(), input, input + n_input_samples);
+  /* output sample k is complete once input_index (k) + lookahead() has been seen */
+  const int64 last_input = pending_start_ + int64 (pending_.size()) - 1 - lookahead();
+  const int64 output_end = last_input < 0 ? 0 : ((last_input + 1) * n_phases_ - 1) / step_ + 1;
+  const uint n_output_samples = std::max (output_end, output_pos_) - output_pos_;
+  if (n_output_samples)
+    {
+      process_frames (&pending_[input_index (output_pos_) - history() - pending_start_], output_pos_, n_output_samples, output);
+      output_pos_ = output_end;
+    }
+  /* keep the history of the next output sample */
+  const int64 keep_start = input_index (output_pos_) - history();
+  const int64 n_drop = std::min (keep_start - pending_start_, int64 (pending_.size()));
+  if (n_drop > 0)
+    {
+      pending_.erase (pending_.begin(), pending_.begin() + n_drop);
+      pending_start_ += n_drop;
+    }
+  return n_output_samples;
+}
+
+void
+ResamplerN::reset()
+{
+  pending_.assign (history(), 0.0);
+  pending_start_ = -int64 (history());
+  output_pos_ = 0;
+}
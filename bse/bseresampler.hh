@@ -144,6 +144,96 @@ protected:
 	       Precision precision);
 };
 
+/**
+ * Arbitrary ratio resampler, using a polyphase bank of Kaiser windowed sinc filters
+ *
+ * The resampling ratio is approximated by a fraction L/M with at most
+ * MAX_PHASES filter phases, common sample rate conversions like 44100 Hz
+ * to 48000 Hz are represented exactly. Output sample k is located at input
+ * position k * M / L, so unlike Resampler2, there is no delay to compensate.
+ */
+class ResamplerN {
+  uint                 n_phases_ = 0;   // L
+  uint                 step_ = 0;       // M
+  uint                 n_taps_ = 0;     // per phase, multiple of 4
+  bool                 use_sse_ = false;
+  std::vector<float>   taps_;           // n_phases_ * n_taps_
+  // streaming state
+  std::vector<float>   pending_;
+  int64                pending_start_ = 0;
+  int64                output_pos_ = 0;
+public:
+  static constexpr uint MAX_PHASES = 4096;
+  /**
+   * creates a resampler for converting @a input_rate to @a output_rate with the given precision
+   */
+  ResamplerN (double                input_rate,
+              double                output_rate,
+              Resampler2::Precision precision,
+              bool                  use_sse_if_available = true);
+  /**
+   * number of input samples needed before the input position of an output sample
+   */
+  uint   history () const           { return n_taps_ / 2 - 1; }
+  /**
+   * number of input samples needed after the input position of an output sample
+   */
+  uint   lookahead () const         { return n_taps_ / 2; }
+  /**
+   * return FIR filter length per phase, in input samples
+   */
+  uint   order () const             { return n_taps_; }
+  /**
+   * the exact resampling ratio as number of output samples per @a step() input samples
+   */
+  uint   phases () const            { return n_phases_; }
+  uint   step () const              { return step_; }
+  /**
+   * index of the input sample at or before the position of output sample @a output_index
+   */
+  int64
+  input_index (int64 output_index) const
+  {
+    const int64 p = output_index * step_;
+    return p >= 0 ? p / n_phases_ : -((n_phases_ - 1 - p) / n_phases_);
+  }
+  /**
+   * number of output samples for @a n_input_samples input samples
+   */
+  int64
+  output_length (int64 n_input_samples) const
+  {
+    return (n_input_samples * n_phases_ + step_ - 1) / step_;
+  }
+  /**
+   * number of input samples needed by process_frames() for @a n_output_samples
+   */
+  uint
+  input_length (int64 output_index, uint n_output_samples) const
+  {
+    return input_index (output_index + n_output_samples - 1) - input_index (output_index) + n_taps_;
+  }
+  /**
+   * compute output samples [output_index, output_index + n_output_samples) without
+   * touching the streaming state, @a input holds input_length() samples, starting
+   * with input sample input_index (output_index) - history()
+   */
+  void   process_frames (const float *input, int64 output_index, uint n_output_samples, float *output) const;
+  /**
+   * resample a data block, returns the number of output samples, which is at most
+   * output_length (n_input_samples) + 1; output lags input by lookahead() input samples
+   */
+  uint   process_block  (const float *input, uint n_input_samples, float *output);
+  /**
+   * clear internal history, reset resampler state to zero values
+   */
+  void   reset          ();
+  /**
+   * return whether the resampler is using sse optimized code
+   */
+  bool   sse_enabled    () const    { return use_sse_; }
+};
+
 } /* namespace Bse */
 
 #endif /* __BSE_RESAMPLER_HH__ */
@@ -7,6 +7,7 @@
 #include "bsepcmwriter.hh"
 #include "bsecxxplugin.hh"
 #include "gsldatahandle-mad.hh"
+#include "gslfilehash.hh"
 #include "gslvorbis-enc.hh"
 #include "bseladspa.hh"
 #include "devicecrawler.hh"
@@ -291,7 +292,7 @@ bse_server_open_devices (BseServer *self)
   /* calculate block_size for pcm setup */
   const uint latency = Bse::global_prefs->synth_latency;
   const uint mix_freq = bse_engine_sample_freq();
-  uint block_size = BSE_ENGINE_MAX_BLOCK_SIZE;
+  uint block_size = bse_engine_max_block_size();
   /* try opening devices */
   if (error == 0)
     error = impl->open_pcm_driver (mix_freq, latency, &block_size);
@@ -644,7 +645,8 @@ ServerImpl::ServerImpl (BseObject *bobj) :
   ContainerImpl (bobj)
 {
   auto *audio_timing = new AudioSignal::AudioTiming { 120, 0 };
-  engine_ = new AudioSignal::Engine { bse_engine_sample_freq(), *audio_timing, bse_main_wakeup };
+  engine_ = new AudioSignal::Engine { bse_engine_sample_freq(), bse_engine_max_block_size(), *audio_timing, bse_main_wakeup };
+  engine_->set_render_threads (std::max (int64 (1), config_int ("jobs", 1)) - 1);
   BseServer *self = const_cast<ServerImpl*> (this)->as<BseServer*>();
   bse_pcm_module_set_processor_engine (self->pcm_omodule, engine_);
 }
@@ -844,6 +846,7 @@ void
 ServerImpl::purge_stale_cachedirs ()
 {
   beastbse_cachedir_cleanup();
+  gsl_hfile_index_cleanup();
 }
 
 void
@@ -1088,6 +1091,16 @@ ServerImpl::tick_stamp_from_systime (int64 systime_usecs)
   return bse_engine_tick_stamp_from_systime (systime_usecs);
 }
 
+/* Binary telemetry frames come in two kinds. Full frames contain all fragments at
+ * their `bpos`, the first 8 bytes are unused by clients and left 0. Delta frames
+ * start with SHM_DELTA_MAGIC and the full frame length as uint32, followed by runs
+ * of changed fragments: uint32 bpos, uint32 blength and the fragment bytes padded
+ * to a multiple of 4. Full frames are sent after plan changes and periodically, so
+ * clients that missed or discarded a frame resynchronize.
+ */
+static constexpr uint32 SHM_DELTA_MAGIC = 0x41544c44;   // "DLTA"
+static constexpr uint   SHM_KEYFRAME_INTERVAL = 64;
+
 struct FragmentBroadcaster {
   using BinarySender = IpcHandler::BinarySender;
   BinarySender   binary_sender;
@@ -1096,9 +1109,46 @@ struct FragmentBroadcaster {
   ShmFragmentSeq plan;
   SharedMemory   smem;
   uint           timerid = 0;
+  std::string    frame;         // last frame contents known to the client
+  uint           frame_counter = 0;
 };
 static std::vector<FragmentBroadcaster> fbroadcasters;
 
+static std::string
+encode_shm_frame (FragmentBroadcaster &broad)
+{
+  const char *shm_start = (char*) broad.smem.shm_start;
+  const bool keyframe = broad.frame.size() != broad.binary_size || broad.frame_counter++ % SHM_KEYFRAME_INTERVAL == 0;
+  if (keyframe)
+    {
+      broad.frame.assign (broad.binary_size, 0);
+      char *data = &broad.frame[0];
+      for (const auto &frag : broad.plan)       // offsets and lengths were validated earlier
+        memcpy (data + frag.bpos, shm_start + frag.shmoffset, frag.blength);
+      broad.frame_counter = 1;
+      return broad.frame;
+    }
+  std::string delta;
+  char *data = &broad.frame[0];
+  for (const auto &frag : broad.plan)
+    {
+      const char *fresh = shm_start + frag.shmoffset;
+      if (memcmp (data + frag.bpos, fresh, frag.blength) == 0)
+        continue;
+      memcpy (data + frag.bpos, fresh, frag.blength);
+      if (delta.empty())
+        {
+          const uint32 header[2] = { SHM_DELTA_MAGIC, uint32 (broad.binary_size) };
+          delta.append ((const char*) header, sizeof (header));
+        }
+      const uint32 run[2] = { uint32 (frag.bpos), uint32 (frag.blength) };
+      delta.append ((const char*) run, sizeof (run));
+      delta.append (fresh, frag.blength);
+      delta.append ((4 - frag.blength % 4) % 4, 0);
+    }
+  return delta;                                 // empty if nothing changed
+}
+
 static void
 broadcast_timer (ptrdiff_t conid)
 {
@@ -1109,13 +1159,9 @@ broadcast_timer (ptrdiff_t conid)
   if (i >= fbroadcasters.size())
     return;                                     // should not happen
   FragmentBroadcaster &broad = fbroadcasters[i];
-  const SharedMemory &smem = broad.smem;
-  const char *shm_start = (char*) smem.shm_start;
-  std::string binary;
-  binary.resize (broad.binary_size);
-  char *data = &binary[0];
-  for (const auto &frag : broad.plan)           // offsets and lengths were validated earlier
-    memcpy (data + frag.bpos, shm_start + frag.shmoffset, frag.blength);
+  std::string binary = encode_shm_frame (broad);
+  if (binary.empty())
+    return;                                     // client is up to date
   const bool keep_alive = broad.binary_sender (binary);
   if (!keep_alive)                              // clear slot, disable timer
     {
@@ -1125,6 +1171,7 @@ broadcast_timer (ptrdiff_t conid)
       broad.binary_sender = nullptr;
       broad.plan.clear();
       broad.smem = SharedMemory();
+      broad.frame.clear();
     }
 }
 
@@ -1178,6 +1225,7 @@ ServerImpl::broadcast_shm_fragments (const ShmFragmentSeq &plan, int interval_ms
   broad.timerid = 0;
   broad.plan = plan;
   broad.binary_size = maxlen;
+  broad.frame.clear();                          // start with a full frame
   if (plan.empty())                             // reset of old plan
     {
       broad.conid = 0;
@@ -1215,6 +1263,26 @@ ServerImpl::get_shared_memory()
   return sm;
 }
 
+static_assert (offsetof (BseEngineTelemetry, n_dispatches) == ptrdiff_t (EngineTelemetry::I32_DISPATCHES));
+static_assert (offsetof (BseEngineTelemetry, n_jobs) == ptrdiff_t (EngineTelemetry::I32_JOBS));
+static_assert (offsetof (BseEngineTelemetry, max_dispatch_jobs) == ptrdiff_t (EngineTelemetry::I32_MAX_DISPATCH_JOBS));
+static_assert (offsetof (BseEngineTelemetry, n_transactions) == ptrdiff_t (EngineTelemetry::I32_TRANSACTIONS));
+static_assert (offsetof (BseEngineTelemetry, latency_usecs) == ptrdiff_t (EngineTelemetry::I32_LATENCY_USECS));
+static_assert (offsetof (BseEngineTelemetry, max_latency_usecs) == ptrdiff_t (EngineTelemetry::I32_MAX_LATENCY_USECS));
+static_assert (sizeof (BseEngineTelemetry) == ptrdiff_t (EngineTelemetry::BYTECOUNT));
+
+int64
+ServerImpl::get_shm_offset (EngineTelemetry fld)
+{
+  if (!engine_shm_block_.mem_start)
+    {
+      // the master thread keeps writing to the block, so it is never released
+      engine_shm_block_ = allocate_shared_block (ptrdiff_t (EngineTelemetry::BYTECOUNT));
+      bse_engine_telemetry (new (engine_shm_block_.mem_start) BseEngineTelemetry());
+    }
+  return engine_shm_block_.mem_offset + ptrdiff_t (fld);
+}
+
 size_t
 ServerImpl::shared_block_offset (const void *mem) const
 {
@@ -1324,7 +1392,7 @@ ServerImpl::open_midi_driver()
 {
   assert_return (midi_driver_ == nullptr, Error::INTERNAL);
   Error error = Error::UNKNOWN;
-  midi_driver_ = MidiDriver::open (get_prefs().midi_driver, Driver::READONLY, &error);
+  midi_driver_ = MidiDriver::open (offline_rendering_ ? "null" : get_prefs().midi_driver, Driver::READONLY, &error);
   if (!midi_driver_)
     {
       UserMessage umsg;
@@ -1370,7 +1438,8 @@ ServerImpl::open_pcm_driver (uint mix_freq, uint latency, uint *block_size)
   config.mix_freq = mix_freq;
   config.latency_ms = latency;
   config.block_length = *block_size;
-  pcm_driver_ = PcmDriver::open (get_prefs().pcm_driver, Driver::READWRITE, Driver::WRITEONLY, config, &error);
+  const String devid = offline_rendering_ ? "null=offline" : get_prefs().pcm_driver;
+  pcm_driver_ = PcmDriver::open (devid, Driver::READWRITE, Driver::WRITEONLY, config, &error);
   if (pcm_driver_)
     *block_size = pcm_driver_->block_length();
   else // !pcm_driver_
@@ -1389,6 +1458,20 @@ ServerImpl::open_pcm_driver (uint mix_freq, uint latency, uint *block_size)
   return pcm_driver_ ? Error::NONE : error;
 }
 
+/// Select offline rendering, devices opened afterwards ignore the driver preferences and render unthrottled.
+void
+ServerImpl::offline_rendering (bool offline)
+{
+  assert_return (pcm_driver_ == nullptr);
+  offline_rendering_ = offline;
+}
+
+bool
+ServerImpl::offline_rendering () const
+{
+  return offline_rendering_;
+}
+
 void
 ServerImpl::require_pcm_input()
 {
@@ -55,10 +55,12 @@ class ServerImpl : public virtual ServerIface, public virtual ContainerImpl {
   int32              tc_ = 0;
   bool               log_messages_ = true;
   bool               pcm_input_checked_ = false;
+  bool               offline_rendering_ = false;
   PcmDriverP         pcm_driver_;
   MidiDriverP        midi_driver_;
   AudioSignal::Engine     *engine_ = nullptr;
   AudioSignal::ProcessorP  midi_proc_;
+  SharedBlock              engine_shm_block_;
 protected:
   virtual             ~ServerImpl            ();
 public:
@@ -78,6 +80,8 @@ public:
   PcmDriverP          pcm_driver            () const { return pcm_driver_; }
   Error               open_pcm_driver       (uint mix_freq, uint latency, uint *block_size);
   void                require_pcm_input     ();
+  void                offline_rendering     (bool offline);
+  bool                offline_rendering     () const;
   void                close_pcm_driver      ();
   void                add_pcm_output_processor (AudioSignal::ProcessorP procp);
   void                del_pcm_output_processor (AudioSignal::ProcessorP procp);
@@ -90,6 +94,7 @@ public:
   virtual bool             engine_active    () override;
   virtual LegacyObjectIfaceP    from_proxy       (int64_t proxyid) override;
   virtual SharedMemory  get_shared_memory   () override;
+  virtual int64         get_shm_offset      (EngineTelemetry fld) override;
   virtual void    broadcast_shm_fragments   (const ShmFragmentSeq &plan, int interval_ms) override;
   virtual String        get_mp3_version     () override;
   virtual String        get_vorbis_version  () override;
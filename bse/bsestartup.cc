@@ -116,6 +116,17 @@ init_args (int *argc, char **argv)
           args.push_back ("jobs=" + std::string (argv[i]));
 	  argv[i] = NULL;
 	}
+      else if (strcmp ("--bse-block-size", argv[i]) == 0 && i + 1 < cargc)
+	{
+          argv[i++] = NULL;
+          args.push_back ("block-size=" + std::string (argv[i]));
+	  argv[i] = NULL;
+	}
+      else if (strcmp ("--bse-pin-dsp-threads", argv[i]) == 0)
+	{
+          args.push_back ("pin-dsp-threads=1");
+	  argv[i] = NULL;
+	}
     }
 
   if (*argc > 1)
@@ -2,6 +2,8 @@
 #include "combo.hh"
 #include "bseserver.hh"
 #include "internal.hh"
+#include <condition_variable>
+#include <unordered_map>
 
 #define PDEBUG(...)     Bse::debug ("processor", __VA_ARGS__)
 
@@ -262,7 +264,7 @@ Chain::insert (ProcessorP proc, size_t pos)
   }
   // fixup following connections
   reconnect (index);
-  engine_.reschedule();
+  engine_.reschedule (*this);
   enqueue_notify_mt (INSERTION);
 }
 
@@ -357,13 +359,250 @@ Chain::processor_interface () const
   return std::make_shared<Bse::ComboImpl> (*const_cast<Chain*> (this));
 }
 
+// == Engine::RenderPool ==
+/* The RenderPool turns the linear Engine schedule into a dependency graph. Each node
+ * carries an atomic counter of pending inputs, once it drops to zero, the node is
+ * pushed onto a ready queue that the engine thread and all workers race over.
+ * The ready queue is single-use per block, every node is pushed exactly once, so
+ * plain atomic head/tail indices suffice and no locks are taken while nodes are ready.
+ * Threads that find no ready node spin briefly and then park until a node is pushed,
+ * and only as many workers are woken as the widest level of the graph can use.
+ */
+class Engine::RenderPool {
+  static constexpr uint32 NONE = ~uint32 (0);
+  static constexpr uint   SPIN_LIMIT = 256;         // BSE_CPU_RELAX() rounds before parking
+  struct Node {
+    Processor          *proc = nullptr;
+    uint32              n_inputs = 0;
+    std::atomic<uint32> pending { 0 };
+    std::vector<uint32> outputs;        // dependent nodes
+  };
+  std::unique_ptr<Node[]>                nodes_;
+  std::unique_ptr<std::atomic<uint32>[]> ready_;
+  std::vector<uint32>                    roots_;        // nodes without inputs
+  uint32                                 n_nodes_ = 0;
+  alignas (64) std::atomic<uint32>       ready_head_ { 0 };
+  alignas (64) std::atomic<uint32>       ready_tail_ { 0 };
+  alignas (64) std::atomic<uint32>       n_done_ { 0 };
+  alignas (64) std::atomic<uint32>       n_active_ { 0 };
+  alignas (64) std::atomic<uint32>       n_parked_ { 0 };
+  std::mutex                             park_mutex_;
+  std::condition_variable                park_cond_;
+  std::mutex                             mutex_;
+  std::condition_variable                cond_;
+  uint32                                 n_wanted_ = 0;         // workers useful for the schedule
+  uint64                                 generation_ = 0;       // guarded by mutex_
+  bool                                   running_ = true;       // guarded by mutex_
+  std::vector<std::thread>               threads_;
+  void
+  push_ready (uint32 idx)
+  {
+    const uint32 t = ready_tail_.fetch_add (1, std::memory_order_seq_cst);
+    ready_[t].store (idx, std::memory_order_release);
+    if (n_parked_.load (std::memory_order_seq_cst) > 0)
+      wake_parked();
+  }
+  void
+  wake_parked ()
+  {
+    std::lock_guard<std::mutex> locker (park_mutex_);
+    park_cond_.notify_all();
+  }
+  void
+  park ()
+  {
+    std::unique_lock<std::mutex> locker (park_mutex_);
+    n_parked_.fetch_add (1, std::memory_order_seq_cst);
+    park_cond_.wait (locker, [this] () {
+      return ready_head_.load (std::memory_order_seq_cst) < ready_tail_.load (std::memory_order_seq_cst) ||
+             n_done_.load (std::memory_order_acquire) >= n_nodes_;
+    });
+    n_parked_.fetch_sub (1, std::memory_order_seq_cst);
+  }
+  uint32
+  pop_ready ()
+  {
+    uint32 h = ready_head_.load (std::memory_order_acquire);
+    while (h < ready_tail_.load (std::memory_order_acquire))
+      {
+        const uint32 idx = ready_[h].load (std::memory_order_acquire);
+        if (idx == NONE)
+          return NONE;                  // slot claimed but not yet filled
+        if (ready_head_.compare_exchange_weak (h, h + 1, std::memory_order_acq_rel))
+          return idx;
+      }
+    return NONE;
+  }
+  void
+  process_nodes ()
+  {
+    uint spins = 0;
+    while (n_done_.load (std::memory_order_acquire) < n_nodes_)
+      {
+        const uint32 idx = pop_ready();
+        if (idx == NONE)
+          {
+            if (++spins < SPIN_LIMIT)
+              BSE_CPU_RELAX();
+            else
+              {
+                park();
+                spins = 0;
+              }
+            continue;
+          }
+        spins = 0;
+        Node &node = nodes_[idx];
+        node.proc->render_block();
+        for (const uint32 o : node.outputs)
+          if (nodes_[o].pending.fetch_sub (1, std::memory_order_acq_rel) == 1)
+            push_ready (o);
+        if (n_done_.fetch_add (1, std::memory_order_seq_cst) + 1 == n_nodes_ &&
+            n_parked_.load (std::memory_order_seq_cst) > 0)
+          wake_parked();        // let parked threads leave the block
+      }
+  }
+  void
+  worker (uint nth)
+  {
+    const std::string myid = string_format ("DSP-Render-#%u", nth);
+    this_thread_set_name (myid);
+    TaskRegistry::add (myid, this_thread_getpid(), this_thread_gettid());
+    uint64 seen = 0;
+    for (;;)
+      {
+        {
+          std::unique_lock<std::mutex> locker (mutex_);
+          cond_.wait (locker, [&] () { return !running_ || generation_ != seen; });
+          if (!running_)
+            break;
+          seen = generation_;
+          if (nth > n_wanted_)
+            continue;           // the schedule has no work for this many threads
+          n_active_ += 1;       // must be incremented under mutex_, see render()
+        }
+        process_nodes();
+        n_active_ -= 1;
+      }
+    TaskRegistry::remove (this_thread_gettid());
+  }
+public:
+  explicit
+  RenderPool (uint n_threads)
+  {
+    for (uint i = 0; i < n_threads; i++)
+      threads_.push_back (std::thread (&RenderPool::worker, this, 1 + i));
+  }
+  ~RenderPool()
+  {
+    {
+      std::lock_guard<std::mutex> locker (mutex_);
+      running_ = false;
+    }
+    cond_.notify_all();
+    for (auto &thread : threads_)
+      thread.join();
+  }
+  uint
+  n_threads () const
+  {
+    return threads_.size();
+  }
+  // Build the dependency graph from `schedule` (in serial render order) and its edges.
+  void
+  assign (const std::vector<Processor*> &schedule, std::vector<ScheduleEdge> &edges)
+  {
+    std::lock_guard<std::mutex> locker (mutex_);
+    while (n_active_.load() > 0)
+      BSE_CPU_RELAX();
+    n_nodes_ = schedule.size();
+    nodes_.reset (n_nodes_ ? new Node[n_nodes_] : nullptr);
+    ready_.reset (n_nodes_ ? new std::atomic<uint32>[n_nodes_] : nullptr);
+    roots_.clear();
+    std::unordered_map<Processor*,uint32> indices;
+    indices.reserve (n_nodes_);
+    for (uint32 i = 0; i < n_nodes_; i++)
+      {
+        nodes_[i].proc = schedule[i];
+        indices[schedule[i]] = i;
+      }
+    std::sort (edges.begin(), edges.end());
+    edges.erase (std::unique (edges.begin(), edges.end()), edges.end());
+    for (const auto &edge : edges)
+      {
+        const auto dep = indices.find (edge.first), dpt = indices.find (edge.second);
+        // keep edges that agree with the serial order, this also breaks cycles
+        if (dep != indices.end() && dpt != indices.end() && dep->second < dpt->second)
+          {
+            nodes_[dep->second].outputs.push_back (dpt->second);
+            nodes_[dpt->second].n_inputs += 1;
+          }
+      }
+    for (uint32 i = 0; i < n_nodes_; i++)
+      if (nodes_[i].n_inputs == 0)
+        roots_.push_back (i);
+    // edges follow the serial order, so levels can be assigned in a single pass
+    std::vector<uint32> levels (n_nodes_, 0), widths;
+    for (uint32 i = 0; i < n_nodes_; i++)
+      {
+        if (levels[i] >= widths.size())
+          widths.resize (levels[i] + 1, 0);
+        widths[levels[i]] += 1;
+        for (const uint32 o : nodes_[i].outputs)
+          levels[o] = std::max (levels[o], levels[i] + 1);
+      }
+    const uint32 width = widths.empty() ? 0 : *std::max_element (widths.begin(), widths.end());
+    n_wanted_ = std::min (uint32 (threads_.size()), width > 1 ? width - 1 : 0);
+  }
+  // Render all nodes, the calling thread participates and returns once the block is complete.
+  void
+  render ()
+  {
+    return_unless (n_nodes_ > 0);
+    {
+      // workers still leaving the previous block hold n_active_ > 0, but cannot enter under mutex_
+      std::lock_guard<std::mutex> locker (mutex_);
+      while (n_active_.load (std::memory_order_acquire) > 0)
+        BSE_CPU_RELAX();
+      for (uint32 i = 0; i < n_nodes_; i++)
+        {
+          nodes_[i].pending.store (nodes_[i].n_inputs, std::memory_order_relaxed);
+          ready_[i].store (NONE, std::memory_order_relaxed);
+        }
+      ready_head_.store (0, std::memory_order_relaxed);
+      ready_tail_.store (0, std::memory_order_relaxed);
+      n_done_.store (0, std::memory_order_relaxed);
+      for (const uint32 idx : roots_)
+        push_ready (idx);
+      generation_ += 1;
+    }
+    if (n_wanted_)
+      cond_.notify_all();
+    process_nodes();
+    while (n_done_.load (std::memory_order_acquire) < n_nodes_)
+      BSE_CPU_RELAX();
+  }
+};
+
 // == Engine ==
-Engine::Engine (uint32 samplerate, AudioTiming &atiming, std::function<void()> wakeup) :
+// Book keeping for Processors with pending dependencies during Engine::enqueue().
+struct Engine::ScheduleFrame {
+  Processor                     *proc = nullptr;
+  ScheduleFrame                 *parent = nullptr;
+  std::vector<Processor*>        inputs;        // bus and event dependencies of proc
+  Processor                     *last_child = nullptr;
+  bool                           children = false;
+};
+
+Engine::Engine (uint32 samplerate, uint32 maxblocksize, AudioTiming &atiming, std::function<void()> wakeup) :
   nyquist_ (samplerate * 0.5), inyquist_ (1.0 / nyquist_), sample_rate_ (samplerate),
-  frame_counter_ (MAX_RENDER_BLOCK_SIZE), eflags_ (0), scheduler_depth_ (0),
+  max_block_size_ (maxblocksize), block_size_ (maxblocksize),
+  frame_counter_ (maxblocksize), eflags_ (0), scheduler_depth_ (0),
   wakeup_ (wakeup), timing { atiming }
 {
   assert_return (samplerate > 0);
+  assert_return (maxblocksize >= 16 && maxblocksize <= MAX_RENDER_BLOCK_SIZE);
+  assert_return (0 == (maxblocksize & 15)); // multiple of 16 keeps FloatBuffer blocks cache-line aligned
   assert_return (nyquist_ > 0 && nyquist_ == (samplerate >> 1));
   assert_return (0 == (samplerate & 3));
   schedule_.reserve (256);
@@ -371,6 +610,31 @@ Engine::Engine (uint32 samplerate, AudioTiming &atiming, std::function<void()> w
   assert_return (wakeup_ != nullptr);
 }
 
+Engine::~Engine()
+{
+  delete render_pool_;
+  render_pool_ = nullptr;
+}
+
+/// Use `n_threads` worker threads in addition to the calling thread in render_block().
+/// Processors are rendered concurrently if their inputs do not depend on each other.
+void
+Engine::set_render_threads (uint n_threads)
+{
+  return_unless (n_threads != render_threads());
+  std::lock_guard<std::mutex> locker (mutex_);
+  delete render_pool_;
+  render_pool_ = n_threads ? new RenderPool (n_threads) : nullptr;
+  eflags_ |= RESCHEDULE;
+}
+
+/// Number of worker threads used for concurrent rendering, 0 means serial rendering.
+uint
+Engine::render_threads () const
+{
+  return render_pool_ ? render_pool_->n_threads() : 0;
+}
+
 void
 Engine::add_root (ProcessorP rootproc)
 {
@@ -380,7 +644,8 @@ Engine::add_root (ProcessorP rootproc)
   bool was_root = pos != roots_.end();
   assert_return (!was_root);
   roots_.push_back (rootproc);
-  reschedule();
+  added_roots_.push_back (rootproc);
+  eflags_ |= EXTEND;
 }
 
 bool
@@ -400,32 +665,59 @@ Engine::reschedule()
   eflags_ |= RESCHEDULE;
 }
 
+// Cause a re-schedule if `proc` is part of the current schedule, other Processors do not affect it.
+void
+Engine::reschedule (Processor &proc)
+{
+  if (in_schedule (proc))
+    reschedule();
+}
+
+/// Check if `proc` is rendered by the current schedule, this function is MT-Safe.
 bool
 Engine::in_schedule (Processor &proc)
 {
-  // TODO: this can be optimized via unsorted_set when profiled
-  for (auto procp : schedule_)
-    if (procp == &proc)
-      return true;
-  return false;
+  return proc.schedule_stamp_ == schedule_stamp_;
 }
 
 void
 Engine::make_schedule ()
 {
   assert_return (scheduler_depth_ == 0);
-  return_unless (eflags_ & RESCHEDULE);
+  return_unless (eflags_ & (RESCHEDULE | EXTEND));
   std::lock_guard<std::mutex> locker (mutex_);
-  if (0 == (eflags_ & RESCHEDULE))
+  const uint32 flags = eflags_.fetch_and (~uint32 (RESCHEDULE | EXTEND));
+  size_t first = 0;
+  if (flags & RESCHEDULE)
+    {
+      schedule_stamp_ += 1; // invalidates in_schedule() for all Processors
+      schedule_.clear();
+      schedule_edges_.clear();
+      added_roots_.clear();
+      scheduler_depth_ += 1;
+      for (auto root : roots_)
+        enqueue (*root);
+      scheduler_depth_ -= 1;
+    }
+  else if (flags & EXTEND)
+    {
+      // new roots are no dependencies of the current schedule, so appending them keeps it ordered
+      first = schedule_.size();
+      scheduler_depth_ += 1;
+      for (auto root : added_roots_)
+        enqueue (*root);
+      scheduler_depth_ -= 1;
+      added_roots_.clear();
+    }
+  else
     return;
-  eflags_ &= ~uint (RESCHEDULE);
-  schedule_.clear();
-  scheduler_depth_ += 1;
-  for (auto root : roots_)
-    enqueue (*root);
-  scheduler_depth_ -= 1;
-  for (auto proc : schedule_)
-    proc->reset_state();
+  for (size_t i = first; i < schedule_.size(); i++)
+    {
+      schedule_[i]->negotiate_event_capacity();
+      schedule_[i]->reset_state();
+    }
+  if (render_pool_)
+    render_pool_->assign (schedule_, schedule_edges_);
 }
 
 void
@@ -433,29 +725,57 @@ Engine::enqueue (Processor &proc)
 {
   assert_return (this == &proc.engine_);
   assert_return (scheduler_depth_ > 0 && scheduler_depth_ <= 999);
-  scheduler_depth_ += 1;
-  proc.enqueue_deps();
-  scheduler_depth_ -= 1;
-  if (!in_schedule (proc))
-    schedule_.push_back (&proc);
+  ScheduleFrame *const pframe = schedule_frame_;
+  if (!in_schedule (proc)) // scheduled Processors already had their dependencies enqueued
+    {
+      ScheduleFrame frame;
+      frame.proc = &proc;
+      frame.parent = pframe;
+      schedule_frame_ = &frame;
+      scheduler_depth_ += 1;
+      proc.enqueue_deps();
+      scheduler_depth_ -= 1;
+      schedule_frame_ = pframe;
+      proc.schedule_stamp_ = schedule_stamp_.load();
+      schedule_.push_back (&proc);
+    }
+  // record dependencies for concurrent rendering
+  return_unless (pframe != nullptr);
+  schedule_edges_.push_back ({ &proc, pframe->proc });
+  if (!pframe->children)
+    pframe->inputs.push_back (&proc);
+  else // children render in sequence, after the inputs of their container
+    {
+      for (auto dep : pframe->inputs)
+        schedule_edges_.push_back ({ dep, &proc });
+      if (pframe->last_child)
+        schedule_edges_.push_back ({ pframe->last_child, &proc });
+      pframe->last_child = &proc;
+    }
 }
 
-/// Render a block of MAX_RENDER_BLOCK_SIZE in all Processors connected to this Engine.
+// Let `proc` enqueue its children, called from Processor::enqueue_deps() after all inputs.
 void
-Engine::render_block()
+Engine::enqueue_children (Processor &proc)
+{
+  if (schedule_frame_ && schedule_frame_->proc == &proc)
+    schedule_frame_->children = true;
+  proc.enqueue_children();
+}
+
+/// Render a block of `n_frames <= max_block_size()` in all Processors connected to this Engine.
+void
+Engine::render_block (uint n_frames)
 {
   assert_return (!(eflags_ & RESCHEDULE));
-  frame_counter_ += MAX_RENDER_BLOCK_SIZE;
-  for (auto procp : schedule_)
-    procp->render_block();
-  /* TODO: concurrent rendering:
-     - rework schedule_ into a dependency tree, each node reflects a processor and its dependencies
-     - a worker starts on a node, processes dependencies in depth first fashion
-     - per level, 1: process all dependencies that are not yet done and not processing (needs atomic flag)
-     - per level, 2: wait for all nodes (in turn) that are not yet done
-     - per level, 3: process node itself, return
-     - experiment: *also* maintain linear schedule_, have unused workers race over schedule_ concurrently
-   */
+  assert_return (n_frames > 0 && n_frames <= max_block_size_);
+  block_size_ = n_frames;
+  frame_counter_ += n_frames;
+  if (render_pool_)
+    render_pool_->render();
+  else
+    for (auto procp : schedule_)
+      procp->render_block();
 }
 
 bool
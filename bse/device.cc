@@ -3,6 +3,7 @@
 #include "processor.hh"
 #include "property.hh"
 #include "bseserver.hh"
+#include "bseengine.hh"
 #include "internal.hh"
 
 namespace Bse {
@@ -176,7 +177,43 @@ DeviceImpl::DeviceImpl (const String &uuiduri) :
 {}
 
 DeviceImpl::~DeviceImpl ()
-{}
+{
+  if (telemetry_proc_)
+    {
+      ProcessorP procp = telemetry_proc_;
+      telemetry_proc_ = nullptr;
+      if (BSE_SERVER.engine_active())
+        {
+          BSE_SERVER.commit_job ([procp] () { procp->telemetry (nullptr); });
+          bse_engine_wait_on_trans(); // the engine must be done writing before the block is reused
+        }
+      else
+        procp->telemetry (nullptr);
+      BSE_SERVER.release_shared_block (shm_block_);
+    }
+}
+
+static_assert (offsetof (AudioSignal::ProcessorTelemetry, cpu_load) == ptrdiff_t (DeviceTelemetry::F32_CPU_LOAD));
+static_assert (offsetof (AudioSignal::ProcessorTelemetry, render_nsecs) == ptrdiff_t (DeviceTelemetry::I32_RENDER_NSECS));
+static_assert (sizeof (AudioSignal::ProcessorTelemetry) == ptrdiff_t (DeviceTelemetry::BYTECOUNT));
+
+int64
+DeviceImpl::get_shm_offset (DeviceTelemetry fld)
+{
+  if (!telemetry_proc_)
+    {
+      ProcessorP procp = processor();
+      assert_return (procp, -1);
+      shm_block_ = BSE_SERVER.allocate_shared_block (ptrdiff_t (DeviceTelemetry::BYTECOUNT));
+      telemetry_proc_ = procp;
+      auto ptelemetry = new (shm_block_.mem_start) AudioSignal::ProcessorTelemetry();
+      if (BSE_SERVER.engine_active())
+        BSE_SERVER.commit_job ([procp, ptelemetry] () { procp->telemetry (ptelemetry); });
+      else
+        procp->telemetry (ptelemetry);
+    }
+  return shm_block_.mem_offset + ptrdiff_t (fld);
+}
 
 void
 DeviceImpl::xml_serialize (SerializationNode &xs)
@@ -12,6 +12,8 @@ namespace Bse {
 class DeviceImpl : public ObjectImpl, public virtual DeviceIface {
   const String device_uri_;
   std::vector<ModuleImplP> modules_;
+  SharedBlock              shm_block_;
+  AudioSignal::ProcessorP  telemetry_proc_;
 protected:
   using ParamInfoP = AudioSignal::ParamInfoP;
   using Processor = AudioSignal::Processor;
@@ -32,6 +34,7 @@ public:
   virtual StringSeq      list_properties   () override;
   virtual PropertyIfaceP access_property   (const std::string &ident) override;
   virtual PropertySeq    access_properties (const std::string &hints) override;
+  virtual int64          get_shm_offset    (DeviceTelemetry fld) override;
   virtual ProcessorP     processor         () = 0;
   ParamInfoP             param_info        (const std::string &ident);
   virtual const ParamInfoPVec& list_params () const = 0;
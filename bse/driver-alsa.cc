@@ -1225,7 +1225,6 @@ public:
     const auto mkid = [] (uint note, uint channel) {
       return (channel + 1) * 128 + note;
     };
-    bool must_sort = false;
     const auto add = [&] (AudioSignal::EventStream &estream, const Event &event) {
       const double t = ev->time.time.tv_sec + 1e-9 * ev->time.time.tv_nsec;
       const double diff = t - now;
@@ -1235,8 +1234,8 @@ public:
           const auto last_frame = estream.last_frame();
           frames = std::max (frames, last_frame);
         }
-      int8_t frame_delay = CLAMP (frames, -128, 0);     // ignore future scheduling, only account for delays
-      must_sort |= estream.append_unsorted (frame_delay, event);
+      int16_t frame_delay = CLAMP (frames, -128, 0);     // ignore future scheduling, only account for delays
+      estream.append (frame_delay, event);              // sorts out-of-order events
     };
     int r;
     while (r = snd_seq_event_input (seq_, &ev), r >= 0)
@@ -1300,8 +1299,6 @@ public:
     if (BSE_UNLIKELY (mdebug_))
       for (size_t i = old_size; i < estream.size(); i++)
         MDEBUG ("%s", (estream.begin() + i)->to_string());
-    if (must_sort)              // guard against devices with out-of-order events
-      estream.ensure_order();
     return estream.size() - old_size;
   }
 };
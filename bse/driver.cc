@@ -211,8 +211,9 @@ class NullPcmDriver : public PcmDriver {
   uint          block_size_ = 0;
   uint          busy_us_ = 0;
   uint          sleep_us_ = 0;
+  const bool    offline_ = false;
 public:
-  explicit      NullPcmDriver (const String &devid) : PcmDriver (devid) {}
+  explicit      NullPcmDriver (const String &devid) : PcmDriver (devid), offline_ (devid == "offline") {}
   static PcmDriverP
   create (const String &devid)
   {
@@ -261,7 +262,14 @@ public:
     Sequencer::instance().wakeup();
     *timeoutp = 1;
     // ensure sequencer fairness
-    return !Sequencer::instance().thread_lagging (2);
+    const bool ready = !Sequencer::instance().thread_lagging (2);
+    if (offline_ && !ready)
+      {
+        // offline rendering never sleeps, hand the CPU to the sequencer and poll again
+        *timeoutp = 0;
+        std::this_thread::yield();
+      }
+    return ready;
   }
   virtual void
   pcm_latency (uint *rlatency, uint *wlatency) const override
@@ -299,6 +307,12 @@ public:
     entry.writeonly = false;
     entry.priority = Driver::PNULL;
     entries.push_back (entry);
+    entry.devid = "offline"; // "null=offline"
+    entry.device_name = "Null PCM Driver (offline)";
+    entry.device_info = _("Render as fast as possible, discard all PCM output and provide zeros as PCM input");
+    entry.notice = "Warning: The offline Null driver is meant for non-interactive rendering";
+    entry.priority = Driver::PNULL + 1;
+    entries.push_back (entry);
   }
 };
 
@@ -48,6 +48,7 @@ guint            gsl_progress_printerr  (gpointer          message,
 /* --- implementation details --- */
 void	_gsl_init_fd_pool		(void);
 void	_gsl_init_data_caches		(void);
+void	_gsl_shutdown_data_caches	(void);
 void	_gsl_init_loader_gslwave	(void);
 void	_gsl_init_loader_aiff		(void);
 void	_gsl_init_loader_wav		(void);
@@ -6,10 +6,17 @@
 #include "bse/internal.hh"
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <unistd.h>
 #include <string.h>
 #include <errno.h>
 #include <time.h>
+#include <algorithm>
+#include <deque>
+#include <filesystem>
+#include <list>
+#include <thread>
+#include <unordered_map>
 
 
 /* --- macros --- */
@@ -36,6 +43,17 @@
  * block read has been completed. using one global condition
  * is considered sufficient until shown otherwise by further
  * profiling/debugging measures.
+ * sequential node requests are detected per dcache, in which case
+ * the following nodes are queued for read-ahead by a small pool of
+ * I/O threads, the readahead lock is only acquired after dcache locks.
+ * the memory of unused nodes is accounted globally, once it exceeds the
+ * budget, an I/O thread evicts unused nodes across all dcaches in LRU
+ * order, nodes of high persistency dcaches (slow to refill) go last. only
+ * one thread evicts at a time, guarded by the evict lock which is
+ * acquired before any other lock.
+ * nodes decoded from data handles with a content id are also stored
+ * in the decoded PCM tier, which is shared by all dcaches and only
+ * locked while no dcache lock is held.
  */
 /* --- prototypes --- */
 static void			dcache_free		(GslDataCache	*dcache);
@@ -43,6 +61,8 @@ static GslDataCacheNode*	data_cache_new_node_L	(GslDataCache	*dcache,
 							 int64		 offset,
 							 guint		 pos,
 							 gboolean	 demand_load);
+static void			dcache_io_thread	(uint		 nth);
+static void			dcache_enforce_budget	(void);
 
 /* --- variables --- */
 static Bse::Spinlock           global_dcache_spinlock;
@@ -50,6 +70,198 @@ static std::condition_variable global_dcache_cond_node_filled;
 static SfiRing	              *global_dcache_list = NULL;
 static guint                   global_dcache_count = 0;
 static guint                   global_dcache_n_aged_nodes = 0;
+static std::atomic<uint64>     global_dcache_unused_memory { 0 }; /* bytes allocated for unreferenced nodes */
+static std::atomic<uint64>     global_dcache_budget { BSE_DCACHE_CACHE_MEMORY };
+static std::atomic<uint64>     global_dcache_clock { 0 };      /* LRU stamps for unused nodes */
+static std::mutex              global_dcache_evict_mutex;
+struct ReadaheadRequest {
+  GslDataCache *dcache;
+  int64         offset;
+};
+static std::mutex                   readahead_mutex;
+static std::condition_variable      readahead_cond;
+static std::deque<ReadaheadRequest> readahead_queue;
+static std::atomic<bool>            readahead_evict_pending { false };
+static bool                         readahead_quit = false;
+static std::vector<std::thread>     readahead_threads;
+
+/* --- decoded PCM tier --- */
+namespace {
+/* decoded node blocks of compressed data handles, keyed by content id, node offset and size.
+ * evicted nodes and other handles of the same file are restored from here without
+ * decoding, blocks beyond the memory budget are spilled to an unlinked scratch file.
+ */
+class PcmTier {
+  static constexpr size_t SEGMENT_BLOCKS = 256;         /* scratch file blocks per mapping */
+  struct Key {
+    guint64 content_id;
+    int64   offset;
+    size_t  n_values;           /* node size plus padding, depends on the dcache */
+    bool operator== (const Key &other) const { return content_id == other.content_id && offset == other.offset && n_values == other.n_values; }
+  };
+  struct KeyHash {
+    size_t operator() (const Key &key) const { return key.content_id ^ (uint64 (key.offset) * 0x9e3779b97f4a7c15ULL) ^ key.n_values; }
+  };
+  struct Block {
+    float                    *memory = nullptr;     /* in memory copy or NULL if spilled */
+    int64                     slot = -1;            /* scratch file slot if spilled */
+    uint64                    stamp = 0;            /* LRU */
+    std::list<Key>::iterator  lru;                  /* position in resident_lru_ or spilled_lru_ */
+  };
+  std::mutex                                mutex_;
+  std::unordered_map<Key, Block, KeyHash>   blocks_;
+  std::list<Key>                            resident_lru_, spilled_lru_;   /* least recently used first */
+  size_t                                    slot_values_ = 0;      /* block size of the scratch file */
+  uint64                                    clock_ = 0;
+  uint64                                    memory_ = 0, memory_budget_ = BSE_DCACHE_PCM_MEMORY;
+  uint64                                    scratch_budget_ = BSE_DCACHE_PCM_SCRATCH;
+  int                                       scratch_fd_ = -1;
+  bool                                      scratch_failed_ = false;
+  std::vector<float*>                       segments_;
+  std::vector<int64>                        free_slots_;
+  float*
+  slot_data (int64 slot) const
+  {
+    return segments_[slot / SEGMENT_BLOCKS] + (slot % SEGMENT_BLOCKS) * slot_values_;
+  }
+  int64
+  alloc_slot_L ()
+  {
+    if (!free_slots_.empty())
+      {
+        const int64 slot = free_slots_.back();
+        free_slots_.pop_back();
+        return slot;
+      }
+    const size_t segment_bytes = SEGMENT_BLOCKS * slot_values_ * sizeof (float);
+    if (scratch_failed_ || (segments_.size() + 1) * segment_bytes > scratch_budget_)
+      return -1;
+    if (scratch_fd_ < 0)
+      {
+        std::error_code ec;
+        std::string tmpname = std::filesystem::temp_directory_path (ec).string() + "/beastbse-pcm-XXXXXX";
+        scratch_fd_ = ec ? -1 : mkstemp (&tmpname[0]);
+        if (scratch_fd_ >= 0)
+          unlink (tmpname.c_str());     /* space is reclaimed once closed */
+      }
+    void *mem = MAP_FAILED;
+    if (scratch_fd_ >= 0 && ftruncate (scratch_fd_, (segments_.size() + 1) * segment_bytes) == 0)
+      mem = mmap (NULL, segment_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, scratch_fd_, segments_.size() * segment_bytes);
+    if (mem == MAP_FAILED)
+      {
+        Bse::info ("DataCache: failed to extend PCM scratch file: %s", strerror (errno));
+        scratch_failed_ = true;
+        return -1;
+      }
+    const int64 first = segments_.size() * SEGMENT_BLOCKS;
+    segments_.push_back ((float*) mem);
+    for (int64 slot = first + SEGMENT_BLOCKS - 1; slot > first; slot--)
+      free_slots_.push_back (slot);
+    return first;
+  }
+  /* mark block as most recently used */
+  void
+  touch_L (Block &block)
+  {
+    std::list<Key> &lru = block.memory ? resident_lru_ : spilled_lru_;
+    lru.splice (lru.end(), lru, block.lru);
+    block.stamp = ++clock_;
+  }
+  /* spill least recently used blocks until memory is below budget, O(1) per block */
+  void
+  shrink_L ()
+  {
+    const uint64 target = memory_budget_ - (memory_budget_ >> 4);
+    while (memory_ > target && !resident_lru_.empty())
+      {
+        const Key key = resident_lru_.front();
+        Block &block = blocks_.find (key)->second;
+        if (!slot_values_)
+          slot_values_ = key.n_values;  /* the scratch file uses the size of the first spilled block */
+        int64 slot = -1;
+        if (key.n_values == slot_values_)
+          {
+            slot = alloc_slot_L();
+            if (slot < 0 && !spilled_lru_.empty())
+              {
+                /* scratch file is full, reuse the slot of an older spilled block */
+                auto victim = blocks_.find (spilled_lru_.front());
+                if (victim->second.stamp < block.stamp)
+                  {
+                    slot = victim->second.slot;
+                    spilled_lru_.pop_front();
+                    blocks_.erase (victim);
+                  }
+              }
+          }
+        if (slot >= 0)
+          memcpy (slot_data (slot), block.memory, key.n_values * sizeof (float));
+        delete[] block.memory;
+        memory_ -= key.n_values * sizeof (float);
+        resident_lru_.pop_front();
+        if (slot >= 0)
+          {
+            block.memory = nullptr;
+            block.slot = slot;
+            block.lru = spilled_lru_.insert (spilled_lru_.end(), key);
+          }
+        else
+          blocks_.erase (key);
+      }
+  }
+public:
+  bool
+  lookup (guint64 content_id, int64 offset, float *data, size_t n_values)
+  {
+    std::lock_guard<std::mutex> locker (mutex_);
+    auto it = blocks_.find ({ content_id, offset, n_values });
+    if (it == blocks_.end())
+      return false;
+    Block &block = it->second;
+    memcpy (data, block.memory ? block.memory : slot_data (block.slot), n_values * sizeof (float));
+    touch_L (block);
+    return true;
+  }
+  void
+  insert (guint64 content_id, int64 offset, const float *data, size_t n_values)
+  {
+    std::lock_guard<std::mutex> locker (mutex_);
+    const Key key { content_id, offset, n_values };
+    auto it = blocks_.find (key);
+    if (it != blocks_.end())
+      {
+        touch_L (it->second);
+        return;
+      }
+    Block &block = blocks_[key];
+    block.memory = new float[n_values];
+    memcpy (block.memory, data, n_values * sizeof (float));
+    block.stamp = ++clock_;
+    block.lru = resident_lru_.insert (resident_lru_.end(), key);
+    memory_ += n_values * sizeof (float);
+    if (memory_ > memory_budget_)
+      shrink_L();
+  }
+  void
+  set_budget (uint64 memory_bytes, uint64 scratch_bytes)
+  {
+    std::lock_guard<std::mutex> locker (mutex_);
+    memory_budget_ = memory_bytes;
+    scratch_budget_ = scratch_bytes;    /* existing scratch mappings are kept */
+    scratch_failed_ = false;
+    if (memory_ > memory_budget_)
+      shrink_L();
+  }
+  void
+  stats (uint64 *memory_bytes, uint64 *scratch_bytes)
+  {
+    std::lock_guard<std::mutex> locker (mutex_);
+    *memory_bytes = memory_;
+    *scratch_bytes = (segments_.size() * SEGMENT_BLOCKS - free_slots_.size()) * slot_values_ * sizeof (float);
+  }
+};
+static PcmTier pcm_tier;
+} // Anon
 
 /* --- functions --- */
 void
@@ -59,6 +271,29 @@ _gsl_init_data_caches (void)
   assert_return (initialized == FALSE);
   initialized++;
   static_assert (AGE_EPSILON < LOW_PERSISTENCY_RESIDENT_SET, "");
+  global_dcache_budget = Bse::config_int ("dcache-memory", BSE_DCACHE_CACHE_MEMORY);
+  pcm_tier.set_budget (Bse::config_int ("dcache-pcm-memory", BSE_DCACHE_PCM_MEMORY),
+                       Bse::config_int ("dcache-pcm-scratch", BSE_DCACHE_PCM_SCRATCH));
+  for (uint i = 0; i < BSE_DCACHE_IO_THREADS; i++)
+    readahead_threads.push_back (std::thread (dcache_io_thread, 1 + i));
+}
+/* stop and join the I/O threads, pending read-ahead requests are dropped */
+void
+_gsl_shutdown_data_caches (void)
+{
+  std::unique_lock<std::mutex> readahead_lock (readahead_mutex);
+  readahead_quit = true;
+  readahead_cond.notify_all();
+  readahead_lock.unlock();
+  for (std::thread &thread : readahead_threads)
+    thread.join();
+  readahead_threads.clear();
+  readahead_lock.lock();
+  std::deque<ReadaheadRequest> requests;
+  requests.swap (readahead_queue);
+  readahead_lock.unlock();
+  for (const ReadaheadRequest &request : requests)
+    gsl_data_cache_unref (request.dcache);
 }
 GslDataCache*
 gsl_data_cache_new (GslDataHandle *dhandle,
@@ -84,6 +319,10 @@ gsl_data_cache_new (GslDataHandle *dhandle,
   dcache->high_persistency = FALSE;
   dcache->n_nodes = 0;
   dcache->nodes = g_renew (GslDataCacheNode*, NULL, UPPER_POWER2 (dcache->n_nodes));
+  dcache->seq_offset = -1;
+  dcache->readahead_end = 0;
+  dcache->n_sequential = 0;
+  dcache->stats = GslDataCacheStats {};
   global_dcache_spinlock.lock();
   global_dcache_list = sfi_ring_append (global_dcache_list, dcache);
   global_dcache_count++;
@@ -146,6 +385,21 @@ gsl_data_cache_ref (GslDataCache *dcache)
   dcache->mutex.unlock();
   return dcache;
 }
+static inline uint64
+data_cache_node_bytes (const GslDataCache *dcache)
+{
+  return (dcache->node_size + (dcache->padding << 1)) * sizeof (GslDataType);
+}
+static inline void
+data_cache_free_node_L (GslDataCache     *dcache,
+                        GslDataCacheNode *node)
+{
+  const guint size = dcache->node_size + (dcache->padding << 1);
+  if (!node->ref_count)
+    global_dcache_unused_memory -= size * sizeof (GslDataType);
+  sfi_delete_structs (GslDataType, size, node->data - dcache->padding);
+  sfi_delete_struct (GslDataCacheNode, node);
+}
 static void
 dcache_free (GslDataCache *dcache)
 {
@@ -154,13 +408,7 @@ dcache_free (GslDataCache *dcache)
   assert_return (dcache->open_count == 0);
   gsl_data_handle_unref (dcache->dhandle);
   for (i = 0; i < dcache->n_nodes; i++)
-    {
-      GslDataCacheNode *node = dcache->nodes[i];
-      guint size;
-      size = dcache->node_size + (dcache->padding << 1);
-      sfi_delete_structs (GslDataType, size, node->data - dcache->padding);
-      sfi_delete_struct (GslDataCacheNode, node);
-    }
+    data_cache_free_node_L (dcache, dcache->nodes[i]);
   g_free (dcache->nodes);
   dcache->mutex.~mutex();
   sfi_delete_struct (GslDataCache, dcache);
@@ -241,6 +489,27 @@ data_cache_lookup_nextmost_node_L (GslDataCache *dcache,
   return NULL;
 }
 
+/* find node containing offset or the position to insert it at */
+static inline GslDataCacheNode*
+data_cache_find_node_L (GslDataCache *dcache,
+                        int64         offset,
+                        guint        *insertion_pos)
+{
+  GslDataCacheNode **node_p = data_cache_lookup_nextmost_node_L (dcache, offset);
+  if (!node_p)
+    {
+      *insertion_pos = 0;                               /* insert at start */
+      return NULL;
+    }
+  GslDataCacheNode *node = *node_p;
+  if (offset >= node->offset && offset < node->offset + dcache->node_size)
+    return node;                                        /* exact match */
+  *insertion_pos = NODEP_INDEX (dcache, node_p);        /* insert before neighbour */
+  if (offset > node->offset)                            /* insert after neighbour */
+    *insertion_pos += 1;
+  return NULL;
+}
+
 static inline GslDataCacheNode*
 data_cache_new_node_L (GslDataCache *dcache,
 		       int64	     offset,
@@ -252,7 +521,7 @@ data_cache_new_node_L (GslDataCache *dcache,
   guint new_node_array_size, old_node_array_size = UPPER_POWER2 (dcache->n_nodes);
   int64 dhandle_length;
   guint i, size;
-  gint result;
+  gint result = 0;
 
   i = dcache->n_nodes++;
   new_node_array_size = UPPER_POWER2 (dcache->n_nodes);
@@ -265,8 +534,8 @@ data_cache_new_node_L (GslDataCache *dcache,
   dnode->offset = offset & ~(dcache->node_size - 1);
   dnode->ref_count = 1;
   dnode->age = 0;
+  dnode->stamp = 0;
   dnode->data = NULL;
-  dcache->mutex.unlock();
   size = dcache->node_size + (dcache->padding << 1);
   data = sfi_new_struct (GslDataType, size);
   node_data = data + dcache->padding;
@@ -285,9 +554,9 @@ data_cache_new_node_L (GslDataCache *dcache,
   if (!demand_load)
     g_message (G_STRLOC ":FIXME: lazy data loading not yet supported");
 
-  /* copy over data from previous node */
+  /* copy over data from previous node, unless it is still being read */
   GslDataCacheNode *prev_node = pos ? dcache->nodes[pos - 1] : NULL;
-  if (prev_node)
+  if (prev_node && prev_node->data)
     {
       int64 prev_node_size = dcache->node_size;
       int64 prev_node_offset = prev_node->offset;
@@ -309,7 +578,18 @@ data_cache_new_node_L (GslDataCache *dcache,
         }
     }
 
-  /* fill from data handle */
+  /* fill from data handle, unlocked, the previous node may be evicted meanwhile */
+  dcache->mutex.unlock();
+  const guint64 content_id = dcache->dhandle->content_id;
+  const guint block_size = dcache->node_size + (dcache->padding << 1);
+  if (content_id && pcm_tier.lookup (content_id, dnode->offset, node_data - dcache->padding, block_size))
+    {
+      dcache->mutex.lock();
+      dcache->stats.n_pcm_hits++;
+      dnode->data = node_data;
+      global_dcache_cond_node_filled.notify_all();
+      return dnode;
+    }
   dhandle_length = gsl_data_handle_length (dcache->dhandle);
   do
     {
@@ -331,73 +611,162 @@ data_cache_new_node_L (GslDataCache *dcache,
     }
   while (size && result > 0);
   memset (data, 0, size * sizeof (data[0]));
+  if (content_id && result >= 0)
+    pcm_tier.insert (content_id, dnode->offset, node_data - dcache->padding, block_size);
   dcache->mutex.lock();
   dnode->data = node_data;
   global_dcache_cond_node_filled.notify_all();
   return dnode;
 }
+/* detect sequential node requests and queue the following nodes for read-ahead */
+static void
+data_cache_readahead_L (GslDataCache *dcache,
+                        int64         offset)
+{
+  const int64 node_size = dcache->node_size;
+  const int64 node_offset = offset & ~(node_size - 1);
+  if (node_offset == dcache->seq_offset)
+    return;
+  if (node_offset == dcache->seq_offset + node_size)
+    dcache->n_sequential++;
+  else
+    {
+      dcache->n_sequential = 0;
+      dcache->readahead_end = 0;
+    }
+  dcache->seq_offset = node_offset;
+  /* decoding is expensive, so compressed handles are read ahead sooner */
+  if (dcache->n_sequential < (dcache->dhandle->content_id ? 1 : 2))
+    return;
+  const int64 end = MIN (node_offset + (1 + BSE_DCACHE_READAHEAD_NODES) * node_size,
+                         gsl_data_handle_length (dcache->dhandle));
+  int64 next = MAX (node_offset + node_size, dcache->readahead_end);
+  if (next >= end)
+    return;
+  std::lock_guard<std::mutex> readahead_lock (readahead_mutex);
+  if (readahead_quit)
+    return;                     /* I/O threads are stopped */
+  for (; next < end; next += node_size)
+    {
+      dcache->ref_count++;      /* released by dcache_io_thread() */
+      readahead_queue.push_back ({ dcache, next });
+    }
+  dcache->readahead_end = next;
+  readahead_cond.notify_all();
+}
+
 GslDataCacheNode*
 gsl_data_cache_ref_node (GslDataCache       *dcache,
 			 int64               offset,
 			 GslDataCacheRequest load_request)
 {
-  GslDataCacheNode **node_p, *node;
+  GslDataCacheNode *node;
   guint insertion_pos;
   assert_return (dcache != NULL, NULL);
   assert_return (dcache->ref_count > 0, NULL);
   assert_return (dcache->open_count > 0, NULL);
   assert_return (offset < gsl_data_handle_length (dcache->dhandle), NULL);
   std::unique_lock<std::mutex> dcache_lock (dcache->mutex);
-  node_p = data_cache_lookup_nextmost_node_L (dcache, offset);
-  if (node_p)
+  if (load_request != GSL_DATA_CACHE_PEEK)
+    data_cache_readahead_L (dcache, offset);
+  node = data_cache_find_node_L (dcache, offset, &insertion_pos);
+  if (node)
     {
-      node = *node_p;
-      if (offset >= node->offset && offset < node->offset + dcache->node_size)
-	{
-	  gboolean rejuvenate_node = !node->ref_count;
+      gboolean rejuvenate_node = !node->ref_count;
 
-	  if (load_request == GSL_DATA_CACHE_PEEK)
-	    {
-	      if (node->data)
-		node->ref_count++;
-	      else
-		node = NULL;
-	      dcache_lock.unlock();
-	      if (node && rejuvenate_node)
-		{
-		  global_dcache_spinlock.lock(); /* different lock */
-		  global_dcache_n_aged_nodes--;
-		  global_dcache_spinlock.unlock();
-		}
-	      return node;
-	    }
-	  node->ref_count++;
-	  if (load_request == GSL_DATA_CACHE_DEMAND_LOAD)
-	    while (!node->data)
-	      global_dcache_cond_node_filled.wait (dcache_lock);
-	  dcache_lock.unlock();
-	  /* printerr ("hit: %d :%d: %d\n", node->offset, offset, node->offset + dcache->node_size); */
-	  if (rejuvenate_node)
-	    {
-	      global_dcache_spinlock.lock(); /* different lock */
-	      global_dcache_n_aged_nodes--;
-	      global_dcache_spinlock.unlock();
-	    }
-	  return node;					/* exact match */
-	}
-      insertion_pos = NODEP_INDEX (dcache, node_p);	/* insert before neighbour */
-      if (offset > node->offset)			/* insert after neighbour */
-	insertion_pos += 1;
-      /* printerr ("mis: %d :%d: %d\n", node->offset, offset, node->offset + dcache->node_size); */
+      if (load_request == GSL_DATA_CACHE_PEEK)
+        {
+          if (node->data)
+            node->ref_count++;
+          else
+            node = NULL;
+          if (node && rejuvenate_node)
+            global_dcache_unused_memory -= data_cache_node_bytes (dcache);
+          dcache_lock.unlock();
+          if (node && rejuvenate_node)
+            {
+              global_dcache_spinlock.lock(); /* different lock */
+              global_dcache_n_aged_nodes--;
+              global_dcache_spinlock.unlock();
+            }
+          return node;
+        }
+      node->ref_count++;
+      if (rejuvenate_node)
+        global_dcache_unused_memory -= data_cache_node_bytes (dcache);
+      if (node->data)
+        dcache->stats.n_hits++;
+      else if (load_request == GSL_DATA_CACHE_DEMAND_LOAD)
+        {
+          dcache->stats.n_stalls++;
+          while (!node->data)
+            global_dcache_cond_node_filled.wait (dcache_lock);
+        }
+      dcache_lock.unlock();
+      if (rejuvenate_node)
+        {
+          global_dcache_spinlock.lock(); /* different lock */
+          global_dcache_n_aged_nodes--;
+          global_dcache_spinlock.unlock();
+        }
+      return node;                                      /* exact match */
     }
-  else
-    insertion_pos = 0;	/* insert at start */
   if (load_request != GSL_DATA_CACHE_PEEK)
-    node = data_cache_new_node_L (dcache, offset, insertion_pos, load_request == GSL_DATA_CACHE_DEMAND_LOAD);
+    {
+      dcache->stats.n_misses++;
+      node = data_cache_new_node_L (dcache, offset, insertion_pos, load_request == GSL_DATA_CACHE_DEMAND_LOAD);
+    }
   else
     node = NULL;
   return node;
 }
+
+/* read a single node ahead of time, unless present already or the dcache got closed */
+static void
+dcache_readahead_node (GslDataCache *dcache,
+                       int64         offset)
+{
+  std::unique_lock<std::mutex> dcache_lock (dcache->mutex);
+  if (!dcache->open_count)
+    return;
+  guint insertion_pos;
+  if (data_cache_find_node_L (dcache, offset, &insertion_pos))
+    return;
+  dcache->open_count++;         /* keep dhandle opened while reading */
+  GslDataCacheNode *node = data_cache_new_node_L (dcache, offset, insertion_pos, TRUE);
+  dcache->stats.n_prefetched++;
+  dcache_lock.unlock();
+  gsl_data_cache_unref_node (dcache, node);
+  gsl_data_cache_close (dcache);
+}
+
+static void
+dcache_io_thread (uint nth)
+{
+  Bse::this_thread_set_name (Bse::string_format ("DCacheIO-%u", nth));
+  std::unique_lock<std::mutex> readahead_lock (readahead_mutex);
+  while (!readahead_quit)
+    {
+      while (readahead_queue.empty() && !readahead_evict_pending && !readahead_quit)
+        readahead_cond.wait (readahead_lock);
+      if (readahead_quit)
+        break;
+      if (readahead_evict_pending.exchange (false))
+        {
+          readahead_lock.unlock();
+          dcache_enforce_budget();
+          readahead_lock.lock();
+          continue;
+        }
+      const ReadaheadRequest request = readahead_queue.front();
+      readahead_queue.pop_front();
+      readahead_lock.unlock();
+      dcache_readahead_node (request.dcache, request.offset);
+      gsl_data_cache_unref (request.dcache);
+      readahead_lock.lock();
+    }
+}
+
 static gboolean /* still locked */
 data_cache_free_olders_Lunlock (GslDataCache *dcache,
 				guint         max_lru)	/* how many lru nodes to keep */
@@ -427,8 +796,7 @@ data_cache_free_olders_Lunlock (GslDataCache *dcache,
 
       if (!node->ref_count && node->age <= rejuvenate)
 	{
-	  sfi_delete_structs (GslDataType, size, node->data - dcache->padding);
-	  sfi_delete_struct (GslDataCacheNode, node);
+	  data_cache_free_node_L (dcache, node);
 	  if (!slot_p)
 	    slot_p = dcache->nodes + i;
 	  n_freed++;
@@ -460,6 +828,75 @@ data_cache_free_olders_Lunlock (GslDataCache *dcache,
                    dcache->n_nodes);
   return FALSE;
 }
+/* evict unused nodes across all dcaches until their memory is below budget */
+static void
+dcache_enforce_budget ()
+{
+  std::unique_lock<std::mutex> evict_lock (global_dcache_evict_mutex, std::try_to_lock);
+  if (!evict_lock.owns_lock())
+    return;                                     /* another thread is evicting already */
+  const uint64 budget = global_dcache_budget;
+  const uint64 target = budget - (budget >> 4); /* free ~6% extra, so sweeps are triggered less often */
+  if (global_dcache_unused_memory <= budget)
+    return;
+  /* hold references on all dcaches, so they can be walked without the global lock */
+  std::vector<GslDataCache*> dcaches;
+  global_dcache_spinlock.lock();
+  dcaches.reserve (global_dcache_count);
+  for (SfiRing *ring = global_dcache_list; ring; ring = sfi_ring_walk (ring, global_dcache_list))
+    dcaches.push_back (gsl_data_cache_ref ((GslDataCache*) ring->data));
+  global_dcache_spinlock.unlock();
+  /* eviction order of unused nodes, low persistency nodes are cheaper to refill and go first */
+  const uint64 HIGH_PERSISTENCY = uint64 (1) << 63;
+  std::vector<std::pair<uint64, uint64>> keys;  /* (eviction key, node bytes) */
+  for (GslDataCache *dcache : dcaches)
+    {
+      std::lock_guard<std::mutex> dcache_lock (dcache->mutex);
+      const uint64 node_bytes = data_cache_node_bytes (dcache);
+      for (guint i = 0; i < dcache->n_nodes; i++)
+        if (!dcache->nodes[i]->ref_count)
+          keys.push_back ({ (dcache->high_persistency ? HIGH_PERSISTENCY : 0) | dcache->nodes[i]->stamp, node_bytes });
+    }
+  std::sort (keys.begin(), keys.end());
+  const uint64 memory = global_dcache_unused_memory;
+  uint64 n_bytes = 0;
+  size_t n_evict = 0;
+  while (n_evict < keys.size() && memory > target + n_bytes)
+    n_bytes += keys[n_evict++].second;
+  guint n_freed = 0;
+  if (n_evict)
+    {
+      const uint64 cutoff = keys[n_evict - 1].first;
+      for (GslDataCache *dcache : dcaches)
+        {
+          std::lock_guard<std::mutex> dcache_lock (dcache->mutex);
+          guint j = 0;
+          for (guint i = 0; i < dcache->n_nodes; i++)
+            {
+              GslDataCacheNode *node = dcache->nodes[i];
+              const uint64 key = (dcache->high_persistency ? HIGH_PERSISTENCY : 0) | node->stamp;
+              if (!node->ref_count && key <= cutoff)
+                {
+                  data_cache_free_node_L (dcache, node);
+                  dcache->stats.n_evicted++;
+                  n_freed++;
+                }
+              else
+                dcache->nodes[j++] = node;
+            }
+          dcache->n_nodes = j;
+        }
+    }
+  if (n_freed)
+    {
+      global_dcache_spinlock.lock();
+      global_dcache_n_aged_nodes -= n_freed;
+      global_dcache_spinlock.unlock();
+    }
+  for (GslDataCache *dcache : dcaches)
+    gsl_data_cache_unref (dcache);
+}
+
 void
 gsl_data_cache_unref_node (GslDataCache     *dcache,
 			   GslDataCacheNode *node)
@@ -474,6 +911,11 @@ gsl_data_cache_unref_node (GslDataCache     *dcache,
   assert_return (node_p && *node_p == node);	/* paranoid check lookup, yeah! */
   node->ref_count -= 1;
   check_cache = !node->ref_count;
+  if (!node->ref_count)
+    {
+      node->stamp = ++global_dcache_clock;
+      global_dcache_unused_memory += data_cache_node_bytes (dcache);
+    }
   if (!node->ref_count &&
       (node->age + AGE_EPSILON <= dcache->max_age ||
        dcache->max_age < AGE_EPSILON))
@@ -481,62 +923,15 @@ gsl_data_cache_unref_node (GslDataCache     *dcache,
   dcache->mutex.unlock();
   if (check_cache)
     {
-      guint node_size = CONFIG_NODE_SIZE ();
-      guint cache_mem = BSE_DCACHE_CACHE_MEMORY;
-      guint current_mem;
       global_dcache_spinlock.lock();
       global_dcache_n_aged_nodes++;
-      current_mem = node_size * global_dcache_n_aged_nodes;
-      if (current_mem > cache_mem)              /* round-robin cache trashing */
-	{
-	  bool needs_unlock;
-	  dcache = (GslDataCache*) sfi_ring_pop_head (&global_dcache_list);
-	  dcache->mutex.lock();
-	  dcache->ref_count++;
-	  global_dcache_list = sfi_ring_append (global_dcache_list, dcache);
-	  // uint dcache_count = global_dcache_count;
-	  global_dcache_spinlock.unlock();
-#define DEBUG_TRASHING 0
-#if DEBUG_TRASHING
-          gint debug_gnaged = global_dcache_n_aged_nodes;
-#endif
-          if (dcache->high_persistency) /* hard/slow to refill */
-            {
-              /* try to free the actual cache overflow from the
-               * dcache we just picked, but don't free more than
-               * 25% of its nodes yet.
-               * overflow is actual overhang + ~6% of cache size,
-               * so cache sweeps are triggered less frequently.
-               */
-              current_mem -= cache_mem;		/* overhang */
-              current_mem += cache_mem >> 4;	/* overflow = overhang + 6% */
-              current_mem /= node_size;		/* n_nodes to free */
-              current_mem = MIN (current_mem, dcache->n_nodes);
-              guint max_lru = dcache->n_nodes;
-              max_lru >>= 1;                    /* keep at least 75% of n_nodes */
-              max_lru += max_lru >> 1;
-              max_lru = MAX (max_lru, dcache->n_nodes - current_mem);
-              needs_unlock = data_cache_free_olders_Lunlock (dcache, MAX (max_lru, LOW_PERSISTENCY_RESIDENT_SET));
-            }
-          else  /* low persistency - easy to refill */
-            {
-              guint max_lru = dcache->n_nodes;
-              max_lru >>= 2;                    /* keep only 25% of n_nodes */
-              needs_unlock = data_cache_free_olders_Lunlock (dcache, MAX (max_lru, LOW_PERSISTENCY_RESIDENT_SET));
-            }
-#if DEBUG_TRASHING
-          if (dcache->dhandle->open_count)
-            Bse::printerr ("shrunk dcache by: dhandle=%p - %s - highp=%d: %d bytes (kept: %d)\n",
-                           dcache->dhandle, gsl_data_handle_name (dcache->dhandle),
-                           dcache->high_persistency,
-                           -(gint) node_size * (debug_gnaged - global_dcache_n_aged_nodes),
-                           node_size * dcache->n_nodes);
-#endif
-	  if (needs_unlock)
-	    dcache->mutex.unlock();
-	}
-      else
-	global_dcache_spinlock.unlock();
+      global_dcache_spinlock.unlock();
+      /* unref_node() is called from the DSP thread, so eviction is left to an I/O thread */
+      if (global_dcache_unused_memory > global_dcache_budget && !readahead_evict_pending.exchange (true))
+        {
+          std::lock_guard<std::mutex> readahead_lock (readahead_mutex);
+          readahead_cond.notify_one();
+        }
     }
 }
 void
@@ -569,3 +964,57 @@ gsl_data_cache_from_dhandle (GslDataHandle *dhandle,
   global_dcache_spinlock.unlock();
   return gsl_data_cache_new (dhandle, min_padding);
 }
+
+/// Retrieve cache statistics of `dcache`, or accumulated over all live caches if `dcache` is NULL.
+GslDataCacheStats
+gsl_data_cache_get_stats (GslDataCache *dcache)
+{
+  GslDataCacheStats stats = {};
+  if (dcache)
+    {
+      std::lock_guard<std::mutex> dcache_lock (dcache->mutex);
+      stats = dcache->stats;
+      stats.n_bytes = dcache->n_nodes * (dcache->node_size + (dcache->padding << 1)) * sizeof (GslDataType);
+      return stats;
+    }
+  global_dcache_spinlock.lock();
+  for (SfiRing *ring = global_dcache_list; ring; ring = sfi_ring_walk (ring, global_dcache_list))
+    {
+      GslDataCache *dc = (GslDataCache*) ring->data;
+      dc->mutex.lock();
+      stats.n_hits += dc->stats.n_hits;
+      stats.n_misses += dc->stats.n_misses;
+      stats.n_stalls += dc->stats.n_stalls;
+      stats.n_prefetched += dc->stats.n_prefetched;
+      stats.n_evicted += dc->stats.n_evicted;
+      stats.n_bytes += dc->n_nodes * (dc->node_size + (dc->padding << 1)) * sizeof (GslDataType);
+      stats.n_pcm_hits += dc->stats.n_pcm_hits;
+      dc->mutex.unlock();
+    }
+  global_dcache_spinlock.unlock();
+  pcm_tier.stats (&stats.n_pcm_memory, &stats.n_pcm_scratch);
+  return stats;
+}
+
+/// Set the maximum number of bytes used by unreferenced GslDataCache nodes, older nodes are evicted beyond.
+void
+gsl_data_cache_set_memory_budget (uint64 n_bytes)
+{
+  global_dcache_budget = n_bytes;
+  if (global_dcache_unused_memory > global_dcache_budget)
+    dcache_enforce_budget();
+}
+
+/// Get the maximum number of bytes used by unreferenced GslDataCache nodes.
+uint64
+gsl_data_cache_get_memory_budget ()
+{
+  return global_dcache_budget;
+}
+
+/// Set the memory and scratch file sizes of the tier that keeps decoded nodes of compressed data handles.
+void
+gsl_data_cache_set_pcm_budget (uint64 memory_bytes, uint64 scratch_bytes)
+{
+  pcm_tier.set_budget (memory_bytes, scratch_bytes);
+}
@@ -11,6 +11,18 @@
 /* --- typedefs & structures --- */
 typedef gfloat                     GslDataType;
 typedef struct _GslDataCacheNode   GslDataCacheNode;
+struct GslDataCacheStats
+{
+  uint64                n_hits;                 /* requests served from loaded nodes */
+  uint64                n_misses;               /* requests that had to read a new node */
+  uint64                n_stalls;               /* requests that waited for a node being read ahead */
+  uint64                n_prefetched;           /* nodes read ahead by the I/O threads */
+  uint64                n_evicted;              /* nodes evicted to stay within the memory budget */
+  uint64                n_bytes;                /* memory currently allocated for nodes */
+  uint64                n_pcm_hits;             /* nodes restored from the decoded PCM tier */
+  uint64                n_pcm_memory;           /* PCM tier bytes held in memory, global stats only */
+  uint64                n_pcm_scratch;          /* PCM tier bytes spilled to the scratch file, global stats only */
+};
 struct _GslDataCache
 {
   GslDataHandle	       *dhandle;
@@ -23,12 +35,17 @@ struct _GslDataCache
   gboolean		high_persistency;       /* valid for opened caches only */
   guint			n_nodes;
   GslDataCacheNode    **nodes;
+  int64                 seq_offset;             /* last requested node offset */
+  int64                 readahead_end;          /* end of nodes queued for read-ahead */
+  guint                 n_sequential;           /* number of consecutive sequential node requests */
+  GslDataCacheStats     stats;
 };
 struct _GslDataCacheNode
 {
   int64	        offset;
   guint		ref_count;
   guint		age;
+  uint64        stamp;  /* global LRU stamp, assigned when unused */
   GslDataType  *data;	/* NULL while busy */
 };
 typedef enum
@@ -55,5 +72,10 @@ void		  gsl_data_cache_free_olders	(GslDataCache	    *dcache,
 						 guint		     max_age);
 GslDataCache*	  gsl_data_cache_from_dhandle	(GslDataHandle	    *dhandle,
 						 guint		     min_padding);
+GslDataCacheStats gsl_data_cache_get_stats	(GslDataCache	    *dcache);
+void              gsl_data_cache_set_memory_budget (uint64        n_bytes);
+uint64            gsl_data_cache_get_memory_budget ();
+void              gsl_data_cache_set_pcm_budget    (uint64        memory_bytes,
+                                                    uint64        scratch_bytes);
 
 #endif /* __GSL_DATA_CACHE_H__ */
@@ -239,13 +239,9 @@ pcm_frame_read (MadHandle *handle,
   return succeeded;
 }
 
-static guint*
-create_seek_table (MadHandle *handle,
-		   guint     *n_seeks_p)
+static void
+stream_restart (MadHandle *handle)
 {
-  uint *seeks = NULL, n_seeks = 0;
-
-  *n_seeks_p = 0;
   mad_synth_finish (&handle->synth);
   mad_frame_finish (&handle->frame);
   mad_stream_finish (&handle->stream);
@@ -253,11 +249,20 @@ create_seek_table (MadHandle *handle,
   mad_frame_init (&handle->frame);
   mad_synth_init (&handle->synth);
   mad_stream_options (&handle->stream, handle->stream_options);
-
-  /* lseek (handle->hfile, offs, SEEK_SET) */
+  /* lseek (handle->hfile, 0, SEEK_SET) */
   handle->eof = FALSE;
   handle->bfill = 0;
   handle->file_pos = 0;
+}
+
+static guint*
+create_seek_table (MadHandle *handle,
+		   guint     *n_seeks_p)
+{
+  uint *seeks = NULL, n_seeks = 0;
+
+  *n_seeks_p = 0;
+  stream_restart (handle);
 
   do
     {
@@ -266,12 +271,6 @@ create_seek_table (MadHandle *handle,
 	  guint this_pos = handle->file_pos - handle->bfill + handle->stream.this_frame - handle->buffer;
 	  guint i = n_seeks++;
 
-	  if (n_seeks > 256 * 1024)	/* FIXME: max_frames */
-	    {
-	      g_free (seeks);
-	      return NULL;		/* FIXME: ETOOBIG */
-	    }
-
 	  if (sfi_alloc_upper_power2 (n_seeks) > sfi_alloc_upper_power2 (i))
 	    seeks = g_renew (guint, seeks, sfi_alloc_upper_power2 (n_seeks));
 	  seeks[i] = this_pos;
@@ -389,13 +388,29 @@ dh_mad_open (GslDataHandle      *dhandle,
 	}
       else
 	{
-	  handle->seeks = create_seek_table (handle, &handle->n_seeks);
-	  if (!handle->seeks)
+	  /* scanning large files takes long, so seek tables are cached across runtimes */
+	  const String tag = Bse::string_format ("mad:%u:%u", handle->stream_options, handle->frame_size);
+	  std::vector<guint64> index;
+	  if (gsl_hfile_index_load (hfile, tag.c_str(), index) && !index.empty())
+	    {
+	      handle->n_seeks = index.size();
+	      handle->seeks = g_new (guint, handle->n_seeks);
+	      std::copy (index.begin(), index.end(), handle->seeks);
+	      stream_restart (handle);
+	      MDEBUG ("frames in cached seektable: %u", handle->n_seeks);
+	    }
+	  else
 	    {
-	      error = Bse::Error::NO_SEEK_INFO;
-	      goto OPEN_FAILED;
+	      handle->seeks = create_seek_table (handle, &handle->n_seeks);
+	      if (!handle->seeks)
+		{
+		  error = Bse::Error::NO_SEEK_INFO;
+		  goto OPEN_FAILED;
+		}
+	      index.assign (handle->seeks, handle->seeks + handle->n_seeks);
+	      gsl_hfile_index_store (hfile, tag.c_str(), index);
+	      MDEBUG ("frames in seektable: %u", handle->n_seeks);
 	    }
-	  MDEBUG ("frames in seektable: %u", handle->n_seeks);
 	}
     }
 
@@ -421,6 +436,7 @@ dh_mad_open (GslDataHandle      *dhandle,
   setup->bit_depth = 24;
   setup->mix_freq = handle->sample_rate;
   setup->needs_cache = TRUE;
+  dhandle->content_id = gsl_hfile_content_id (hfile, "mad");
   setup->xinfos = bse_xinfos_add_float (setup->xinfos, "osc-freq", handle->osc_freq);
   return Bse::Error::NONE;
 
@@ -36,6 +36,12 @@ typedef struct {
   GslLong pcm_pos, pcm_length;
   gfloat *pcm[MAX_CHANNELS];
 
+  /* page index, (byte offset, pcm offset) pairs, built or loaded upon open */
+  GTime    index_mtime;
+  guint    index_built : 1;
+  guint    n_index;
+  guint64 *index;
+
   OggVorbis_File ofile;
 } VorbisHandle;
 
@@ -152,6 +158,99 @@ dh_vorbis_page_seek (VorbisHandle *vhandle, int64 pos)
   return err;
 }
 
+static String
+dh_vorbis_file_tag (VorbisHandle *vhandle)
+{
+  VFile *vfile = (VFile*) vhandle->ofile.datasource;
+  return Bse::string_format ("vorbis:%d:%d:%u", vfile->byte_offset, vfile->byte_length, vhandle->bitstream_serialno);
+}
+
+static void
+dh_vorbis_index_build (VorbisHandle *vhandle)
+{
+  VFile *vfile = (VFile*) vhandle->ofile.datasource;
+  GslHFile *hfile = vfile->rfile->hfile;
+  const String tag = dh_vorbis_file_tag (vhandle);
+  std::vector<guint64> index;
+  if (!gsl_hfile_index_load (hfile, tag.c_str(), index) || index.size() % 2)
+    {
+      /* scan the page headers of our bitstream, without decoding. decoding can
+       * resume at a page once the preceding page's granule position is reached
+       */
+      const GslLong spacing = vhandle->max_block_size * 4;
+      ogg_sync_state osync;
+      ogg_page opage;
+      GslLong offset = 0, page_offset = 0, last_granule = 0;
+      index.clear();
+      ogg_sync_init (&osync);
+      while (true)
+        {
+          const long n = ogg_sync_pageseek (&osync, &opage);
+          if (n > 0)
+            {
+              const GslLong granule = ogg_page_granulepos (&opage);
+              if (guint (ogg_page_serialno (&opage)) == vhandle->bitstream_serialno && granule >= 0)
+                {
+                  if (index.empty() || last_granule >= GslLong (index.back()) + spacing)
+                    {
+                      index.push_back (page_offset);
+                      index.push_back (last_granule);
+                    }
+                  last_granule = granule;
+                }
+              page_offset += n;
+            }
+          else if (n < 0)
+            page_offset -= n;   /* skipped bytes */
+          else
+            {
+              const long buffer_size = 64 * 1024;
+              char *buffer = ogg_sync_buffer (&osync, buffer_size);
+              GslLong l = MIN (buffer_size, vfile->byte_length - offset);
+              l = l > 0 ? gsl_rfile_pread (vfile->rfile, vfile->byte_offset + offset, l, buffer) : 0;
+              if (l <= 0)
+                break;
+              ogg_sync_wrote (&osync, l);
+              offset += l;
+            }
+        }
+      ogg_sync_clear (&osync);
+      gsl_hfile_index_store (hfile, tag.c_str(), index);
+    }
+  g_free (vhandle->index);
+  vhandle->n_index = index.size() / 2;
+  vhandle->index = g_new (guint64, index.size());
+  std::copy (index.begin(), index.end(), vhandle->index);
+  vhandle->index_built = TRUE;
+}
+
+static int
+dh_vorbis_index_seek (VorbisHandle *vhandle, GslLong pos)
+{
+  if (!vhandle->index_built)
+    return -1;
+  /* find the last page that resumes before pos, leaving room for the first packet which only primes the decoder */
+  const GslLong target = pos - vhandle->max_block_size;
+  guint lower = 0, upper = vhandle->n_index;
+  while (lower < upper)
+    {
+      const guint i = (lower + upper) / 2;
+      if (GslLong (vhandle->index[i * 2 + 1]) <= target)
+        lower = i + 1;
+      else
+        upper = i;
+    }
+  /* granules are relative to the bitstream start, verify the actual position */
+  for (guint i = lower; i > 0 && i + 3 > lower; i--)
+    if (ov_raw_seek (&vhandle->ofile, vhandle->index[(i - 1) * 2]) == 0)
+      {
+        const GslLong tell = ov_pcm_tell (&vhandle->ofile) - vhandle->soffset;
+        if (tell >= 0 && tell <= pos)
+          return 0;
+      }
+  return -1;
+}
+
 static Bse::Error
 dh_vorbis_open (GslDataHandle      *dhandle,
 		GslDataHandleSetup *setup)
@@ -233,10 +332,17 @@ dh_vorbis_open (GslDataHandle      *dhandle,
   vhandle->max_block_size = MAX (vhandle->max_block_size, n);
   vhandle->pcm_pos = 0;
   vhandle->pcm_length = 0;
+  if (!vhandle->index_built || vhandle->index_mtime != vfile->rfile->hfile->mtime)
+    {
+      /* scan once outside of the reading threads, later opens load the index from the cache */
+      vhandle->index_mtime = vfile->rfile->hfile->mtime;
+      dh_vorbis_index_build (vhandle);
+    }
 
   setup->bit_depth = 24;
   setup->mix_freq = vi->rate;
   setup->needs_cache = TRUE;
+  dhandle->content_id = gsl_hfile_content_id (vfile->rfile->hfile, dh_vorbis_file_tag (vhandle).c_str());
   setup->xinfos = bse_xinfos_add_float (setup->xinfos, "osc-freq", vhandle->osc_freq);
   return Bse::Error::NONE;
 }
@@ -253,8 +359,10 @@ dh_vorbis_coarse_seek (GslDataHandle *dhandle, GslLong voffset)
   if (pos < vhandle->pcm_pos ||
       pos >= vhandle->pcm_pos + vhandle->pcm_length + SEEK_BY_READ_AHEAD (vhandle))
     {
-      int err = dh_vorbis_page_seek (vhandle, vhandle->soffset + pos);
+      int err = dh_vorbis_index_seek (vhandle, pos);
 
+      if (err)
+        err = dh_vorbis_page_seek (vhandle, vhandle->soffset + pos);
       if (err)	/* eek */
 	err = dh_vorbis_page_seek (vhandle, vhandle->soffset);
       else
@@ -357,6 +465,9 @@ dh_vorbis_destroy (GslDataHandle *dhandle)
 {
   VorbisHandle *vhandle = (VorbisHandle*) dhandle;
 
+  g_free (vhandle->index);
+  vhandle->index = NULL;
+  vhandle->n_index = 0;
   gsl_data_handle_common_free (dhandle);
   sfi_delete_struct (VorbisHandle, vhandle);
 }
@@ -397,6 +508,7 @@ gsl_data_handle_new_ogg_vorbis_any (const gchar *file_name,
       vhandle->rfile_byte_offset = byte_offset;
       vhandle->rfile_add_zoffset = add_zoffset != FALSE;
       vhandle->rfile_byte_length = byte_size;
+      vhandle->index_mtime = -1;
 
       /* we can only check matters upon opening and need
        * to initialize things like the bitstream_serialno.
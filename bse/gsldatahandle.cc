@@ -30,6 +30,7 @@ gsl_data_handle_common_init (GslDataHandle *dhandle,
   dhandle->ref_count = 1;
   dhandle->open_count = 0;
   memset (&dhandle->setup, 0, sizeof (dhandle->setup));
+  dhandle->content_id = 0;
   return TRUE;
 }
 GslDataHandle*
@@ -1390,6 +1391,7 @@ gsl_data_handle_new_dcached (GslDataCache *dcache)
 typedef struct {
   GslDataHandle     dhandle;
   GslHFile	   *hfile;
+  const guint8     *mdata;      /* shared file mapping, NULL for pread() IO */
   int64	            byte_offset;
   guint             byte_order;
   guint		    n_channels;
@@ -1484,6 +1486,15 @@ wave_handle_open (GslDataHandle      *dhandle,
 	  if (zoffset >= 0)
 	    whandle->byte_offset += zoffset + 1;
 	}
+      /* read sample data straight from the file mapping if the conversion can dereference
+       * whole 1, 2 or 4 byte elements there, packed 24bit samples always use the copy path
+       */
+      const int64 ewidth = gsl_conv_value_width (whandle->format);
+      whandle->mdata = NULL;
+      if (ewidth == fwidth && (ewidth == 1 || ewidth == 2 || ewidth == 4))
+        whandle->mdata = gsl_hfile_mmap (whandle->hfile);
+      if (whandle->mdata && size_t (whandle->mdata + whandle->byte_offset) % ewidth != 0)
+        whandle->mdata = NULL;
       /* convert size into n_values, i.e. float length */
       l = whandle->hfile->n_bytes;
       l -= MIN (l, whandle->byte_offset);
@@ -1515,6 +1526,7 @@ wave_handle_close (GslDataHandle *dhandle)
   WaveHandle *whandle = (WaveHandle*) dhandle;
 
   dhandle->setup.xinfos = NULL;
+  whandle->mdata = NULL;
   gsl_hfile_close (whandle->hfile);
   whandle->hfile = NULL;
 }
@@ -1532,6 +1544,18 @@ wave_handle_read (GslDataHandle *dhandle,
   byte_offset = voffset * wave_format_byte_width (whandle->format);	/* float offset into bytes */
   byte_offset += whandle->byte_offset;
 
+  if (whandle->mdata)   /* convert directly from the shared mapping, no IO buffers */
+    {
+      const int64 fwidth = wave_format_byte_width (whandle->format);
+      l = byte_offset < whandle->hfile->n_bytes ? (whandle->hfile->n_bytes - byte_offset) / fwidth : 0;
+      l = MIN (l, n_values);
+      if (whandle->format == GSL_WAVE_FORMAT_FLOAT && whandle->byte_order == G_BYTE_ORDER)
+        memcpy (values, whandle->mdata + byte_offset, l * sizeof (values[0]));
+      else
+        gsl_conv_to_float (whandle->format, whandle->byte_order, whandle->mdata + byte_offset, values, l);
+      return l;
+    }
+
   switch (whandle->format)
     {
       guint8 *u8; gint8 *s8; guint16 *u16; guint32 *u32; gint32 *s32;
@@ -1602,6 +1626,36 @@ wave_handle_read (GslDataHandle *dhandle,
   return l;
 }
 
+/**
+ * @param dhandle   an opened handle created by gsl_wave_handle_new()
+ * @param voffset   value offset into @a dhandle
+ * @param n_values  location to store the number of values available at the returned address
+ * @return          pointer into the file mapping or NULL
+ *
+ * Provide zero-copy access to the sample data of a wave handle. This only
+ * succeeds for memory mapped files that store floats in host byte order,
+ * the returned memory is shared with every other user of the same file and
+ * remains valid until @a dhandle is closed.
+ */
+const gfloat*
+gsl_wave_handle_mapped_floats (GslDataHandle *dhandle,
+                               int64          voffset,
+                               int64         *n_values)
+{
+  WaveHandle *whandle = (WaveHandle*) dhandle;
+
+  assert_return (dhandle != NULL, NULL);
+  assert_return (GSL_DATA_HANDLE_OPENED (dhandle), NULL);
+  assert_return (n_values != NULL, NULL);
+  *n_values = 0;
+  if (dhandle->vtable->read != wave_handle_read || !whandle->mdata ||
+      whandle->format != GSL_WAVE_FORMAT_FLOAT || whandle->byte_order != G_BYTE_ORDER)
+    return NULL;
+  assert_return (voffset >= 0 && voffset < dhandle->setup.n_values, NULL);
+  *n_values = dhandle->setup.n_values - voffset;
+  return (const gfloat*) (whandle->mdata + whandle->byte_offset) + voffset;
+}
+
 GslDataHandle*
 gsl_wave_handle_new (const gchar      *file_name,
 		     guint             n_channels,
@@ -1642,6 +1696,7 @@ gsl_wave_handle_new (const gchar      *file_name,
       whandle->requested_offset = byte_offset;
       whandle->requested_length = n_values;
       whandle->hfile = NULL;
+      whandle->mdata = NULL;
       whandle->xinfos = bse_xinfos_dup_consolidated (xinfos, FALSE);
       whandle->mix_freq = mix_freq;
       whandle->xinfos = bse_xinfos_add_float (whandle->xinfos, "osc-freq", osc_freq);
@@ -30,6 +30,7 @@ struct _GslDataHandle
   guint		      open_count;
   /* opened data handle setup (open_count > 0) */
   GslDataHandleSetup  setup;
+  guint64             content_id;       /* identifies decoded contents across handles, 0 if unknown */
 };
 typedef void (*GslDataHandleRecurse)	(GslDataHandle		*data_handle,
 					 gpointer		 data);
@@ -103,6 +104,10 @@ GslDataHandle*	  bse_data_handle_new_upsample2	    (GslDataHandle  *src_handle,
 						     int             precision_bits);
 GslDataHandle*	  bse_data_handle_new_downsample2   (GslDataHandle  *src_handle,
 						     int             precision_bits);	// implemented in bsedatahandle-resample.cc
+/* --- arbitrary ratio resampling datahandle --- */
+GslDataHandle*	  bse_data_handle_new_resample	    (GslDataHandle  *src_handle,	// implemented in bsedatahandle-resample.cc
+						     double          mix_freq,
+						     int             precision_bits);
 
 GslDataHandle*	  bse_data_handle_new_fir_highpass  (GslDataHandle *src_handle,		// implemented in bsedatahandle-fir.cc
 						     gdouble        cutoff_freq,
@@ -161,6 +166,9 @@ GslDataHandle*	  gsl_wave_handle_new_zoffset	(const gchar	  *file_name,
 						 int64		   byte_offset,
 						 int64		   byte_size,
                                                  gchar           **xinfos);
+const gfloat*	  gsl_wave_handle_mapped_floats	(GslDataHandle	  *dhandle,
+						 int64		   voffset,
+						 int64		  *n_values);
 guint		  gsl_wave_format_bit_depth	(GslWaveFormatType format);
 guint		  gsl_wave_format_byte_width	(GslWaveFormatType format);
 
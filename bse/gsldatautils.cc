@@ -8,6 +8,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <atomic>
 
 #define	BSIZE		GSL_DATA_HANDLE_PEEK_BUFFER	/* FIXME: global buffer size setting */
 
@@ -881,4 +882,401 @@ gsl_data_clip_sample (GslDataHandle     *dhandle,
   return result->error;
 }
 
+/* --- SIMD conversion kernels --- */
+/* The kernels convert 8 values per step with GCC vector extensions, so the same
+ * code compiles to SSE2 or NEON by default and to AVX2 for CPUs that support it.
+ * Results are bit identical to the scalar code in gsldatautils.hh: float to
+ * integer conversion rounds halfway cases away from zero like bse_dtoi(), and
+ * offset binary formats round halfway cases up like bse_dtoi (v + offset).
+ * Each step loads all of its input before storing output, so the in-place
+ * conversions done by the callers (narrowing from the buffer start, widening
+ * from the buffer end) stay correct.
+ */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"        // vectors only pass between inlined helpers, 32 byte vectors by reference
+namespace {
+typedef float   ConvF8  __attribute__ ((vector_size (32)));
+typedef gint32  ConvI8  __attribute__ ((vector_size (32)));
+typedef guint32 ConvU8  __attribute__ ((vector_size (32)));
+typedef gint16  ConvS8  __attribute__ ((vector_size (16)));
+typedef guint16 ConvW8  __attribute__ ((vector_size (16)));
+typedef gint8   ConvC8  __attribute__ ((vector_size (8)));
+typedef guint8  ConvB8  __attribute__ ((vector_size (8)));
+#define CONV_INLINE     static inline __attribute__ ((always_inline))
+
+template<class V> CONV_INLINE void
+conv_load (V &v, const void *mem)
+{
+  memcpy (&v, mem, sizeof (v));
+}
+
+template<class V> CONV_INLINE void
+conv_store (void *mem, const V &v)
+{
+  memcpy (mem, &v, sizeof (v));
+}
+
+/* bse_dtoi (v), i.e. halfway cases away from zero, v must be within int32 range */
+CONV_INLINE void
+conv_round (ConvI8 &r, const ConvF8 &v)
+{
+  const ConvI8 t = __builtin_convertvector (v, ConvI8);
+  const ConvF8 frac = v - __builtin_convertvector (t, ConvF8);      // exact
+  r = t - (frac >= 0.5f) + (frac <= -0.5f);                           // comparisons yield -1
+}
+
+/* bse_dtoi (v + offset) for integer offsets with v + offset >= 0, i.e. halfway cases up */
+CONV_INLINE void
+conv_round_up (ConvI8 &r, const ConvF8 &v)
+{
+  ConvI8 t = __builtin_convertvector (v, ConvI8);
+  t += __builtin_convertvector (t, ConvF8) > v;                       // floor
+  const ConvF8 frac = v - __builtin_convertvector (t, ConvF8);
+  r = t - (frac >= 0.5f);
+}
+
+/* load 8 values, scale and clamp them to [lo, hi], then round with bse_dtoi() semantics */
+CONV_INLINE void
+conv_quantize (ConvI8 &r, const gfloat *src, float scale, float lo, float hi, bool round_up)
+{
+  const ConvF8 vlo = ConvF8 {} + lo, vhi = ConvF8 {} + hi;
+  ConvF8 v;
+  conv_load (v, src);
+  v *= scale;
+  v = v < vlo ? vlo : v;
+  v = v > vhi ? vhi : v;
+  if (round_up)
+    conv_round_up (r, v);
+  else
+    conv_round (r, v);
+}
+
+CONV_INLINE ConvW8
+conv_swap16 (const ConvW8 &v)
+{
+  return (v >> 8) | (v << 8);
+}
+
+CONV_INLINE void
+conv_swap32 (ConvU8 &v)
+{
+  v = (v >> 24) | ((v >> 8) & 0xff00) | ((v << 8) & 0xff0000) | (v << 24);
+}
+
+CONV_INLINE ConvW8
+conv_pack16 (const ConvI8 &v, bool swap)
+{
+  const ConvW8 w = __builtin_convertvector (v, ConvW8);
+  return swap ? conv_swap16 (w) : w;
+}
+
+CONV_INLINE void
+conv_unpack16 (ConvI8 &r, const guint8 *src, bool swap, bool is_signed)
+{
+  ConvW8 w;
+  conv_load (w, src);
+  w = swap ? conv_swap16 (w) : w;
+  if (is_signed)
+    r = __builtin_convertvector ((ConvS8) w, ConvI8);
+  else
+    r = __builtin_convertvector (w, ConvI8);
+}
+
+CONV_INLINE guint
+conv_from_float_clip (GslWaveFormatType format, bool swap, const gfloat *src, gpointer dest, guint n_values)
+{
+  const guint n = n_values & ~7;
+  guint8 *d8 = (guint8*) dest;
+  guint i;
+  switch (format)
+    {
+    case GSL_WAVE_FORMAT_UNSIGNED_8:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvI8 v;
+          conv_quantize (v, src + i, 128.f, -128, 127, true);
+          conv_store (d8 + i, __builtin_convertvector (v + 128, ConvB8));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_SIGNED_8:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvI8 v;
+          conv_quantize (v, src + i, 128.f, -128, 127, false);
+          conv_store (d8 + i, __builtin_convertvector (v, ConvC8));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_UNSIGNED_12:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvI8 v;
+          conv_quantize (v, src + i, 2048.f, -2048, 2047, true);
+          conv_store (d8 + i * 2, conv_pack16 (v + 2048, swap));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_SIGNED_12:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvI8 v;
+          conv_quantize (v, src + i, 2048.f, -2048, 2047, false);
+          conv_store (d8 + i * 2, conv_pack16 (v, swap));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_UNSIGNED_16:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvI8 v;
+          conv_quantize (v, src + i, 32768.f, -32768, 32767, true);
+          conv_store (d8 + i * 2, conv_pack16 (v + 32768, swap));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_SIGNED_16:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvI8 v;
+          conv_quantize (v, src + i, 32768.f, -32768, 32767, false);
+          conv_store (d8 + i * 2, conv_pack16 (v, swap));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_SIGNED_24_PAD4:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvI8 v;
+          conv_quantize (v, src + i, 8388608.f, -8388608, 8388607, false);
+          ConvU8 u = (ConvU8) v;
+          if (swap)
+            conv_swap32 (u);
+          conv_store (d8 + i * 4, u);
+        }
+      return n;
+    case GSL_WAVE_FORMAT_SIGNED_32:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvF8 f;
+          ConvI8 v;
+          conv_load (f, src + i);
+          f *= 2147483648.f;
+          conv_quantize (v, src + i, 2147483648.f, -2147483648.f, 2147483520.f, false); // largest float below 2^31
+          ConvU8 u = (ConvU8) (f >= 2147483648.f ? ConvI8 {} + 2147483647 : v);
+          if (swap)
+            conv_swap32 (u);
+          conv_store (d8 + i * 4, u);
+        }
+      return n;
+    case GSL_WAVE_FORMAT_FLOAT:
+      if (!swap)
+        return 0;       // nothing to convert
+      for (i = 0; i < n; i += 8)
+        {
+          ConvU8 u;
+          conv_load (u, src + i);
+          conv_swap32 (u);
+          conv_store (d8 + i * 4, u);
+        }
+      return n;
+    default:
+      return 0;         // packed 24 bit, A-law and u-law use the scalar code
+    }
+}
+
+CONV_INLINE guint
+conv_to_float (GslWaveFormatType format, bool swap, gconstpointer src, gfloat *dest, guint n_values)
+{
+  const guint n = n_values & ~7;
+  const guint8 *s8 = (const guint8*) src;
+  guint i;
+  switch (format)
+    {
+    case GSL_WAVE_FORMAT_UNSIGNED_8:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvB8 b;
+          conv_load (b, s8 + i);
+          const ConvI8 v = __builtin_convertvector (b, ConvI8) - 128;
+          conv_store (dest + i, __builtin_convertvector (v, ConvF8) * (1.f / 128.f));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_SIGNED_8:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvC8 c;
+          conv_load (c, s8 + i);
+          const ConvI8 v = __builtin_convertvector (c, ConvI8);
+          conv_store (dest + i, __builtin_convertvector (v, ConvF8) * (1.f / 128.f));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_UNSIGNED_12:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvI8 v;
+          conv_unpack16 (v, s8 + i * 2, swap, false);
+          v = (v & 0x0fff) - 2048;
+          conv_store (dest + i, __builtin_convertvector (v, ConvF8) * (1.f / 2048.f));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_SIGNED_12:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvI8 v;
+          conv_unpack16 (v, s8 + i * 2, swap, true);
+          v = v < -2048 ? ConvI8 {} - 2048 : v;
+          v = v > 2048 ? ConvI8 {} + 2048 : v;
+          conv_store (dest + i, __builtin_convertvector (v, ConvF8) * (1.f / 2048.f));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_UNSIGNED_16:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvI8 v;
+          conv_unpack16 (v, s8 + i * 2, swap, false);
+          v -= 32768;
+          conv_store (dest + i, __builtin_convertvector (v, ConvF8) * (1.f / 32768.f));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_SIGNED_16:
+      for (i = 0; i < n; i += 8)
+        {
+          ConvI8 v;
+          conv_unpack16 (v, s8 + i * 2, swap, true);
+          conv_store (dest + i, __builtin_convertvector (v, ConvF8) * (1.f / 32768.f));
+        }
+      return n;
+    case GSL_WAVE_FORMAT_SIGNED_24_PAD4:
+    case GSL_WAVE_FORMAT_SIGNED_32:
+      {
+        const float scale = format == GSL_WAVE_FORMAT_SIGNED_32 ? 1.f / 2147483648.f : 1.f / 8388608.f;
+        for (i = 0; i < n; i += 8)
+          {
+            ConvU8 u;
+            conv_load (u, s8 + i * 4);
+            if (swap)
+              conv_swap32 (u);
+            conv_store (dest + i, __builtin_convertvector ((ConvI8) u, ConvF8) * scale);
+          }
+      }
+      return n;
+    case GSL_WAVE_FORMAT_FLOAT:
+      if (!swap)
+        return 0;       // nothing to convert
+      for (i = 0; i < n; i += 8)
+        {
+          ConvU8 u;
+          conv_load (u, s8 + i * 4);
+          conv_swap32 (u);
+          conv_store (dest + i, u);
+        }
+      return n;
+    default:
+      return 0;         // packed 24 bit, A-law and u-law use the scalar code
+    }
+}
+
+static guint
+conv_from_float_clip_vector (GslWaveFormatType format, bool swap, const gfloat *src, gpointer dest, guint n_values)
+{
+  return conv_from_float_clip (format, swap, src, dest, n_values);
+}
+
+static guint
+conv_to_float_vector (GslWaveFormatType format, bool swap, gconstpointer src, gfloat *dest, guint n_values)
+{
+  return conv_to_float (format, swap, src, dest, n_values);
+}
+
+#if defined __x86_64__ || defined __amd64__
+#define CONV_AVX2       __attribute__ ((target ("avx2")))
+
+CONV_AVX2 static guint
+conv_from_float_clip_avx2 (GslWaveFormatType format, bool swap, const gfloat *src, gpointer dest, guint n_values)
+{
+  return conv_from_float_clip (format, swap, src, dest, n_values);
+}
+
+CONV_AVX2 static guint
+conv_to_float_avx2 (GslWaveFormatType format, bool swap, gconstpointer src, gfloat *dest, guint n_values)
+{
+  return conv_to_float (format, swap, src, dest, n_values);
+}
+#endif
+
+struct ConvImpl {
+  const char *name = NULL;
+  guint (*from_float_clip) (GslWaveFormatType, bool, const gfloat*, gpointer, guint) = NULL;
+  guint (*to_float) (GslWaveFormatType, bool, gconstpointer, gfloat*, guint) = NULL;
+};
+static std::atomic<bool> conv_simd_disabled { false };
+
+static const ConvImpl&
+conv_impl ()
+{
+  static const ConvImpl impl = [] () {
+    ConvImpl ci;
+#if defined __x86_64__ || defined __amd64__
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports ("avx2"))
+      {
+        ci.name = "AVX2";
+        ci.from_float_clip = conv_from_float_clip_avx2;
+        ci.to_float = conv_to_float_avx2;
+        return ci;
+      }
+    ci.name = "SSE2";
+#else
+    ci.name = "Vector";
+#endif
+    ci.from_float_clip = conv_from_float_clip_vector;
+    ci.to_float = conv_to_float_vector;
+    return ci;
+  } ();
+  return impl;
+}
+} // Anon
+#pragma GCC diagnostic pop
+
+/**
+ * Convert the leading multiple of 8 values like gsl_conv_from_float_clip() with SIMD instructions.
+ * Returns the number of values converted, 0 if @a format is not supported.
+ */
+guint
+gsl_conv_from_float_clip_simd (GslWaveFormatType format,
+                               guint             byte_order,
+                               const gfloat     *src,
+                               gpointer          dest,
+                               guint             n_values)
+{
+  if (conv_simd_disabled)
+    return 0;
+  return conv_impl().from_float_clip (format, byte_order != G_BYTE_ORDER, src, dest, n_values);
+}
+
+/**
+ * Convert the leading multiple of 8 values like gsl_conv_to_float() with SIMD instructions.
+ * Returns the number of values converted, 0 if @a format is not supported.
+ */
+guint
+gsl_conv_to_float_simd (GslWaveFormatType format,
+                        guint             byte_order,
+                        gconstpointer     src,
+                        gfloat           *dest,
+                        guint             n_values)
+{
+  if (conv_simd_disabled)
+    return 0;
+  return conv_impl().to_float (format, byte_order != G_BYTE_ORDER, src, dest, n_values);
+}
+
+/// Name of the SIMD conversion kernels in use, NULL if disabled.
+const char*
+gsl_conv_simd_impl_name (void)
+{
+  return conv_simd_disabled ? NULL : conv_impl().name;
+}
+
+/// Use scalar conversions only, e.g. to compare results or speed.
+void
+gsl_conv_simd_disable (gboolean disable)
+{
+  conv_simd_disabled = disable;
+}
+
 /* vim:set ts=8 sts=2 sw=2: */
@@ -123,6 +123,20 @@ static inline void    gsl_conv_to_double	(GslWaveFormatType format,
 						 guint             n_values);
 static inline gint16  gsl_alaw_to_pcm           (gint8             alawv);
 static inline gint16  gsl_ulaw_to_pcm           (gint8             ulawv);
+guint                 gsl_conv_from_float_clip_simd (GslWaveFormatType format,
+                                                     guint             byte_order,
+                                                     const gfloat     *src,
+                                                     gpointer          dest,
+                                                     guint             n_values);
+guint                 gsl_conv_to_float_simd    (GslWaveFormatType format,
+						 guint             byte_order,
+						 gconstpointer     src,
+						 gfloat           *dest,
+						 guint             n_values);
+const char*           gsl_conv_simd_impl_name   (void);
+void                  gsl_conv_simd_disable     (gboolean          disable);
+#define GSL_CONV_SIMD_MIN       (32)    /* minimum number of values worth a SIMD call */
+static inline guint   gsl_conv_value_width      (GslWaveFormatType format);
 
 
 /* --- clipping --- */
@@ -168,6 +182,12 @@ gsl_data_handle_peek_value (GslDataHandle     *dhandle,
 }
 
 #define	GSL_CONV_FORMAT(format, endian_flag)	(((endian_flag) << 16) | ((format) & 0xffff))
+static inline guint
+gsl_conv_value_width (GslWaveFormatType format)
+{
+  /* bytes per value as read or written by the conversion functions */
+  return format == GSL_WAVE_FORMAT_SIGNED_24_PAD4 ? 4 : gsl_wave_format_byte_width (format);
+}
 
 static inline guint     /* returns number of bytes used in dest */
 gsl_conv_from_float (GslWaveFormatType format,
@@ -394,6 +414,16 @@ gsl_conv_from_float_clip (GslWaveFormatType format,
 
   if (!n_values)
     return 0;
+  if (n_values >= GSL_CONV_SIMD_MIN)    /* bulk of the values, the remainder is handled below */
+    {
+      const guint n_simd = gsl_conv_from_float_clip_simd (format, byte_order, src, dest, n_values);
+      if (n_simd)
+        {
+          const guint width = gsl_conv_value_width (format);
+          return n_simd * width + gsl_conv_from_float_clip (format, byte_order, src + n_simd,
+                                                            (guint8*) dest + n_simd * width, n_values - n_simd);
+        }
+    }
 
   switch (GSL_CONV_FORMAT (format, byte_order == G_BYTE_ORDER))
     {
@@ -571,8 +601,7 @@ gsl_conv_from_float_clip (GslWaveFormatType format,
         {
           v = *src++;
           v *= 2147483648.;
-          vi32 = bse_dtoi (v);
-          // vi32 = CLAMP (vi32, -2147483648, 2147483647);
+          vi32 = v >= 2147483647. ? 2147483647 : bse_dtoi (v);   /* bse_dtoi() would wrap */
           *i32++ = vi32;
         }
       while (src < bound);
@@ -584,8 +613,7 @@ gsl_conv_from_float_clip (GslWaveFormatType format,
         {
           v = *src++;
           v *= 2147483648.;
-          vi32 = bse_dtoi (v);
-          // vi32 = CLAMP (vi32, -2147483648, 2147483647);
+          vi32 = v >= 2147483647. ? 2147483647 : bse_dtoi (v);   /* bse_dtoi() would wrap */
           *i32++ = GUINT32_SWAP_LE_BE (vi32);
         }
       while (src < bound);
@@ -675,6 +703,16 @@ gsl_conv_to_float (GslWaveFormatType format,
 
   if (!n_values)
     return;
+  if (n_values >= GSL_CONV_SIMD_MIN)    /* bulk of the values, the remainder is handled below */
+    {
+      const guint n_simd = gsl_conv_to_float_simd (format, byte_order, src, dest, n_values);
+      if (n_simd)
+        {
+          const guint width = gsl_conv_value_width (format);
+          gsl_conv_to_float (format, byte_order, (const guint8*) src + n_simd * width, dest + n_simd, n_values - n_simd);
+          return;
+        }
+    }
 
   switch (GSL_CONV_FORMAT (format, byte_order == G_BYTE_ORDER))
     {
@@ -757,7 +795,7 @@ gsl_conv_to_float (GslWaveFormatType format,
       do
         {
           vi16 = *i16++;
-          *dest++ = GUINT16_SWAP_LE_BE (vi16) * (1. / 32768.);
+          *dest++ = (gint16) GUINT16_SWAP_LE_BE (vi16) * (1. / 32768.);
         }
       while (dest < bound);
       break;
@@ -793,7 +831,7 @@ gsl_conv_to_float (GslWaveFormatType format,
       do
         {
           gint32 vi32 = *i32++;
-          *dest++ = GUINT32_SWAP_LE_BE (vi32) * (1. / 8388608.);
+          *dest++ = (gint32) GUINT32_SWAP_LE_BE (vi32) * (1. / 8388608.);
         }
       while (dest < bound);
       break;
@@ -806,7 +844,7 @@ gsl_conv_to_float (GslWaveFormatType format,
       do
         {
           gint32 vi32 = *i32++;
-          *dest++ = GUINT32_SWAP_LE_BE (vi32) * (1. / 2147483648.);
+          *dest++ = (gint32) GUINT32_SWAP_LE_BE (vi32) * (1. / 2147483648.);
         }
       while (dest < bound);
       break;
@@ -1364,7 +1402,7 @@ gsl_conv_to_double (GslWaveFormatType format,
       do
         {
           vi16 = *i16++;
-          *dest++ = GUINT16_SWAP_LE_BE (vi16) * (1. / 32768.);
+          *dest++ = (gint16) GUINT16_SWAP_LE_BE (vi16) * (1. / 32768.);
         }
       while (dest < bound);
       break;
@@ -1400,7 +1438,7 @@ gsl_conv_to_double (GslWaveFormatType format,
       do
         {
           gint32 vi32 = *i32++;
-          *dest++ = GUINT32_SWAP_LE_BE (vi32) * (1. / 8388608.);
+          *dest++ = (gint32) GUINT32_SWAP_LE_BE (vi32) * (1. / 8388608.);
         }
       while (dest < bound);
       break;
@@ -1413,7 +1451,7 @@ gsl_conv_to_double (GslWaveFormatType format,
       do
         {
           gint32 vi32 = *i32++;
-          *dest++ = GUINT32_SWAP_LE_BE (vi32) * (1. / 2147483648.);
+          *dest++ = (gint32) GUINT32_SWAP_LE_BE (vi32) * (1. / 2147483648.);
         }
       while (dest < bound);
       break;
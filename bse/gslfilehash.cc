@@ -1,12 +1,20 @@
 // Licensed GNU LGPL v2.1 or later: http://www.gnu.org/licenses/lgpl.html
 #include "gslfilehash.hh"
 #include "bse/internal.hh"
+#include "bse/randomhash.hh"
+#include "bse/storage.hh"
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/statvfs.h>
 #include <string.h>
 #include <errno.h>
+#include <mutex>
+#include <shared_mutex>
+
+#define HDEBUG(...)     Bse::debug ("hfile", __VA_ARGS__)
 
 /* macros */
 #if (GLIB_SIZEOF_LONG > 4)
@@ -16,8 +24,8 @@
 #endif
 
 /* --- variables --- */
-static std::mutex  fdpool_mutex;
-static GHashTable *hfile_ht = NULL;
+static std::shared_mutex fdpool_mutex;  /* shared for lookups, exclusive for table changes */
+static GHashTable       *hfile_ht = NULL;
 
 /* --- functions --- */
 static guint
@@ -83,28 +91,45 @@ gsl_hfile_open (const gchar *file_name)
   key.file_name = (gchar*) file_name;
   if (!stat_file (file_name, &key.mtime, &key.n_bytes))
     return NULL;	/* errno from stat() */
+  /* the last close needs the exclusive lock, so ocount > 0 for listed files */
+  fdpool_mutex.lock_shared();
+  hfile = (GslHFile*) g_hash_table_lookup (hfile_ht, &key);
+  if (hfile)
+    hfile->ocount++;
+  fdpool_mutex.unlock_shared();
+  if (hfile)
+    {
+      errno = 0;
+      return hfile;
+    }
   fdpool_mutex.lock();
   hfile = (GslHFile*) g_hash_table_lookup (hfile_ht, &key);
   if (hfile)
     {
-      hfile->mutex.lock();
       hfile->ocount++;
-      hfile->mutex.unlock();
       ret_errno = 0;
     }
   else
     {
       gint fd;
 
+      struct stat statbuf = { 0, };
       fd = open (file_name, O_RDONLY | O_NOCTTY, 0);
+      if (fd >= 0 && fstat (fd, &statbuf) < 0)
+        {
+          ret_errno = errno;
+          close (fd);
+          fd = -1;
+          errno = ret_errno;
+        }
       if (fd >= 0)
 	{
-	  hfile = sfi_new_struct0 (GslHFile, 1);
-          new (&hfile->mutex) std::mutex();
+	  hfile = new (sfi_new_struct0 (GslHFile, 1)) GslHFile();
 	  hfile->file_name = g_strdup (file_name);
-	  hfile->mtime = key.mtime;
-	  hfile->n_bytes = key.n_bytes;
-	  hfile->cpos = 0;
+	  /* describe the file actually opened, it may have been replaced since stat_file() */
+	  hfile->mtime = statbuf.st_mtim.tv_sec;
+	  hfile->mtime_nsecs = statbuf.st_mtim.tv_nsec;
+	  hfile->n_bytes = statbuf.st_size;
 	  hfile->fd = fd;
 	  hfile->ocount = 1;
 	  hfile->zoffset = -2;
@@ -129,12 +154,20 @@ gsl_hfile_close (GslHFile *hfile)
 {
   gboolean destroy = FALSE;
   assert_return (hfile != NULL);
-  assert_return (hfile->ocount > 0);
+  guint ocount = hfile->ocount.load();
+  assert_return (ocount > 0);
+  /* fast path, drop references that cannot be the last one without locking */
+  while (ocount > 1)
+    if (hfile->ocount.compare_exchange_weak (ocount, ocount - 1))
+      {
+        errno = 0;
+        return;
+      }
   fdpool_mutex.lock();
-  hfile->mutex.lock();
-  if (hfile->ocount > 1)
-    hfile->ocount--;
-  else
+  ocount = hfile->ocount.load();
+  while (ocount > 1 && !hfile->ocount.compare_exchange_weak (ocount, ocount - 1))
+    ;   /* racing with lock-free closes */
+  if (ocount == 1)
     {
       if (!g_hash_table_remove (hfile_ht, hfile))
         Bse::warning ("%s: failed to unlink hashed file (%p)", __func__, hfile);
@@ -144,18 +177,50 @@ gsl_hfile_close (GslHFile *hfile)
 	  destroy = TRUE;
 	}
     }
-  hfile->mutex.unlock();
   fdpool_mutex.unlock();
   if (destroy)
     {
+      HDEBUG ("%s: %u reads, %u bytes, %.3fms", hfile->file_name, uint (hfile->n_reads), uint (hfile->n_read_bytes),
+              hfile->read_nsecs * 0.000001);
+      if (hfile->mdata)
+        munmap (hfile->mdata, hfile->n_bytes);
       close (hfile->fd);
       g_free (hfile->file_name);
-      hfile->mutex.~mutex();
+      hfile->~GslHFile();
       sfi_delete_struct (GslHFile, hfile);
     }
   errno = 0;
 }
 
+static GslLong
+hfile_pread_fd (GslHFile *hfile,
+                GslLong   offset,
+                GslLong   n_bytes,
+                gpointer  bytes)
+{
+  GslLong ret_bytes;
+  do
+    ret_bytes = pread (hfile->fd, bytes, n_bytes, offset);
+  while (ret_bytes < 0 && errno == EINTR);
+  if ((ret_bytes == 0 || (ret_bytes < 0 && errno == EINVAL)) && offset < hfile->n_bytes)
+    {
+      /* this should only happen if the file changed since open() */
+      ret_bytes = MIN (n_bytes, hfile->n_bytes - offset);
+      memset (bytes, 0, ret_bytes);
+    }
+  return ret_bytes < 0 ? -1 : ret_bytes;
+}
+static void
+hfile_account (GslHFile *hfile,
+               guint64   n_reads,
+               guint64   n_bytes,
+               guint64   nsecs)
+{
+  hfile->n_reads.fetch_add (n_reads, std::memory_order_relaxed);
+  hfile->n_read_bytes.fetch_add (n_bytes, std::memory_order_relaxed);
+  hfile->read_nsecs.fetch_add (nsecs, std::memory_order_relaxed);
+}
+
 /**
  * @param hfile   valid GslHFile
  * @param offset  offset in bytes within 0 and file end
@@ -164,6 +229,10 @@ gsl_hfile_close (GslHFile *hfile)
  * @return amount of bytes read or -1 if an error occoured (errno set)
  *
  * Read a block of bytes from a GslHFile.
+ * Reads are positional and take no locks, so concurrent readers of the
+ * same file do not serialize.
+ * If the file was truncated since it was opened, the missing bytes are
+ * zero-filled up to the file size at open time.
  * This function is MT-safe and may be called from any thread.
  */
 GslLong
@@ -172,9 +241,6 @@ gsl_hfile_pread (GslHFile *hfile,
 		 GslLong   n_bytes,
 		 gpointer  bytes)
 {
-  GslLong ret_bytes = -1;
-  gint ret_errno;
-
   errno = EFAULT;
   assert_return (hfile != NULL, -1);
   assert_return (hfile->ocount > 0, -1);
@@ -185,52 +251,33 @@ gsl_hfile_pread (GslHFile *hfile,
       return 0;
     }
   assert_return (bytes != NULL, -1);
-  hfile->mutex.lock();
-  if (hfile->ocount)
-    {
-      if (hfile->cpos != offset)
-	{
-	  hfile->cpos = lseek (hfile->fd, offset, SEEK_SET);
-	  if (hfile->cpos < 0 && errno != EINVAL)
-	    {
-	      ret_errno = errno;
-	      hfile->mutex.unlock();
-	      errno = ret_errno;
-	      return -1;
-	    }
-	}
-      if (hfile->cpos == offset)
-	{
-	  do
-	    ret_bytes = read (hfile->fd, bytes, n_bytes);
-	  while (ret_bytes < 0 && errno == EINTR);
-	  if (ret_bytes < 0)
-	    {
-	      ret_errno = errno;
-	      ret_bytes = -1;
-	    }
-	  else
-	    {
-	      ret_errno = 0;
-	      hfile->cpos += ret_bytes;
-	    }
-	}
-      else	/* this should only happen if the file changed since open() */
-	{
-	  hfile->cpos = -1;
-	  if (offset + n_bytes > hfile->n_bytes)
-	    n_bytes = hfile->n_bytes - offset;
-	  memset (bytes, 0, n_bytes);
-	  ret_bytes = n_bytes;
-	  ret_errno = 0;
-	}
-    }
-  else
-    ret_errno = EFAULT;
-  hfile->mutex.unlock();
+  const guint64 start = Bse::timestamp_benchmark();
+  const GslLong ret_bytes = hfile_pread_fd (hfile, offset, n_bytes, bytes);
+  const gint ret_errno = ret_bytes < 0 ? errno : 0;
+  hfile_account (hfile, 1, MAX (ret_bytes, 0), Bse::timestamp_benchmark() - start);
   errno = ret_errno;
   return ret_bytes;
 }
+
+/**
+ * @param hfile  valid GslHFile
+ * @param stats  location to store read statistics
+ *
+ * Retrieve read statistics accumulated by all users of @a hfile since it
+ * was first opened. The counters are updated without synchronization, so
+ * values read during concurrent reads may be slightly out of step.
+ * This function is MT-safe and may be called from any thread.
+ */
+void
+gsl_hfile_stats (GslHFile      *hfile,
+                 GslHFileStats *stats)
+{
+  assert_return (hfile != NULL);
+  assert_return (stats != NULL);
+  stats->n_reads = hfile->n_reads.load (std::memory_order_relaxed);
+  stats->n_bytes = hfile->n_read_bytes.load (std::memory_order_relaxed);
+  stats->read_nsecs = hfile->read_nsecs.load (std::memory_order_relaxed);
+}
 /**
  * @param hfile  valid GslHFile
  * @return offset of first zero byte or -1
@@ -288,6 +335,175 @@ gsl_hfile_zoffset (GslHFile *hfile)
   gsl_hfile_close (hfile);
   return zoffset;
 }
+/* pages of a mapping whose file got truncated raise SIGBUS when accessed, so only
+ * files that cannot shrink are mapped, others are read through gsl_hfile_pread()
+ */
+static bool
+hfile_cannot_shrink (gint               fd,
+                     const struct stat &statbuf)
+{
+#ifdef F_GET_SEALS
+  const int seals = fcntl (fd, F_GET_SEALS);
+  if (seals >= 0 && (seals & F_SEAL_SHRINK))
+    return true;
+#endif
+  struct statvfs vfsbuf;
+  if (fstatvfs (fd, &vfsbuf) == 0 && (vfsbuf.f_flag & ST_RDONLY))
+    return true;
+  return (statbuf.st_mode & (S_IWUSR | S_IWGRP | S_IWOTH)) == 0;
+}
+/**
+ * @param hfile  valid GslHFile
+ * @return       start of the read-only file mapping or NULL (errno set)
+ *
+ * Map the contents of a GslHFile into memory. The mapping is created
+ * lazily and shared by all users of @a hfile, i.e. by everyone who opened
+ * the same unmodified file, it stays valid until the last gsl_hfile_close().
+ * Returns NULL for empty files or if the file cannot be mapped, callers
+ * are expected to fall back to gsl_hfile_pread() in that case.
+ * Only sealed or read-only files are mapped, and only while their size
+ * and modification time match what gsl_hfile_open() recorded.
+ * This function is MT-safe and may be called from any thread.
+ */
+const guint8*
+gsl_hfile_mmap (GslHFile *hfile)
+{
+  errno = EFAULT;
+  assert_return (hfile != NULL, NULL);
+  assert_return (hfile->ocount > 0, NULL);
+  std::lock_guard<std::mutex> locker (hfile->mutex);
+  struct stat statbuf = { 0, };
+  const bool unchanged = (fstat (hfile->fd, &statbuf) == 0 && statbuf.st_size == hfile->n_bytes &&
+                          statbuf.st_mtim.tv_sec == hfile->mtime && statbuf.st_mtim.tv_nsec == hfile->mtime_nsecs);
+  if (!unchanged)
+    {
+      errno = ESTALE;
+      return NULL;
+    }
+  if (!hfile->mdata && !hfile->mmap_failed)
+    {
+      void *maddr = MAP_FAILED;
+      if (hfile->n_bytes > 0 && size_t (hfile->n_bytes) == guint64 (hfile->n_bytes) &&
+          hfile_cannot_shrink (hfile->fd, statbuf))
+        maddr = mmap (NULL, hfile->n_bytes, PROT_READ, MAP_SHARED, hfile->fd, 0);
+      if (maddr != MAP_FAILED)
+        {
+          madvise (maddr, hfile->n_bytes, MADV_SEQUENTIAL);
+          hfile->mdata = (guint8*) maddr;
+        }
+      else
+        {
+          hfile->mmap_failed = TRUE;
+          return NULL;
+        }
+    }
+  errno = hfile->mdata ? 0 : ENOMEM;
+  return hfile->mdata;
+}
+static String
+hfile_index_key (GslHFile    *hfile,
+                 const gchar *tag)
+{
+  /* use the file state recorded at open, the file may be replaced while hfile is open */
+  return Bse::beastbse_cachefile_key ("SEEKINDEX-2", hfile->file_name, hfile->mtime, hfile->mtime_nsecs, hfile->n_bytes) + tag + "\n";
+}
+static String
+hfile_index_path (GslHFile    *hfile,
+                  const gchar *tag)
+{
+  return Bse::beastbse_cachefile_path ("seekindex", Bse::string_format ("%s\n%s", hfile->file_name, tag));
+}
+/**
+ * @param hfile  valid GslHFile
+ * @param tag    identifies the kind of index and its parameters
+ * @param index  location to store the index
+ * @return       whether a matching index was found
+ *
+ * Load a seek index previously stored with gsl_hfile_index_store().
+ * Indexes are kept in a persistent cache directory and are keyed by
+ * file name, nanosecond modification time, size and the BSE version,
+ * so they become invalid once the file is modified or BSE is updated.
+ * Modification time and size are recorded by gsl_hfile_open(), so an
+ * open @a hfile keeps its indexes even if the file is replaced meanwhile.
+ * This function is MT-safe and may be called from any thread.
+ */
+bool
+gsl_hfile_index_load (GslHFile             *hfile,
+                      const gchar          *tag,
+                      std::vector<guint64> &index)
+{
+  assert_return (hfile != NULL, false);
+  assert_return (tag != NULL, false);
+  String data;
+  const String path = hfile_index_path (hfile, tag);
+  if (!Bse::beastbse_cachefile_read (path, hfile_index_key (hfile, tag), data))
+    return false;       /* missing, stale or hash collision */
+  utimensat (AT_FDCWD, path.c_str(), NULL, 0);  /* mark as recently used for gsl_hfile_index_cleanup() */
+  guint64 n_entries = 0;
+  if (data.size() < sizeof (n_entries))
+    return false;
+  memcpy (&n_entries, data.data(), sizeof (n_entries));
+  if (data.size() != sizeof (n_entries) + n_entries * sizeof (guint64))
+    return false;       /* truncated */
+  index.resize (n_entries);
+  memcpy (index.data(), data.data() + sizeof (n_entries), n_entries * sizeof (guint64));
+  return true;
+}
+/**
+ * @param hfile  valid GslHFile
+ * @param tag    identifies the kind of index and its parameters
+ * @param index  index values to store
+ *
+ * Store a seek index for @a hfile in the persistent cache directory, see
+ * gsl_hfile_index_load(). Failing to store an index is not an error,
+ * the index simply needs to be rebuilt next time.
+ * This function is MT-safe and may be called from any thread.
+ */
+void
+gsl_hfile_index_store (GslHFile                   *hfile,
+                       const gchar                *tag,
+                       const std::vector<guint64> &index)
+{
+  assert_return (hfile != NULL);
+  assert_return (tag != NULL);
+  const String key = hfile_index_key (hfile, tag), path = hfile_index_path (hfile, tag);
+  if (path.empty())
+    return;
+  const guint64 n_entries = index.size();
+  String data = key;
+  data.append ((const char*) &n_entries, sizeof (n_entries));
+  data.append ((const char*) index.data(), n_entries * sizeof (guint64));
+  Bse::beastbse_cachefile_write (path, data);
+}
+/**
+ * @param hfile  valid GslHFile
+ * @param tag    identifies the decoder and the part of @a hfile it decodes
+ * @return       non-zero identifier for the decoded contents
+ *
+ * Derive an identifier for data decoded from @a hfile, which is equal
+ * for all handles decoding the same unmodified file contents with equal
+ * @a tag, see GslDataHandle.content_id.
+ * This function is MT-safe and may be called from any thread.
+ */
+guint64
+gsl_hfile_content_id (GslHFile    *hfile,
+                      const gchar *tag)
+{
+  assert_return (hfile != NULL, 0);
+  assert_return (tag != NULL, 0);
+  const String key = hfile_index_key (hfile, tag);
+  return Bse::fnv1a_consthash64 (key.c_str()) | 1;
+}
+/**
+ * Remove the least recently used seek indexes, so the persistent
+ * cache directory used by gsl_hfile_index_store() stays bounded.
+ * This function is MT-safe and may be called from any thread.
+ */
+void
+gsl_hfile_index_cleanup (void)
+{
+  Bse::beastbse_cachedir_trim ("seekindex", 4096);
+}
 /**
  * @param file_name name of the file to open
  * @return          a new opened #GslRFile or NULL if an error occoured (errno set)
@@ -4,6 +4,8 @@
 
 #include <bse/gsldefs.hh>
 #include <bse/gslcommon.hh>
+#include <atomic>
+#include <vector>
 
 
 
@@ -13,12 +15,20 @@ typedef struct {
   GTime    mtime;
   GslLong  n_bytes;
   /*< private >*/
-  GslLong  cpos;
-  std::mutex mutex;
+  std::mutex mutex;     /* guards zoffset and mdata, reads are lock-free */
   gint     fd;
-  guint    ocount;
+  guint    mtime_nsecs; /* sub-second part of mtime */
+  std::atomic<guint> ocount;
   GslLong  zoffset;
+  guint8  *mdata;       /* shared read-only mapping or NULL */
+  guint    mmap_failed : 1;
+  std::atomic<guint64> n_reads, n_read_bytes, read_nsecs;
 } GslHFile;
+typedef struct {
+  guint64  n_reads;       /* number of read requests */
+  guint64  n_bytes;       /* number of bytes read */
+  guint64  read_nsecs;    /* time spent in read calls */
+} GslHFileStats;
 typedef struct {
   GslHFile *hfile;
   GslLong   offset;
@@ -31,8 +41,20 @@ GslLong	  gsl_hfile_pread	(GslHFile	*hfile,
 				 GslLong	 offset,
 				 GslLong         n_bytes,
 				 gpointer	 bytes);
+void	  gsl_hfile_stats	(GslHFile	*hfile,
+				 GslHFileStats	*stats);
 GslLong	  gsl_hfile_zoffset	(GslHFile	*hfile);
+const guint8* gsl_hfile_mmap	(GslHFile	*hfile);
 void	  gsl_hfile_close	(GslHFile	*hfile);
+bool	  gsl_hfile_index_load	(GslHFile	*hfile,
+				 const gchar	*tag,
+				 std::vector<guint64> &index);
+void	  gsl_hfile_index_store	(GslHFile	*hfile,
+				 const gchar	*tag,
+				 const std::vector<guint64> &index);
+guint64	  gsl_hfile_content_id	(GslHFile	*hfile,
+				 const gchar	*tag);
+void	  gsl_hfile_index_cleanup (void);
 
 
 /* --- GslRFile API --- */
@@ -18,8 +18,8 @@ Event::Event (EventType etype)
 {
   memset ((void*) this, 0, sizeof (*this));
   type = etype;
-  // one main design consideration is minimized size
-  static_assert (sizeof (Event) <= 2 * sizeof (void*));
+  // one main design consideration is minimized size, frame needs 16 bits for blocks of up to 1024 frames
+  static_assert (sizeof (Event) <= 3 * sizeof (void*));
 }
 
 Event&
@@ -160,44 +160,55 @@ make_pitch_bend (uint16 chnl, float val)
 }
 
 // == EventStream ==
-EventStream::EventStream ()
+EventStream::EventStream (uint32 capacity)
 {
-  events_.reserve (16);
+  reserve (capacity);
 }
 
-/// Append an Event with conscutive `frame` time stamp.
-void
-EventStream::append (int8_t frame, const Event &event)
+EventStream::~EventStream ()
 {
-  const bool out_of_order_event = append_unsorted (frame, event);
-  assert_return (!out_of_order_event);
+  fast_mem_free (events_);
 }
 
-/// Dangerous! Append an Event with enforcing sort order, violates constraints.
-/// Returns if ensure_order() must be called due to adding an out-of-order event.
-bool
-EventStream::append_unsorted (int8_t frame, const Event &event)
+/// Resize the event storage to `capacity` and reset overflows(), this allocates and must not be called from render().
+void
+EventStream::reserve (uint32 capacity)
 {
-  const int64_t last_event_stamp = !events_.empty() ? events_.back().frame : -128;
-  events_.push_back (event);
-  events_.back().frame = frame;
-  return frame < last_event_stamp;
+  Event *events = capacity ? (Event*) fast_mem_alloc (capacity * sizeof (Event)) : nullptr;
+  size_ = std::min (size_, capacity);
+  if (size_)
+    memcpy ((void*) events, events_, size_ * sizeof (Event));
+  fast_mem_free (events_);
+  events_ = events;
+  capacity_ = capacity;
+  overflows_ = 0;
 }
 
-/// Fix event order after append_unsorted() returned `true`.
+/// Insert an Event with `frame` time stamp after all events with the same or earlier stamps.
+/// Appending in order is O(1), events exceeding capacity() are dropped and counted in overflows().
 void
-EventStream::ensure_order ()
+EventStream::append (int16_t frame, const Event &event)
 {
-  std::stable_sort (events_.begin(), events_.end(), [] (const Event &a, const Event &b) -> bool {
-    return a.frame < b.frame;
-  });
+  if (BSE_UNLIKELY (size_ >= capacity_))
+    {
+      overflows_ += 1;
+      return;
+    }
+  uint32 i = size_;
+  while (i > 0 && events_[i - 1].frame > frame)
+    i--;
+  if (i < size_)        // guard against out-of-order events
+    memmove ((void*) (events_ + i + 1), events_ + i, (size_ - i) * sizeof (Event));
+  memcpy ((void*) (events_ + i), &event, sizeof (Event));
+  events_[i].frame = frame;
+  size_ += 1;
 }
 
 /// Fetch the latest event stamp, can be used to enforce order.
 int64_t
 EventStream::last_frame () const
 {
-  return !events_.empty() ? events_.back().frame : -128;
+  return size_ ? events_[size_ - 1].frame : -128;
 }
 
 // == EventRange ==
@@ -43,7 +43,7 @@ struct Event {
   constexpr static EventType PITCH_BEND       = EventType (0xE0);
   constexpr static EventType SYSEX            = EventType (0xF0);
   EventType type;       ///< Event type, one of the EventType members
-  int8      frame;      ///< Offset into current block, delayed if negative
+  int16     frame;      ///< Offset into current block, delayed if negative
   uint8     channel;    ///< 1…16 for standard events
   union {
     uint8   key;        ///< NOTE, KEY_PRESSURE MIDI note, 0…0x7f, 60 = middle C at 261.63 Hz.
@@ -82,20 +82,28 @@ Event make_control8   (uint16 chnl, uint prm, uint8 cval);
 Event make_program    (uint16 chnl, uint prgrm);
 Event make_pitch_bend (uint16 chnl, float val);
 
-/// A stream of writable Event structures.
+/// A stream of writable Event structures, ordered by frame.
+/// Events are stored in fixed capacity fast memory, so append() never allocates during render().
 class EventStream {
-  std::vector<Event> events_; // TODO: use O(1) allocator
+  Event   *events_ = nullptr;
+  uint32   size_ = 0;
+  uint32   capacity_ = 0;
+  uint32   overflows_ = 0;
   friend class EventRange;
+  BSE_CLASS_NON_COPYABLE (EventStream);
 public:
-  explicit     EventStream     ();
-  void         append          (int8_t frame, const Event &event);
-  const Event* begin           () const noexcept { return &*events_.begin(); }
-  const Event* end             () const noexcept { return &*events_.end(); }
-  size_t       size            () const noexcept { return events_.size(); }
-  bool         empty           () const noexcept { return events_.empty(); }
-  void         clear           () noexcept       { events_.clear(); }
-  bool         append_unsorted (int8_t frame, const Event &event);
-  void         ensure_order    ();
+  static constexpr uint32 DEFAULT_CAPACITY = 256;
+  explicit     EventStream     (uint32 capacity = 0);
+  /*dtor*/    ~EventStream     ();
+  void         append          (int16_t frame, const Event &event);
+  const Event* begin           () const noexcept { return events_; }
+  const Event* end             () const noexcept { return events_ + size_; }
+  size_t       size            () const noexcept { return size_; }
+  bool         empty           () const noexcept { return size_ == 0; }
+  void         clear           () noexcept       { size_ = 0; }
+  size_t       capacity        () const noexcept { return capacity_; }
+  uint32       overflows       () const noexcept { return overflows_; }
+  void         reserve         (uint32 capacity);
   int64_t      last_frame      () const BSE_PURE;
 };
 
@@ -194,7 +194,7 @@ public:
   void
   enqueue_until_frame (const int64_t frame)
   {
-    assert_return (frame >= -128 && frame <= 127);
+    assert_return (frame >= INT16_MIN && frame <= INT16_MAX);
     EventStream &evout = get_event_output();
     // interleave with earlier MIDI through events
     while (midi_through < midi_through_end && midi_through->frame <= frame)
@@ -206,7 +206,7 @@ public:
   void
   enqueue_at_frame (const int64_t frame, const Event &event)
   {
-    assert_return (frame >= -128 && frame <= 127);
+    assert_return (frame >= INT16_MIN && frame <= INT16_MAX);
     // interleave with earlier MIDI through events
     enqueue_until_frame (frame);
     EventStream &evout = get_event_output();
@@ -223,7 +223,7 @@ public:
     Module (monitor_module_class),
     char8_ (mfields)
   {
-    fblock_ = (float*) fast_mem_alloc (BSE_ENGINE_MAX_BLOCK_SIZE * sizeof (float));
+    fblock_ = (float*) fast_mem_alloc (bse_engine_max_block_size() * sizeof (float));
     assert_return (fblock_ != nullptr);
   }
   virtual ~MonitorModule()
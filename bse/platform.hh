@@ -136,6 +136,12 @@ extern inline void breakpoint               () BSE_ALWAYS_INLINE;       ///< Cau
 #endif
 /// Compiler Fence, prevent compiler from reordering non-volatile loads/stores, see also std::atomic_signal_fence().
 #define  BSE_CFENCE __asm__ __volatile__ ("" ::: "memory")
+/// Spin-wait hint, lets the processor relax busy loops that poll atomic variables.
+#if defined __x86_64__ || defined __amd64__ || defined __i386__
+#define  BSE_CPU_RELAX() __builtin_ia32_pause()
+#else
+#define  BSE_CPU_RELAX() BSE_CFENCE
+#endif
 
 // == Implementation Details ==
 #if (defined __i386__ || defined __x86_64__)
@@ -4,7 +4,11 @@
 #include "bseserver.hh"
 #include "combo.hh"
 #include "internal.hh"
+#include "storage.hh"
+#include "testing.hh"
 #include <shared_mutex>
+#include <dlfcn.h>
+#include <unistd.h>
 
 #define PDEBUG(...)     Bse::debug ("processor", __VA_ARGS__)
 
@@ -383,12 +387,15 @@ Processor::Processor() :
 {
   assert_return (processor_ctor_registry_context->engine != nullptr);
   processor_ctor_registry_context->engine = nullptr; // consumed
+  pqueue_ = new ParamQueue();
 }
 
 /// The destructor is called when the last std::shared_ptr<> reference drops.
 Processor::~Processor ()
 {
   remove_all_buses();
+  delete pqueue_;
+  pqueue_ = nullptr;
 }
 
 /// Create the `Bse::ProcessorIface` for `this`.
@@ -420,7 +427,8 @@ Processor::access_processor () const
 const Processor::FloatBuffer&
 Processor::zero_buffer()
 {
-  static const FloatBuffer const_zero_float_buffer {};
+  alignas (64) static float const_zero_floats[MAX_RENDER_BLOCK_SIZE] = { 0, };
+  static const FloatBuffer const_zero_float_buffer { const_zero_floats };
   return const_zero_float_buffer;
 }
 
@@ -481,9 +489,22 @@ Processor::assign_iobufs ()
   fast_mem_free (fbuffers_);
   if (ochannel_count > 0)
     {
-      fbuffers_ = (FloatBuffer*) fast_mem_alloc (ochannel_count * sizeof (FloatBuffer));
+      // FloatBuffer array, followed by cache-line aligned float blocks, each followed by canaries
+      const size_t header = (ochannel_count * sizeof (FloatBuffer) + 63) & ~size_t (63);
+      const size_t stride = engine_.max_block_size() + FloatBuffer::canary_floats;
+      char *mem = (char*) fast_mem_alloc (header + ochannel_count * stride * sizeof (float));
+      assert_return (0 == (uintptr_t (mem) & 63));
+      fbuffers_ = (FloatBuffer*) mem;
+      float *fblocks = (float*) (mem + header);
       for (ssize_t i = 0; i < ochannel_count; i++)
-        new (fbuffers_ + i) FloatBuffer();
+        {
+          float *fblock = fblocks + i * stride;
+          floatfill (fblock, 0.0, engine_.max_block_size());
+          uint64 *canaries = (uint64*) (fblock + engine_.max_block_size());
+          for (uint j = 0; j < FloatBuffer::canary_floats * sizeof (float) / sizeof (uint64); j++)
+            canaries[j] = FloatBuffer::const_canary;
+          new (fbuffers_ + i) FloatBuffer (fblock);
+        }
     }
   else
     fbuffers_ = nullptr;
@@ -693,7 +714,14 @@ Processor::set_param (Id32 paramid, const double value)
 {
   const PParam *pparam = find_pparam (ParamId (paramid.id));
   return_unless (pparam);
-  const ParamInfo *info = pparam->info.get();
+  const_cast<PParam*> (pparam)->assign (constrain_param (*pparam, value));
+}
+
+// Clamp `value` into the range of `pparam` and quantize it to the parameter stepping.
+double
+Processor::constrain_param (const PParam &pparam, double value)
+{
+  const ParamInfo *info = pparam.info.get();
   double v = value;
   if (info)
     {
@@ -710,7 +738,7 @@ Processor::set_param (Id32 paramid, const double value)
           v = CLAMP (mm.first + v, mm.first, mm.second);
         }
     }
-  const_cast<PParam*> (pparam)->assign (v);
+  return v;
 }
 
 /// Retrieve supplemental information for parameters, usually to enhance the user interface.
@@ -754,6 +782,135 @@ Processor::param_notifies_mt (ProcessorP proc, Id32 paramid, bool need_notifies)
     const_cast<PParam*> (param)->must_notify_mt (need_notifies);
 }
 
+// Processor internal queue of scheduled parameter changes
+struct Processor::ParamQueue {
+  struct Node : FastMemory::NewDeleteBase {
+    Node   *next = nullptr;
+    uint64  stamp = 0;
+    ParamId id = {};
+    double  value = 0;
+  };
+  std::atomic<Node*>      intake { nullptr };       // lock-free LIFO, pushed from any thread
+  std::vector<Node*>      pending;                  // engine thread only, ordered by stamp
+  std::vector<ParamEvent> events;                   // ParamEvent list of the current block
+  bool                    sample_accurate = false;
+  static constexpr size_t DEFAULT_CAPACITY = 256;
+  bool
+  busy () const
+  {
+    return intake.load (std::memory_order_relaxed) || !pending.empty() || !events.empty();
+  }
+  void
+  collect ()
+  {
+    Node *node = intake.exchange (nullptr);
+    return_unless (node);
+    const size_t first = pending.size();
+    for (; node; node = node->next)
+      pending.push_back (node);
+    std::reverse (pending.begin() + first, pending.end());      // restore FIFO order
+    const auto stamp_cmp = [] (const Node *a, const Node *b) { return a->stamp < b->stamp; };
+    if (!std::is_sorted (pending.begin() + (first ? first - 1 : 0), pending.end(), stamp_cmp))
+      std::stable_sort (pending.begin(), pending.end(), stamp_cmp);
+  }
+  ~ParamQueue()
+  {
+    collect();
+    for (Node *node : pending)
+      delete node;
+  }
+};
+
+/// Schedule parameter `paramid` to change to `value` at the Engine::frame_counter() position `frame_stamp`.
+/// Changes at stamps that have already been rendered (e.g. 0) take effect with the next block.
+/// Processors that called prepare_param_events() receive the change via get_param_events(),
+/// for all other processors set_param() is applied at the start of the block.
+/// This function is MT-Safe after proper Processor initialization.
+void
+Processor::param_schedule_mt (ProcessorP proc, Id32 paramid, double value, uint64 frame_stamp)
+{
+  assert_return (proc);
+  assert_return (proc->is_initialized());
+  ParamQueue::Node *node = new ParamQueue::Node();
+  node->stamp = frame_stamp;
+  node->id = ParamId (paramid.id);
+  node->value = value;
+  ParamQueue &pq = *proc->pqueue_;
+  node->next = pq.intake.load();
+  while (!pq.intake.compare_exchange_weak (node->next, node))
+    ;
+}
+
+/// Change parameter `paramid` to `value` with the next rendered block, or right away if `proc` is not rendered.
+/// The schedule is locked while `value` is applied, so `proc` cannot enter or leave it meanwhile.
+/// This function is MT-Safe after proper Processor initialization.
+void
+Processor::param_apply_mt (ProcessorP proc, Id32 paramid, double value)
+{
+  assert_return (proc);
+  Engine &engine = proc->engine_;
+  std::lock_guard<std::mutex> locker (engine.mutex_);
+  if (BSE_SERVER.engine_active() && engine.in_schedule (*proc))
+    param_schedule_mt (proc, paramid, value);
+  else
+    proc->set_param (paramid, value);
+}
+
+/// Request sample accurate delivery of parameter changes scheduled via param_schedule_mt().
+/// Instead of applying them at block boundaries, the changes of each block are provided to
+/// render() via get_param_events(). Changes not applied by render() via set_param() are
+/// assigned afterwards, so parameter values and `dirty` flags catch up at the block end.
+void
+Processor::prepare_param_events ()
+{
+  pqueue_->sample_accurate = true;
+  // avoid allocations during render()
+  pqueue_->pending.reserve (ParamQueue::DEFAULT_CAPACITY);
+  pqueue_->events.reserve (ParamQueue::DEFAULT_CAPACITY);
+}
+
+/// Access the parameter changes of the current block during render(), needs prepare_param_events().
+ParamEventRange
+Processor::get_param_events () const
+{
+  const std::vector<ParamEvent> &events = pqueue_->events;
+  return ParamEventRange (events.data(), events.data() + events.size());
+}
+
+// Move scheduled parameter changes of the current block into set_param() or the ParamEvent list.
+void
+Processor::dispatch_param_events (uint n_frames)
+{
+  ParamQueue &pq = *pqueue_;
+  pq.events.clear();
+  pq.collect();
+  const uint64 block_end = engine_.frame_counter(), block_start = block_end - n_frames;
+  size_t i;
+  for (i = 0; i < pq.pending.size() && pq.pending[i]->stamp < block_end; i++)
+    {
+      ParamQueue::Node *node = pq.pending[i];
+      const PParam *pparam = find_pparam (node->id);
+      if (BSE_ISLIKELY (pparam))
+        {
+          if (pq.sample_accurate)
+            pq.events.push_back ({ uint32 (std::max (node->stamp, block_start) - block_start), node->id,
+                                   constrain_param (*pparam, node->value) });
+          else
+            const_cast<PParam*> (pparam)->assign (constrain_param (*pparam, node->value));
+        }
+      delete node;
+    }
+  pq.pending.erase (pq.pending.begin(), pq.pending.begin() + i);
+}
+
+// Assign the ParamEvent values of the current block after render().
+void
+Processor::flush_param_events ()
+{
+  for (const ParamEvent &ev : pqueue_->events)
+    set_param (ev.id, ev.value);
+}
+
 double
 Processor::value_to_normalized (Id32 paramid, double value) const
 {
@@ -920,6 +1077,21 @@ Processor::prepare_event_output ()
     estreams_ = new EventStreams();
   assert_return (estreams_->has_event_output == false);
   estreams_->has_event_output = true;
+  estreams_->estream.reserve (EventStream::DEFAULT_CAPACITY);
+}
+
+// Grow the event output stream after overflows, called by Engine::make_schedule() outside of render().
+void
+Processor::negotiate_event_capacity ()
+{
+  return_unless (estreams_ && estreams_->has_event_output);
+  EventStream &estream = estreams_->estream;
+  if (estream.overflows())
+    {
+      const uint32 capacity = std::max (2 * estream.capacity(), size_t (EventStream::DEFAULT_CAPACITY));
+      PDEBUG ("%s: event stream overflowed (%u), growing capacity: %u", debug_name(), estream.overflows(), capacity);
+      estream.reserve (capacity);
+    }
 }
 
 /// Access the current output EventStream during render(), needs prepare_event_input().
@@ -940,7 +1112,7 @@ Processor::disconnect_event_input()
       assert_return (oproc.estreams_);
       const bool backlink = vector_erase_element (oproc.outputs_, { this, EventStreams::EVENT_ISTREAM });
       estreams_->oproc = nullptr;
-      engine_.reschedule();
+      engine_.reschedule (*this);
       assert_return (backlink == true);
       enqueue_notify_mt (BUSDISCONNECT);
       oproc.enqueue_notify_mt (BUSDISCONNECT);
@@ -958,7 +1130,7 @@ Processor::connect_event_input (Processor &oproc)
   estreams_->oproc = &oproc;
   // register backlink
   oproc.outputs_.push_back ({ this, EventStreams::EVENT_ISTREAM });
-  engine_.reschedule();
+  engine_.reschedule (*this);
   enqueue_notify_mt (BUSCONNECT);
   oproc.enqueue_notify_mt (BUSCONNECT);
 }
@@ -1082,7 +1254,7 @@ void
 Processor::assign_oblock (OBusId b, uint c, float v)
 {
   float *const buffer = oblock (b, c);
-  floatfill (buffer, v, MAX_RENDER_BLOCK_SIZE);
+  floatfill (buffer, v, engine_.block_size());
   // TODO: optimize assign_oblock() via redirect to const value blocks
 }
 
@@ -1108,7 +1280,7 @@ Processor::remove_all_buses ()
       assert_return (!estreams_->oproc && outputs_.empty());
       delete estreams_; // must be disconnected beforehand
       estreams_ = nullptr;
-      engine_.reschedule();
+      engine_.reschedule (*this);
     }
 }
 
@@ -1118,7 +1290,7 @@ Processor::disconnect_ibuses()
 {
   disconnect (EventStreams::EVENT_ISTREAM);
   if (n_ibuses())
-    engine_.reschedule();
+    engine_.reschedule (*this);
   for (size_t i = 0; i < n_ibuses(); i++)
     disconnect (IBusId (1 + i));
 }
@@ -1129,7 +1301,7 @@ Processor::disconnect_obuses()
 {
   return_unless (fbuffers_);
   if (outputs_.size())
-    engine_.reschedule();
+    engine_.reschedule (*this);
   while (outputs_.size())
     {
       const auto o = outputs_.back();
@@ -1157,7 +1329,7 @@ Processor::disconnect (IBusId ibusid)
   const bool backlink = vector_erase_element (oproc.outputs_, { this, ibusid });
   ibus.proc = nullptr;
   ibus.obusid = {};
-  engine_.reschedule();
+  engine_.reschedule (*this);
   assert_return (backlink == true);
   enqueue_notify_mt (BUSDISCONNECT);
   oproc.enqueue_notify_mt (BUSDISCONNECT);
@@ -1186,7 +1358,7 @@ Processor::connect (IBusId ibusid, Processor &oproc, OBusId obusid)
   // register backlink
   obus.fbuffer_concounter += 1; // conection counter
   oproc.outputs_.push_back ({ this, ibusid });
-  engine_.reschedule();
+  engine_.reschedule (*this);
   enqueue_notify_mt (BUSCONNECT);
   oproc.enqueue_notify_mt (BUSCONNECT);
 }
@@ -1242,7 +1414,7 @@ Processor::enqueue_deps()
       if (ibus.proc)
         engine_.enqueue (*ibus.proc);
     }
-  enqueue_children();
+  engine_.enqueue_children (*this);
 }
 
 /** Method called for every audio buffer to be processed.
@@ -1265,10 +1437,35 @@ Processor::render_block ()
   return_unless (done_frames_ < engine_frame_counter);
   if (BSE_UNLIKELY (estreams_) && !BSE_ISLIKELY (estreams_->estream.empty()))
     estreams_->estream.clear();
-  render (MAX_RENDER_BLOCK_SIZE);
+  const uint n_frames = engine_.block_size();
+  if (BSE_UNLIKELY (pqueue_->busy()))
+    dispatch_param_events (n_frames);
+  const uint64 t0 = timestamp_benchmark();
+  render (n_frames);
+  const uint64 nsecs = timestamp_benchmark() - t0;
+  if (BSE_UNLIKELY (!pqueue_->events.empty()))
+    flush_param_events();
+  if (BSE_UNLIKELY (estreams_) && BSE_UNLIKELY (estreams_->estream.overflows()))
+    engine_.reschedule();       // grow capacity outside of render()
+  render_nsecs_ += nsecs;
+  if (BSE_UNLIKELY (telemetry_))
+    {
+      const float block_nsecs = n_frames * 1000000000.0 / sample_rate();
+      telemetry_->cpu_load = 0.95 * telemetry_->cpu_load + 0.05 * (nsecs / block_nsecs);
+      telemetry_->render_nsecs = std::min<uint64> (nsecs, 0xffffffff);
+    }
   done_frames_ = engine_frame_counter;
 }
 
+/// Assign memory for render statistics, updated after each render() call, must be called from the engine thread.
+void
+Processor::telemetry (ProcessorTelemetry *ptelemetry)
+{
+  telemetry_ = ptelemetry;
+  if (telemetry_)
+    *telemetry_ = ProcessorTelemetry();
+}
+
 /// Invoke Processor::configure() with `ipatch`/`opatch` applied to the current configuration.
 void
 Processor::reconfigure (IBusId ibusid, SpeakerArrangement ipatch, OBusId obusid, SpeakerArrangement opatch)
@@ -1407,12 +1604,148 @@ Processor::registry_enroll (MakeProcessor create, const char *bfile, int bline)
   return { *entry };
 }
 
+// == RegistryCache ==
+// ProcessorInfo of enrolled types per binary, so registry_init() needs no test instances for unmodified binaries
+struct RegistryCache {
+  String cachefile, key;
+  std::unordered_map<String, StringVector> infos;  // info fields per enrollment, empty if unlisted
+  std::unordered_map<String, uint> occurrences;    // disambiguates repeated enrollments from one location
+  bool dirty = false;
+  static constexpr const size_t N_FIELDS = 9;
+  static constexpr const size_t N_LINES = 2 + N_FIELDS;
+  static CString*
+  field (ProcessorInfo &info, size_t i)
+  {
+    CString *fields[N_FIELDS] = { &info.uri, &info.version, &info.label, &info.category, &info.blurb,
+                                  &info.description, &info.website_url, &info.creator_name, &info.creator_url };
+    return fields[i];
+  }
+  void
+  load (const String &binary)
+  {
+    key = beastbse_cachefile_key ("PROCESSOR-INFO-1", binary);
+    cachefile = key.empty() ? "" : beastbse_cachefile_path ("processors", binary);
+    String payload;
+    if (!beastbse_cachefile_read (cachefile, key, payload))
+      return;
+    // lines: id, listed flag and info fields per enrollment, empty last line
+    const StringVector lines = string_split (payload, "\n");
+    if (lines.empty() || !lines.back().empty() || (lines.size() - 1) % N_LINES)
+      return;
+    for (size_t i = 0; i + N_LINES <= lines.size(); i += N_LINES)
+      {
+        StringVector &fields = infos[string_from_cquote (lines[i])];
+        fields.clear();
+        if (lines[i + 1] == "1")
+          for (size_t j = 0; j < N_FIELDS; j++)
+            fields.push_back (string_from_cquote (lines[i + 2 + j]));
+      }
+  }
+  void
+  store ()
+  {
+    if (!dirty || cachefile.empty())
+      return;
+    String data = key;
+    for (const auto &it : infos)
+      {
+        data += string_to_cquote (it.first) + "\n" + (it.second.empty() ? "0" : "1") + "\n";
+        for (size_t j = 0; j < N_FIELDS; j++)
+          data += string_to_cquote (it.second.empty() ? "" : it.second[j]) + "\n";
+      }
+    beastbse_cachefile_write (cachefile, data);
+    dirty = false;
+  }
+  // Fetch cached info about an enrollment at `file:line`, returns false if unknown
+  bool
+  lookup (const String &id, ProcessorInfo &info, bool &listed)
+  {
+    auto it = infos.find (id);
+    if (it == infos.end())
+      return false;
+    listed = !it->second.empty();
+    for (size_t j = 0; listed && j < N_FIELDS; j++)
+      *field (info, j) = it->second[j];
+    return true;
+  }
+  void
+  update (const String &id, ProcessorInfo &info, bool listed)
+  {
+    StringVector &fields = infos[id];
+    fields.clear();
+    for (size_t j = 0; listed && j < N_FIELDS; j++)
+      fields.push_back (*field (info, j));
+    dirty = true;
+  }
+};
+static PersistentStaticInstance<std::unordered_map<String, RegistryCache>> processor_registry_caches;
+
+static RegistryCache*
+registry_cache_for (Processor::MakeProcessor create)
+{
+  Dl_info dlinfo = { 0, };
+  if (!dladdr ((void*) create, &dlinfo) || !dlinfo.dli_fname)
+    return nullptr;
+  const String binary = dlinfo.dli_fname;
+  auto it = processor_registry_caches->find (binary);
+  if (it != processor_registry_caches->end())
+    return &it->second;
+  RegistryCache &cache = (*processor_registry_caches)[binary];
+  cache.load (binary);
+  return &cache;
+}
+
+BSE_INTEGRITY_TEST (bse_processor_test_registry_cache);
+static void
+bse_processor_test_registry_cache()
+{
+  char fname[] = "/tmp/bseprocessor-cache-XXXXXX";
+  const int fd = mkstemp (fname);
+  TASSERT (fd >= 0);
+  TASSERT (write (fd, "binary", 6) == 6);
+  ProcessorInfo info, loaded;
+  info.uri = "Bse.Test.CachedProcessor";
+  info.version = "1";
+  info.label = "Cached \"Processor\"";
+  info.description = "Multi\nline description";
+  bool listed = false;
+  // round trip, including enrollments that yield no Processor
+  RegistryCache cache;
+  cache.load (fname);
+  TASSERT (!cache.lookup ("cached.cc:17#0", loaded, listed));
+  cache.update ("cached.cc:17#0", info, true);
+  cache.update ("cached.cc:23#0", info, false);
+  cache.store();
+  RegistryCache cache2;
+  cache2.load (fname);
+  TASSERT (cache2.lookup ("cached.cc:17#0", loaded, listed) && listed);
+  for (size_t j = 0; j < RegistryCache::N_FIELDS; j++)
+    TCMP (RegistryCache::field (loaded, j)->string(), ==, RegistryCache::field (info, j)->string());
+  TASSERT (cache2.lookup ("cached.cc:23#0", loaded, listed) && !listed);
+  TASSERT (!cache2.lookup ("cached.cc:17#1", loaded, listed));
+  // modifying the binary invalidates its cache entries
+  TASSERT (write (fd, "!", 1) == 1);
+  close (fd);
+  RegistryCache cache3;
+  cache3.load (fname);
+  TASSERT (!cache3.lookup ("cached.cc:17#0", loaded, listed));
+  unlink (beastbse_cachefile_path ("processors", fname).c_str());
+  unlink (fname);
+}
+
+static Engine&
+registry_engine()
+{
+  static AudioTiming audio_timing { 120, 1024 * 1024 };
+  static Engine regengine (48000, audio_timing, []() {}); // used only for registration
+  return regengine;
+}
+
 // Ensure all registration entries have been examined
 void
 Processor::registry_init()
 {
-  static AudioTiming audio_timing { 120, 1024 * 1024 };
-  static Engine regengine (48000, audio_timing, []() {}); // used only for registration
+  bool used_regengine = false;
   while (processor_registry_entries)
     {
       std::lock_guard<std::recursive_mutex> rlocker (processor_registry_mutex);
@@ -1423,15 +1756,33 @@ Processor::registry_init()
       // register all
       while (entry)
         {
-          ProcessorRegistryContext *const saved = processor_ctor_registry_context;
-          ProcessorRegistryContext context { &regengine };
-          processor_ctor_registry_context = &context;
-          ProcessorP testproc = entry->create (nullptr);
-          processor_ctor_registry_context = saved;
-          if (testproc)
+          RegistryCache *cache = registry_cache_for (entry->create);
+          String id;
+          bool listed = false;
+          if (cache)
+            {
+              id = string_format ("%s:%d", entry->file, entry->line);
+              id += string_format ("#%u", cache->occurrences[id]++);
+            }
+          if (!cache || !cache->lookup (id, *entry, listed))
+            {
+              ProcessorRegistryContext *const saved = processor_ctor_registry_context;
+              ProcessorRegistryContext context { &registry_engine() };
+              used_regengine = true;
+              processor_ctor_registry_context = &context;
+              ProcessorP testproc = entry->create (nullptr);
+              processor_ctor_registry_context = saved;
+              listed = testproc != nullptr;
+              if (testproc)
+                {
+                  testproc->query_info (*entry);
+                  testproc = nullptr;
+                }
+              if (cache)
+                cache->update (id, *entry, listed);
+            }
+          if (listed)
             {
-              testproc->query_info (*entry);
-              testproc = nullptr;
               if (entry->uri.empty())
                 warning ("invalid empty URI for Processor: %s:%d", entry->file, entry->line);
               else
@@ -1446,9 +1797,12 @@ Processor::registry_init()
           entry = old->next;
           // unlisted entries are left dangling for registry_create(RegistryId,std::any)
         }
+      for (auto &it : *processor_registry_caches)
+        it.second.store();
     }
-  while (regengine.ipc_pending())
-    regengine.ipc_dispatch(); // empty any work queues
+  if (used_regengine)
+    while (registry_engine().ipc_pending())
+      registry_engine().ipc_dispatch(); // empty any work queues
 }
 
 /// Create a new Processor object of the type specified by `uuiduri`.
@@ -1532,22 +1886,17 @@ Processor::PParam::operator= (const PParam &src)
 }
 
 // == FloatBuffer ==
-/// Check for end-of-buffer overwrites
+/// Check for end-of-buffer overwrites, `n_frames` is the Engine::max_block_size() of #fblock.
 void
-Processor::FloatBuffer::check ()
-{
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Winvalid-offsetof"
-  // verify cache-line aligned struct layout
-  static_assert (0 == (offsetof (FloatBuffer, fblock[0]) & 63));
-  static_assert (0 == (offsetof (FloatBuffer, canary0_) & 63));
-  static_assert (0 == ((sizeof (buffer) + offsetof (FloatBuffer, buffer)) & 63));
-#pragma GCC diagnostic pop
+Processor::FloatBuffer::check (uint n_frames)
+{
   // verify cache-line aligned runtime layout
-  assert_return (0 == (uintptr_t (&buffer[0]) & 63));
+  assert_return (0 == (uintptr_t (&fblock[0]) & 63));
+  assert_return (0 == (n_frames & 15));
   // failing canaries indicate end-of-buffer overwrites
-  assert_return (canary0_ == const_canary);
-  assert_return (canary1_ == const_canary);
+  const uint64 *canaries = (const uint64*) (fblock + n_frames);
+  for (uint j = 0; j < canary_floats * sizeof (float) / sizeof (uint64); j++)
+    assert_return (canaries[j] == const_canary);
 }
 
 } // AudioSignal
@@ -1585,15 +1934,15 @@ public:
   {
     return proc_->value_to_normalized (info_->id, AudioSignal::Processor::param_peek_mt (proc_, info_->id));
   }
+  void
+  apply_value (double value)
+  {
+    AudioSignal::Processor::param_apply_mt (proc_, info_->id, value);
+  }
   bool
   set_normalized (double v) override
   {
-    AudioSignal::ProcessorP proc = proc_;
-    const AudioSignal::ParamId pid = info_->id;
-    auto lambda = [proc, pid, v] () {
-      proc->set_normalized (pid, v);
-    };
-    BSE_SERVER.commit_job (lambda);
+    apply_value (proc_->value_from_normalized (info_->id, CLAMP (v, 0.0, 1.0)));
     return true;
   }
   std::string
@@ -1605,14 +1954,7 @@ public:
   bool
   set_text (const std::string &v) override
   {
-    const double value = proc_->param_value_from_text (info_->id, v);
-    const double normalized = proc_->value_to_normalized (info_->id, value);
-    AudioSignal::ProcessorP proc = proc_;
-    const AudioSignal::ParamId pid = info_->id;
-    auto lambda = [proc, pid, normalized] () {
-      proc->set_normalized (pid, normalized);
-    };
-    BSE_SERVER.commit_job (lambda);
+    apply_value (proc_->param_value_from_text (info_->id, v));
     return true;
   }
   bool
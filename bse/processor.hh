@@ -15,8 +15,8 @@ class ComboImpl;
 
 namespace AudioSignal {
 
-/// Maximum number of sample frames to calculate in Processor::render().
-constexpr const uint MAX_RENDER_BLOCK_SIZE = 128;
+/// Upper limit for Engine::max_block_size(), the number of sample frames to calculate in Processor::render().
+constexpr const uint MAX_RENDER_BLOCK_SIZE = 1024;
 
 /// Main handle for Processor administration and audio rendering.
 class Engine;
@@ -176,6 +176,30 @@ struct BusInfo {
   uint               n_channels () const;
 };
 
+/// Render statistics of a Processor, memory layout matches Bse::DeviceTelemetry.
+struct ProcessorTelemetry {
+  float  cpu_load = 0;          ///< Smoothed render() time as fraction of the block duration.
+  uint32 render_nsecs = 0;      ///< Time spent in the last render() call in nanoseconds.
+};
+
+/// Parameter change scheduled for a sample frame of the current render() block.
+struct ParamEvent {
+  uint32  frame = 0;    ///< Offset into the current block.
+  ParamId id = {};      ///< Parameter to change.
+  double  value = 0;    ///< New value, clamped and quantized like Processor::set_param().
+};
+
+/// A readonly view of the ParamEvent list of the current block, ordered by frame.
+class ParamEventRange {
+  const ParamEvent *begin_, *end_;
+public:
+  const ParamEvent* begin   () const    { return begin_; }
+  const ParamEvent* end     () const    { return end_; }
+  size_t            size    () const    { return end_ - begin_; }
+  bool              empty   () const    { return begin_ == end_; }
+  explicit          ParamEventRange (const ParamEvent *b, const ParamEvent *e) : begin_ (b), end_ (e) {}
+};
+
 /// Audio signal Processor base class, implemented by all effects and instruments.
 class Processor : public std::enable_shared_from_this<Processor>, public FastMemory::NewDeleteBase {
   struct IBus;
@@ -183,6 +207,7 @@ class Processor : public std::enable_shared_from_this<Processor>, public FastMem
   struct EventStreams;
   union  PBus;
   struct PParam;
+  struct ParamQueue;
   class FloatBuffer;
   friend class ProcessorManager;
   friend class Engine;
@@ -219,10 +244,18 @@ private:
   std::vector<PParam>      params_;
   std::vector<OConnection> outputs_;
   EventStreams            *estreams_ = nullptr;
+  ParamQueue              *pqueue_ = nullptr;
   uint64_t                 done_frames_ = 0;
+  std::atomic<uint64>      schedule_stamp_ { 0 };
+  uint64                   render_nsecs_ = 0;
+  ProcessorTelemetry      *telemetry_ = nullptr;
   static void        registry_init      ();
   const PParam*      find_pparam        (Id32 paramid) const;
   const PParam*      find_pparam_       (ParamId paramid) const;
+  static double      constrain_param    (const PParam &pparam, double value);
+  void               dispatch_param_events (uint n_frames);
+  void               flush_param_events ();
+  void               negotiate_event_capacity ();
   void               assign_iobufs      ();
   void               release_iobufs     ();
   void               reconfigure        (IBusId ibus, SpeakerArrangement ipatch, OBusId obus, SpeakerArrangement opatch);
@@ -273,6 +306,8 @@ protected:
                                    bool boolvalue, std::string hints = "",
                                    const std::string &blurb = "", const std::string &description = "");
   double        peek_param_mt     (Id32 paramid) const;
+  void          prepare_param_events ();
+  ParamEventRange get_param_events () const;
   // Buses
   IBusId        add_input_bus     (CString uilabel, SpeakerArrangement speakerarrangement,
                                    const std::string &hints = "", const std::string &blurb = "");
@@ -333,8 +368,8 @@ public:
   BusInfo       bus_info          (IBusId busid) const;
   BusInfo       bus_info          (OBusId busid) const;
   bool          connected         (OBusId obusid) const;
-  bool          iseemless         (IBusId b, uint c, uint n_frames = MAX_RENDER_BLOCK_SIZE) const;
-  bool          iconst            (IBusId b, uint c, uint n_frames = MAX_RENDER_BLOCK_SIZE) const;
+  bool          iseemless         (IBusId b, uint c, uint n_frames) const;
+  bool          iconst            (IBusId b, uint c, uint n_frames) const;
   const float*  ifloats           (IBusId b, uint c) const;
   const float*  ofloats           (OBusId b, uint c) const;
   static uint64 timestamp         ();
@@ -343,6 +378,8 @@ public:
   void          connect_event_input    (Processor &oproc);
   void          disconnect_event_input ();
   ProcessorImplP access_processor () const;
+  uint64        render_nsecs      () const      { return render_nsecs_; }
+  void          telemetry         (ProcessorTelemetry *ptelemetry);
   // Registration and factory
   static RegistryList  registry_list      ();
   static ProcessorP    registry_create    (Engine &engine, const std::string &uuiduri);
@@ -351,6 +388,8 @@ public:
   // MT-Safe accessors
   static double param_peek_mt     (const ProcessorP proc, Id32 paramid);
   static void   param_notifies_mt (ProcessorP proc, Id32 paramid, bool need_notifies);
+  static void   param_schedule_mt (ProcessorP proc, Id32 paramid, double value, uint64 frame_stamp = 0);
+  static void   param_apply_mt    (ProcessorP proc, Id32 paramid, double value);
 private:
   static bool   has_notifies_e    ();
   static void   call_notifies_e   ();
@@ -369,52 +408,69 @@ struct AudioTiming {
 
 /// Audio processing setup and engine for concurrent rendering.
 class Engine {
+  class RenderPool;
+  struct ScheduleFrame;
+  using ScheduleEdge = std::pair<Processor*,Processor*>; // (dependency, dependent)
   const double       nyquist_;  ///< Half the `sample_rate`.
   const double       inyquist_; ///< Inverse Nyquist frequency, i.e. 1.0 / nyquist_;
   const uint         sample_rate_; ///< Sample rate (mixing frequency) in Hz used for Processor::render().
+  const uint         max_block_size_; ///< Maximum number of frames per render_block(), sizes all FloatBuffers.
+  uint               block_size_;  ///< Number of frames rendered by the current render_block().
   uint64_t           frame_counter_;
   std::atomic<uint32> eflags_;
-  enum { RESCHEDULE = 1 << 0, WOKEN = 1 << 1, };
+  enum { RESCHEDULE = 1 << 0, WOKEN = 1 << 1, EXTEND = 1 << 2, };
   uint               scheduler_depth_;
+  std::atomic<uint64> schedule_stamp_ { 1 };
   std::vector<Processor*> schedule_;
+  std::vector<ScheduleEdge> schedule_edges_;
+  ScheduleFrame          *schedule_frame_ = nullptr;
   std::vector<ProcessorP> roots_;
+  std::vector<ProcessorP> added_roots_;
   std::mutex              mutex_;
   std::function<void()>   wakeup_;
+  RenderPool             *render_pool_ = nullptr;
+  friend class Processor;
+  void          enqueue_children (Processor &proc);
 public:
   const AudioTiming &timing;
-  explicit      Engine           (uint32 samplerate, AudioTiming &atiming, std::function<void()> wakeup);
+  explicit      Engine           (uint32 samplerate, uint32 maxblocksize, AudioTiming &atiming, std::function<void()> wakeup);
+  /*dtor*/     ~Engine           ();
   uint          sample_rate      () const BSE_CONST      { return sample_rate_; }
   double        nyquist          () const BSE_CONST      { return nyquist_; }
   double        inyquist         () const BSE_CONST      { return inyquist_; }
+  uint          max_block_size   () const BSE_CONST      { return max_block_size_; }
+  uint          block_size       () const                { return block_size_; }
   uint64_t      frame_counter    () const                { return frame_counter_; }
   void          add_root         (ProcessorP rootproc);
   bool          del_root         (ProcessorP rootproc);
   bool          in_schedule      (Processor &proc);
   void          enqueue          (Processor &proc);
   void          reschedule       ();
+  void          reschedule       (Processor &proc);
   void          make_schedule    ();
-  void          render_block     ();
+  void          render_block     (uint n_frames);
+  void          set_render_threads (uint n_threads);
+  uint          render_threads   () const;
   bool          ipc_pending      ();
   void          ipc_dispatch     ();
   void          ipc_wakeup_mt    ();
 };
 
 /// Aggregate structure for input/output buffer state and values in Processor::render().
-/// The floating point #buffer array is cache-line aligned (to 64 byte) to optimize
-/// SIMD access and avoid false sharing.
+/// The floating point #fblock arrays hold Engine::max_block_size() frames and are
+/// cache-line aligned (to 64 byte) to optimize SIMD access and avoid false sharing.
 class Processor::FloatBuffer {
-  void          check      ();
-  /// Floating point memory when #buffer is not redirected, 64-byte aligned.
-  alignas (64) float fblock[MAX_RENDER_BLOCK_SIZE] = { 0, };
-  const uint64       canary0_ = const_canary;
-  const uint64       canary1_ = const_canary;
-  struct { uint64 d1, d2, d3, d4; }; // dummy mem
+  void          check      (uint n_frames);
+  /// Floating point memory when #buffer is not redirected, 64-byte aligned and followed by canaries.
+  float             *fblock = nullptr;
   SpeakerArrangement speaker_arrangement_ = SpeakerArrangement::NONE;
   SpeakerArrangement speaker_arrangement () const;
   static constexpr uint64 const_canary = 0xE14D8A302B97C56F;
+  static constexpr uint   canary_floats = 64 / sizeof (float);
+  explicit FloatBuffer (float *block) : fblock (block), buffer (block) {}
   friend class Processor;
   /// Pointer to the IO samples, this can be redirected or point to #fblock.
-  float             *buffer = &fblock[0];
+  float             *buffer = nullptr;
 };
 
 // == ProcessorManager ==
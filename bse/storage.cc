@@ -4,6 +4,7 @@
 #include "magic.hh"
 #include "minizip.h"
 #include "path.hh"
+#include "randomhash.hh"
 #include <stdlib.h>     // mkdtemp
 #include <sys/stat.h>   // mkdir
 #include <unistd.h>     // rmdir
@@ -155,6 +156,116 @@ beastbse_cachedir_current ()
   return current_cachedir;
 }
 
+/// Retrieve (or create) a cache directory that outlives this runtime, or "" if unavailable (errno set).
+std::string
+beastbse_cachedir_persistent (const std::string &subdir)
+{
+  // only ~/.cache/beast/ is private enough to keep data across runtimes
+  const std::string cachedir = Bse::Path::cache_home() + "/beast/" + subdir;
+  if (!Path::check (cachedir, "dw"))
+    {
+      const bool created = Path::mkdirs (cachedir, 0700);
+      SDEBUG ("mkdirs: %s: %s", cachedir, strerror (created ? 0 : errno));
+      if (!Path::check (cachedir, "dw")) // sets errno
+        return "";
+    }
+  return cachedir;
+}
+
+/// Build the key that validates cache entries about `filename`, or "" if it cannot be stat()-ed (errno set).
+std::string
+beastbse_cachefile_key (const std::string &kind, const std::string &filename)
+{
+  struct stat st;
+  if (stat (filename.c_str(), &st) != 0)
+    return "";
+  return beastbse_cachefile_key (kind, filename, st.st_mtim.tv_sec, st.st_mtim.tv_nsec, st.st_size);
+}
+
+/// Build the key that validates cache entries about `filename` with the given modification time and size.
+std::string
+beastbse_cachefile_key (const std::string &kind, const std::string &filename, int64 mtime, int64 mtime_nsecs, int64 size)
+{
+  // cache entries go stale with a new BSE build or once the file is modified
+  return string_format ("BSE-%s\n%s\n%s\n%d.%09d\n%d\n", kind, version(), filename, mtime, mtime_nsecs, size);
+}
+
+/// Retrieve the file name for cache entries about `filename` within a persistent cache directory, or "".
+std::string
+beastbse_cachefile_path (const std::string &subdir, const std::string &filename)
+{
+  const std::string cachedir = beastbse_cachedir_persistent (subdir);
+  if (cachedir.empty())
+    return "";
+  return string_format ("%s/%016x.cache", cachedir, fnv1a_consthash64 (filename.c_str()));
+}
+
+/// Read the `payload` of `cachefile` if it was written with a matching `key`.
+bool
+beastbse_cachefile_read (const std::string &cachefile, const std::string &key, std::string &payload)
+{
+  if (cachefile.empty() || key.empty())
+    return false;
+  const std::string data = Path::stringread (cachefile);
+  if (data.size() < key.size() || data.compare (0, key.size(), key) != 0)
+    return false;       // missing, stale or hash collision
+  payload = data.substr (key.size());
+  return true;
+}
+
+/// Atomically replace `filename` with `data`, so concurrent readers never see partial cache files.
+bool
+beastbse_cachefile_write (const std::string &filename, const std::string &data)
+{
+  std::string tmpname = filename + ".XXXXXX";
+  const int fd = mkstemp (&tmpname[0]);
+  if (fd < 0)
+    return false;
+  bool success = true;
+  for (size_t n = 0; success && n < data.size(); )
+    {
+      const ssize_t l = write (fd, data.data() + n, data.size() - n);
+      if (l > 0)
+        n += l;
+      else
+        success = l < 0 && errno == EINTR;
+    }
+  success = close (fd) == 0 && success;
+  if (!success || rename (tmpname.c_str(), filename.c_str()) != 0)
+    {
+      unlink (tmpname.c_str());
+      return false;
+    }
+  return true;
+}
+
+/// Remove all but the `max_entries` most recently modified cache files from a persistent cache directory.
+void
+beastbse_cachedir_trim (const std::string &subdir, size_t max_entries)
+{
+  const std::string cachedir = Bse::Path::cache_home() + "/beast/" + subdir;
+  std::vector<std::pair<std::filesystem::file_time_type, std::filesystem::path>> entries;
+  std::error_code ec;
+  const auto now = std::filesystem::file_time_type::clock::now();
+  for (auto &direntry : std::filesystem::directory_iterator (cachedir, ec))
+    if (direntry.is_regular_file (ec))
+      {
+        const auto mtime = direntry.last_write_time (ec);
+        if (ec)
+          continue;
+        if (direntry.path().extension() == ".cache")
+          entries.push_back ({ mtime, direntry.path() });
+        else if (now - mtime > std::chrono::hours (24))
+          std::filesystem::remove (direntry.path(), ec);        // leftover from an interrupted write
+      }
+  if (entries.size() <= max_entries)
+    return;
+  std::sort (entries.begin(), entries.end(), [] (const auto &a, const auto &b) { return a.first > b.first; });
+  for (size_t i = max_entries; i < entries.size(); i++)
+    std::filesystem::remove (entries[i].second, ec);
+  SDEBUG ("trim: %s: removed %d entries", cachedir, entries.size() - max_entries);
+}
+
 /// Clean stale cache directories from past runtimes, may be called from any thread.
 void
 beastbse_cachedir_cleanup()
@@ -30,7 +30,15 @@ public:
 
 std::string beastbse_cachedir_create  ();
 void        beastbse_cachedir_cleanup ();
+void        beastbse_cachedir_trim    (const std::string &subdir, size_t max_entries);
 std::string beastbse_cachedir_current ();
+std::string beastbse_cachedir_persistent (const std::string &subdir);
+std::string beastbse_cachefile_key      (const std::string &kind, const std::string &filename);
+std::string beastbse_cachefile_key      (const std::string &kind, const std::string &filename,
+                                         int64 mtime, int64 mtime_nsecs, int64 size);
+std::string beastbse_cachefile_path     (const std::string &subdir, const std::string &filename);
+bool        beastbse_cachefile_read      (const std::string &cachefile, const std::string &key, std::string &payload);
+bool        beastbse_cachefile_write     (const std::string &filename, const std::string &data);
 
 } // Bse
 
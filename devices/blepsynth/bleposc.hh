@@ -4,6 +4,7 @@
 
 #include <bse/bseblockutils.hh>
 #include <bse/bsemathsignal.hh>
+#include "devices/blepsynth/bleputils.hh"
 
 namespace Bse {
 namespace BlepUtils {
@@ -102,6 +103,30 @@ public:
 
   std::vector<UnisonVoice> unison_voices;
 
+  /* process groups of LANES unison voices in SIMD lanes, false selects the scalar reference code */
+  bool simd_lanes = true;
+  static constexpr int LANES = SIMD_LANES;
+
+  /* structure of arrays layout for LANES unison voices, gathered from unison_voices per block */
+  struct UnisonLanes
+  {
+    double freq2inc[LANES], left_factor[LANES], right_factor[LANES];
+    double master_phase[LANES], slave_phase[LANES], last_value[LANES], current_level[LANES];
+    double last_dc[LANES], dc_delta[LANES];
+    double bound[LANES];       /* slave phase of the next edge of the current state */
+    State  state[LANES];
+    int    dc_steps;
+    int    future_pos;
+    float  future[WIDTH * 2][LANES];
+  };
+  /* a single lane of UnisonLanes, for the branchy state machine */
+  struct LaneVoice
+  {
+    double master_phase, slave_phase, current_level;
+    State  state;
+    float *future; /* future sample of this lane at future_pos, with a stride of LANES */
+  };
+
   OscImpl()
   {
     set_unison (1, 0, 0); // default
@@ -429,6 +454,24 @@ public:
       }
   }
   void
+  insert_blep (LaneVoice& voice, double frac, double weight)
+  {
+    int pos = frac * OVERSAMPLE;
+    const float inter_frac = frac * OVERSAMPLE - pos;
+    const float weight_left = (1 - inter_frac) * weight;
+    const float weight_right = inter_frac * weight;
+
+    pos = std::max (pos, 0);
+    pos = std::min (pos, OVERSAMPLE - 1);
+
+    for (int i = 0; i < WIDTH; i++)
+      {
+        voice.future[i * LANES] += blep_table[pos] * weight_left + blep_table[pos + 1] * weight_right;
+
+        pos += OVERSAMPLE;
+      }
+  }
+  void
   insert_future_delta (UnisonVoice& voice, double weight)
   {
     voice.future[voice.future_pos + WSHIFT] += weight;
@@ -445,8 +488,8 @@ public:
    * when master oscillator sync occurs, only return true if this point in time is
    * before master oscillator sync
    */
-  bool
-  check_slave_before_master (UnisonVoice& voice, double target_phase, double sync_factor)
+  template<class Voice> bool
+  check_slave_before_master (Voice& voice, double target_phase, double sync_factor)
   {
     if (voice.slave_phase > target_phase)
       {
@@ -462,6 +505,57 @@ public:
       }
     return false;
   }
+  /* parameters derived from the inputs, shared by all unison voices of a sample */
+  struct SampleParams
+  {
+    double master_freq, freq_mod; /* per voice increment is master_freq * freq2inc * freq_mod */
+    double sync_factor;
+    double shape, sub, pulse_width, sub_width;
+    double saw_slope;
+    double bound_a, bound_b, bound_c;
+    double jump_a, jump_ab, jump_abc;
+  };
+  static constexpr unsigned int PARAM_CHUNK = 64;
+  struct DCCache
+  {
+    double shape = -2, pulse_width = 0, sub = 0, sub_width = 0, sync_factor = 0;
+    double dc = 0;
+  } dc_cache_;
+  double
+  cached_dc (const SampleParams& p)
+  {
+    /* unmodulated parameters keep the dc constant, so avoid recomputing it for every voice */
+    if (p.shape != dc_cache_.shape || p.pulse_width != dc_cache_.pulse_width || p.sub != dc_cache_.sub ||
+        p.sub_width != dc_cache_.sub_width || p.sync_factor != dc_cache_.sync_factor)
+      {
+        dc_cache_.shape = p.shape;
+        dc_cache_.pulse_width = p.pulse_width;
+        dc_cache_.sub = p.sub;
+        dc_cache_.sub_width = p.sub_width;
+        dc_cache_.sync_factor = p.sync_factor;
+        dc_cache_.dc = estimate_dc (p.shape, p.pulse_width, p.sub, p.sub_width, p.sync_factor);
+      }
+    return dc_cache_.dc;
+  }
+  void
+  compute_params (SampleParams& p, double master_freq, double fmod, double shape, double sub,
+                  double sync_factor, double pulse_width, double sub_width)
+  {
+    p.master_freq = master_freq;
+    p.freq_mod    = fmod;
+    p.sync_factor = sync_factor;
+    p.shape       = shape;
+    p.sub         = sub;
+    p.pulse_width = pulse_width;
+    p.sub_width   = sub_width;
+    p.saw_slope   = -4.0 * (shape + 1) * (1 - sub);
+    p.bound_a     = sub_width * pulse_width;
+    p.bound_b     = 2 * sub_width * pulse_width + 1 - sub_width - pulse_width;
+    p.bound_c     = sub_width * pulse_width + (1 - sub_width);
+    p.jump_a      = 2.0 * (shape * (1 - sub) - sub);
+    p.jump_ab     = 2.0 * ((shape + 1) * (1 - sub) - sub);
+    p.jump_abc    = 2.0 * (2 * shape + 1) * (1 - sub);
+  }
   void
   process_sample_stereo (float *left_out, float *right_out, unsigned int n_values,
                          const float *freq_in = nullptr,
@@ -475,178 +569,393 @@ public:
     Block::fill (n_values, left_out, 0.0);
     Block::fill (n_values, right_out, 0.0);
 
-    double master_freq = frequency_factor * frequency_base;
-    double pulse_width = clamp (pulse_width_base, 0.01, 0.99);
-    double sub         = clamp (sub_base, 0.0, 1.0);
-    double sub_width   = clamp (sub_width_base, 0.01, 0.99);
-    double shape       = clamp (shape_base, -1.0, 1.0);
-    double sync_factor = fast_exp2 (clamp (sync_base, 0.0, 60.0) / 12);
-
-    /* dc substampling according to control frequency (cpu/quality trade off) */
-    const int dc_steps = max (bse_ftoi (rate_ / 4000), 1);
+    const double pulse_width = clamp (pulse_width_base, 0.01, 0.99);
+    const double sub         = clamp (sub_base, 0.0, 1.0);
+    const double sub_width   = clamp (sub_width_base, 0.01, 0.99);
+    const double shape       = clamp (shape_base, -1.0, 1.0);
+    const double sync_factor = fast_exp2 (clamp (sync_base, 0.0, 60.0) / 12);
 
-    for (auto& voice : unison_voices)
+    SampleParams params[PARAM_CHUNK];
+    if (!freq_in && !freq_mod_in && !shape_mod_in && !sub_mod_in && !sync_mod_in && !pulse_mod_in && !sub_width_mod_in)
       {
-        const double master_freq2inc = 0.5 / rate_ * voice.freq_factor;
-
-        for (unsigned int n = 0; n < n_values; n++)
+        /* specialization for unconnected inputs: parameters are constant for the whole block */
+        compute_params (params[0], frequency_factor * frequency_base, 1, shape, sub, sync_factor, pulse_width, sub_width);
+        if (need_reset_voice_state)
           {
-            if (freq_in)
-              master_freq = frequency_factor * BSE_SIGNAL_TO_FREQ (freq_in[n]);
+            reset_voice_state (shape, pulse_width, sub, sub_width, sync_factor);
+            need_reset_voice_state = false;
+          }
+        process_unison<false> (params, left_out, right_out, n_values);
+        return;
+      }
+    /* modulated parameters are computed once per sample and chunk for all unison voices */
+    for (unsigned int offset = 0; offset < n_values; offset += PARAM_CHUNK)
+      {
+        const unsigned int n_chunk = std::min (n_values - offset, PARAM_CHUNK);
+        for (unsigned int i = 0; i < n_chunk; i++)
+          {
+            const unsigned int n = offset + i;
+            compute_params (params[i],
+                            frequency_factor * (freq_in ? BSE_SIGNAL_TO_FREQ (freq_in[n]) : frequency_base),
+                            freq_mod_in ? fast_exp2 (freq_mod_in[n] * freq_mod_octaves) : 1,
+                            shape_mod_in ? clamp (shape_base + shape_mod * shape_mod_in[n], -1.0, 1.0) : shape,
+                            sub_mod_in ? clamp (sub_base + sub_mod * sub_mod_in[n], 0.0, 1.0) : sub,
+                            sync_mod_in ? fast_exp2 (clamp (sync_base + sync_mod * sync_mod_in[n], 0.0, 60.0) / 12) : sync_factor,
+                            pulse_mod_in ? clamp (pulse_width_base + pulse_width_mod * pulse_mod_in[n], 0.01, 0.99) : pulse_width,
+                            sub_width_mod_in ? clamp (sub_width_base + sub_width_mod * sub_width_mod_in[n], 0.01, 0.99) : sub_width);
+          }
+        /* reset needs parameters, so we need to do it here */
+        if (need_reset_voice_state)
+          {
+            const SampleParams& p = params[0];
+            reset_voice_state (p.shape, p.pulse_width, p.sub, p.sub_width, p.sync_factor);
+            need_reset_voice_state = false;
+          }
+        process_unison<true> (params, left_out + offset, right_out + offset, n_chunk);
+      }
+  }
+  template<bool MODULATED> void
+  process_unison (const SampleParams *params, float *left_out, float *right_out, unsigned int n_values)
+  {
+    /* full groups of voices run in lanes, the rest (and voices out of step) run scalar; voices are
+     * still accumulated in order, so both paths produce the same output
+     */
+    size_t v = 0;
+    if (simd_lanes)
+      for (; v + LANES <= unison_voices.size(); v += LANES)
+        if (!process_lanes<MODULATED> (&unison_voices[v], params, left_out, right_out, n_values))
+          break;
+    for (; v < unison_voices.size(); v++)
+      process_voice<MODULATED> (unison_voices[v], params, left_out, right_out, n_values);
+  }
+  /* run the wave form state machine of a voice, until it reaches its current phase */
+  template<class Voice> void
+  process_events (Voice& voice, const SampleParams& p, double master_inc, double slave_inc, double saw_delta)
+  {
+    bool state_changed;
+    do
+      {
+        state_changed = false;
 
-            double master_inc = master_freq * master_freq2inc;
-            if (freq_mod_in)
-              master_inc *= fast_exp2 (freq_mod_in[n] * freq_mod_octaves);
+        if (voice.state == State::A)
+          {
+            if (check_slave_before_master (voice, p.bound_a, p.sync_factor))
+              {
+                const double slave_frac = (voice.slave_phase - p.bound_a) / slave_inc;
 
-            if (shape_mod_in)
-              shape = clamp (shape_base + shape_mod * shape_mod_in[n], -1.0, 1.0);
+                const double saw = p.saw_slope * p.bound_a;
+                const double blep_height = p.jump_a + saw - (voice.current_level + (1 - slave_frac) * saw_delta);
 
-            if (sub_mod_in)
-              sub = clamp (sub_base + sub_mod * sub_mod_in[n], 0.0, 1.0);
+                insert_blep (voice, slave_frac, blep_height);
+                voice.current_level += blep_height;
+                voice.state = State::B;
+                state_changed = true;
+              }
+          }
+        if (voice.state == State::B)
+          {
+            if (check_slave_before_master (voice, p.bound_b, p.sync_factor))
+              {
+                const double slave_frac = (voice.slave_phase - p.bound_b) / slave_inc;
 
-            if (sync_mod_in)
-              sync_factor = fast_exp2 (clamp (sync_base + sync_mod * sync_mod_in[n], 0.0, 60.0) / 12);
+                const double saw = p.saw_slope * p.bound_b;
+                const double blep_height = p.jump_ab + saw - (voice.current_level + (1 - slave_frac) * saw_delta);
 
-            if (pulse_mod_in)
-              pulse_width = clamp (pulse_width_base + pulse_width_mod * pulse_mod_in[n], 0.01, 0.99);
+                insert_blep (voice, slave_frac, blep_height);
+                voice.current_level += blep_height;
+                voice.state = State::C;
+                state_changed = true;
+              }
+          }
+        if (voice.state == State::C)
+          {
+            if (check_slave_before_master (voice, p.bound_c, p.sync_factor))
+              {
+                const double slave_frac = (voice.slave_phase - p.bound_c) / slave_inc;
 
-            if (sub_width_mod_in)
-              sub_width = clamp (sub_width_base + sub_width_mod * sub_width_mod_in[n], 0.01, 0.99);
+                const double saw = p.saw_slope * p.bound_c;
+                const double blep_height = p.jump_abc + saw - (voice.current_level + (1 - slave_frac) * saw_delta);
 
-            /* reset needs parameters, so we need to do it here */
-            if (need_reset_voice_state)
+                insert_blep (voice, slave_frac, blep_height);
+                voice.current_level += blep_height;
+                voice.state = State::D;
+                state_changed = true;
+              }
+          }
+        if (voice.state == State::D)
+          {
+            if (check_slave_before_master (voice, 1, p.sync_factor))
               {
-                reset_voice_state (shape, pulse_width, sub, sub_width, sync_factor);
-                need_reset_voice_state = false;
+                voice.slave_phase -= 1;
+
+                const double slave_frac = voice.slave_phase / slave_inc;
+
+                voice.current_level += (1 - slave_frac) * saw_delta;
+
+                insert_blep (voice, slave_frac, -voice.current_level);
+
+                voice.current_level = saw_delta * slave_frac - saw_delta;
+                voice.state = State::A;
+                state_changed = true;
               }
+          }
+        if (!state_changed && voice.master_phase > 1)
+          {
+            voice.master_phase -= 1;
+
+            const double master_frac = voice.master_phase / master_inc;
+
+            const double new_slave_phase = voice.master_phase * p.sync_factor;
+
+            voice.current_level += (1 - master_frac) * saw_delta;
+
+            insert_blep (voice, master_frac, -voice.current_level);
+
+            voice.current_level = saw_delta * master_frac - saw_delta;
+            voice.slave_phase = new_slave_phase;
+
+            voice.state = State::A;
+            state_changed = true;
+          }
+      }
+    while (state_changed); // rerun all state checks if state was modified
+  }
+  template<bool MODULATED> void
+  process_voice (UnisonVoice& voice, const SampleParams *params, float *left_out, float *right_out, unsigned int n_values)
+  {
+    /* dc substampling according to control frequency (cpu/quality trade off) */
+    const int dc_steps = max (bse_ftoi (rate_ / 4000), 1);
+    const double master_freq2inc = 0.5 / rate_ * voice.freq_factor;
+
+    for (unsigned int n = 0; n < n_values; n++)
+      {
+        const SampleParams& p = params[MODULATED ? n : 0];
+        const double master_inc = p.master_freq * master_freq2inc * p.freq_mod;
+        const double slave_inc = master_inc * p.sync_factor;
+        const double saw_delta = -4.0 * slave_inc * (p.shape + 1) * (1 - p.sub);
+
+        voice.master_phase += master_inc;
+        voice.slave_phase  += slave_inc;
+
+        process_events (voice, p, master_inc, slave_inc, saw_delta);
+
+        if (voice.dc_steps > 0)
+          {
+            voice.dc_steps--;
+          }
+        else
+          {
+            const double dc = cached_dc (p);
+
+            voice.dc_steps = dc_steps - 1;
+            voice.dc_delta = (voice.last_dc - dc) / dc_steps;
+            voice.last_dc = dc;
+          }
+
+        voice.current_level += saw_delta;
+        insert_future_delta (voice, saw_delta + voice.dc_delta); // align with the impulses
 
-            const double slave_inc = master_inc * sync_factor;
-            const double saw_delta = -4.0 * slave_inc * (shape + 1) * (1 - sub);
+        /* leaky integration */
+        double value = leaky_a * voice.last_value + voice.pop_future();
+        voice.last_value = value;
+
+        left_out[n] += value * voice.left_factor;
+        right_out[n] += value * voice.right_factor;
+      }
+  }
+  void
+  process_lane_events (UnisonLanes& lanes, int l, const SampleParams& p, double master_inc, double slave_inc, double saw_delta)
+  {
+    LaneVoice voice;
+    voice.master_phase  = lanes.master_phase[l];
+    voice.slave_phase   = lanes.slave_phase[l];
+    voice.current_level = lanes.current_level[l];
+    voice.state         = lanes.state[l];
+    voice.future        = &lanes.future[lanes.future_pos][l];
+
+    process_events (voice, p, master_inc, slave_inc, saw_delta);
+
+    lanes.master_phase[l]  = voice.master_phase;
+    lanes.slave_phase[l]   = voice.slave_phase;
+    lanes.current_level[l] = voice.current_level;
+    lanes.state[l]         = voice.state;
+  }
+  static void
+  load_lanes (LaneF64& v, const double *lanes)
+  {
+    memcpy (&v, lanes, sizeof (v));
+  }
+  static void
+  store_lanes (double *lanes, const LaneF64& v)
+  {
+    memcpy (lanes, &v, sizeof (v));
+  }
+  template<bool MODULATED> bool
+  process_lanes (UnisonVoice *voices, const SampleParams *params, float *left_out, float *right_out, unsigned int n_values)
+  {
+    /* voices are reset together, so their future buffer and dc steps normally advance in step */
+    for (int l = 1; l < LANES; l++)
+      if (voices[l].future_pos != voices[0].future_pos || voices[l].dc_steps != voices[0].dc_steps)
+        return false;
 
-            voice.master_phase += master_inc;
-            voice.slave_phase  += slave_inc;
+    UnisonLanes lanes;
+    for (int l = 0; l < LANES; l++)
+      {
+        const UnisonVoice& voice = voices[l];
+        lanes.freq2inc[l]      = 0.5 / rate_ * voice.freq_factor;
+        lanes.left_factor[l]   = voice.left_factor;
+        lanes.right_factor[l]  = voice.right_factor;
+        lanes.master_phase[l]  = voice.master_phase;
+        lanes.slave_phase[l]   = voice.slave_phase;
+        lanes.last_value[l]    = voice.last_value;
+        lanes.current_level[l] = voice.current_level;
+        lanes.last_dc[l]       = voice.last_dc;
+        lanes.dc_delta[l]      = voice.dc_delta;
+        lanes.state[l]         = voice.state;
+        for (int i = 0; i < WIDTH * 2; i++)
+          lanes.future[i][l] = voice.future[i];
+      }
+    lanes.dc_steps = voices[0].dc_steps;
+    lanes.future_pos = voices[0].future_pos;
+
+    /* the sample loop keeps the lanes in vectors, the state machine works on UnisonLanes */
+    LaneF64 freq2inc, left_factor, right_factor, master_phase, slave_phase, last_value, current_level, last_dc, dc_delta, bound;
+    load_lanes (freq2inc, lanes.freq2inc);
+    load_lanes (left_factor, lanes.left_factor);
+    load_lanes (right_factor, lanes.right_factor);
+    load_lanes (master_phase, lanes.master_phase);
+    load_lanes (slave_phase, lanes.slave_phase);
+    load_lanes (last_value, lanes.last_value);
+    load_lanes (current_level, lanes.current_level);
+    load_lanes (last_dc, lanes.last_dc);
+    load_lanes (dc_delta, lanes.dc_delta);
+
+    LaneF64 master_inc, slave_inc, saw_delta;
+    auto update_incs = [&] (const SampleParams& p) {
+      master_inc = p.master_freq * freq2inc * p.freq_mod;
+      slave_inc = master_inc * p.sync_factor;
+      saw_delta = -4.0 * slave_inc * (p.shape + 1) * (1 - p.sub);
+    };
+    auto update_bound = [&lanes, &bound] (const SampleParams& p) {
+      const double bounds[4] = { p.bound_a, p.bound_b, p.bound_c, 1 };
+      for (int l = 0; l < LANES; l++)
+        lanes.bound[l] = bounds[int (lanes.state[l])];
+      load_lanes (bound, lanes.bound);
+    };
+    if (!MODULATED)
+      {
+        update_incs (params[0]);
+        update_bound (params[0]);
+      }
 
-            bool state_changed;
-            do
+    const int dc_steps = max (bse_ftoi (rate_ / 4000), 1);
+    int lane_dc_steps = lanes.dc_steps, future_pos = lanes.future_pos;
+    LaneF64 left[PARAM_CHUNK], right[PARAM_CHUNK];
+    for (unsigned int offset = 0; offset < n_values; offset += PARAM_CHUNK)
+      {
+        const unsigned int n_chunk = std::min (n_values - offset, PARAM_CHUNK);
+        for (unsigned int n = 0; n < n_chunk; n++)
+          {
+            const SampleParams& p = params[MODULATED ? offset + n : 0];
+            if (MODULATED)
+              update_incs (p);
+
+            master_phase += master_inc;
+            slave_phase  += slave_inc;
+
+            /* most samples have no state change, so only lanes that reached an edge run the state machine */
+            if (MODULATED)
+              update_bound (p);
+            const LaneI64 edge = (slave_phase > bound) | (master_phase > 1.0);
+            int64 edges[LANES];
+            memcpy (edges, &edge, sizeof (edges));
+            if (BSE_UNLIKELY (std::any_of (edges, edges + LANES, [] (int64 e) { return e != 0; })))
               {
-                state_changed = false;
-
-                if (voice.state == State::A)
-                  {
-                    const double bound_a = sub_width * pulse_width;
-
-                    if (check_slave_before_master (voice, bound_a, sync_factor))
-                      {
-                        const double slave_frac = (voice.slave_phase - bound_a) / slave_inc;
-
-                        const double jump_a = 2.0 * (shape * (1 - sub) - sub);
-                        const double saw = -4.0 * (shape + 1) * (1 - sub) * bound_a;
-                        const double blep_height = jump_a + saw - (voice.current_level + (1 - slave_frac) * saw_delta);
-
-                        insert_blep (voice, slave_frac, blep_height);
-                        voice.current_level += blep_height;
-                        voice.state = State::B;
-                        state_changed = true;
-                      }
-                  }
-                if (voice.state == State::B)
-                  {
-                    const double bound_b = 2 * sub_width * pulse_width + 1 - sub_width - pulse_width;
-
-                    if (check_slave_before_master (voice, bound_b, sync_factor))
-                      {
-                        const double slave_frac = (voice.slave_phase - bound_b) / slave_inc;
-
-                        const double jump_ab = 2.0 * ((shape + 1) * (1 - sub) - sub);
-                        const double saw = -4.0 * (shape + 1) * (1 - sub) * bound_b;
-                        const double blep_height = jump_ab + saw - (voice.current_level + (1 - slave_frac) * saw_delta);
-
-                        insert_blep (voice, slave_frac, blep_height);
-                        voice.current_level += blep_height;
-                        voice.state = State::C;
-                        state_changed = true;
-                      }
-                  }
-                if (voice.state == State::C)
-                  {
-                    const double bound_c = sub_width * pulse_width + (1 - sub_width);
-
-                    if (check_slave_before_master (voice, bound_c, sync_factor))
-                      {
-                        const double slave_frac = (voice.slave_phase - bound_c) / slave_inc;
-
-                        const double jump_abc = 2.0 * (2 * shape + 1) * (1 - sub);
-                        const double saw = -4.0 * (shape + 1) * (1 - sub) * bound_c;
-                        const double blep_height = jump_abc + saw - (voice.current_level + (1 - slave_frac) * saw_delta);
-
-                        insert_blep (voice, slave_frac, blep_height);
-                        voice.current_level += blep_height;
-                        voice.state = State::D;
-                        state_changed = true;
-                      }
-                  }
-                if (voice.state == State::D)
-                  {
-                    if (check_slave_before_master (voice, 1, sync_factor))
-                      {
-                        voice.slave_phase -= 1;
-
-                        const double slave_frac = voice.slave_phase / slave_inc;
-
-                        voice.current_level += (1 - slave_frac) * saw_delta;
-
-                        insert_blep (voice, slave_frac, -voice.current_level);
-
-                        voice.current_level = saw_delta * slave_frac - saw_delta;
-                        voice.state = State::A;
-                        state_changed = true;
-                      }
-                  }
-                if (!state_changed && voice.master_phase > 1)
-                  {
-                    voice.master_phase -= 1;
-
-                    const double master_frac = voice.master_phase / master_inc;
-
-                    const double new_slave_phase = voice.master_phase * sync_factor;
-
-                    voice.current_level += (1 - master_frac) * saw_delta;
-
-                    insert_blep (voice, master_frac, -voice.current_level);
-
-                    voice.current_level = saw_delta * master_frac - saw_delta;
-                    voice.slave_phase = new_slave_phase;
-
-                    voice.state = State::A;
-                    state_changed = true;
-                  }
+                double master_incs[LANES], slave_incs[LANES], saw_deltas[LANES];
+                store_lanes (master_incs, master_inc);
+                store_lanes (slave_incs, slave_inc);
+                store_lanes (saw_deltas, saw_delta);
+                store_lanes (lanes.master_phase, master_phase);
+                store_lanes (lanes.slave_phase, slave_phase);
+                store_lanes (lanes.current_level, current_level);
+                lanes.future_pos = future_pos;
+                for (int l = 0; l < LANES; l++)
+                  if (edges[l])
+                    process_lane_events (lanes, l, p, master_incs[l], slave_incs[l], saw_deltas[l]);
+                load_lanes (master_phase, lanes.master_phase);
+                load_lanes (slave_phase, lanes.slave_phase);
+                load_lanes (current_level, lanes.current_level);
+                update_bound (p);
               }
-            while (state_changed); // rerun all state checks if state was modified
-
-            if (voice.dc_steps > 0)
+            if (lane_dc_steps > 0)
               {
-                voice.dc_steps--;
+                lane_dc_steps--;
               }
             else
               {
-                const double dc = estimate_dc (shape, pulse_width, sub, sub_width, sync_factor);
+                const double dc = cached_dc (p);
 
-                voice.dc_steps = dc_steps - 1;
-                voice.dc_delta = (voice.last_dc - dc) / dc_steps;
-                voice.last_dc = dc;
+                lane_dc_steps = dc_steps - 1;
+                dc_delta = (last_dc - dc) / dc_steps;
+                last_dc = LaneF64 {} + dc;
+              }
+            current_level += saw_delta;
+
+            /* insert future delta (aligned with the impulses), then pop the current future sample */
+            LaneF32 row;
+            float *future_delta = lanes.future[future_pos + WSHIFT];
+            memcpy (&row, future_delta, sizeof (row));
+            const LaneF64 delta = __builtin_convertvector (row, LaneF64) + (saw_delta + dc_delta);
+            row = __builtin_convertvector (delta, LaneF32);
+            memcpy (future_delta, &row, sizeof (row));
+
+            memcpy (&row, lanes.future[future_pos++], sizeof (row));
+            if (future_pos == WIDTH)
+              {
+                memcpy (lanes.future[0], lanes.future[WIDTH], sizeof (lanes.future[0]) * WIDTH);
+                memset (lanes.future[WIDTH], 0, sizeof (lanes.future[0]) * WIDTH);
+                future_pos = 0;
               }
-
-            voice.current_level += saw_delta;
-            insert_future_delta (voice, saw_delta + voice.dc_delta); // align with the impulses
 
             /* leaky integration */
-            double value = leaky_a * voice.last_value + voice.pop_future();
-            voice.last_value = value;
+            last_value = leaky_a * last_value + __builtin_convertvector (row, LaneF64);
 
-            left_out[n] += value * voice.left_factor;
-            right_out[n] += value * voice.right_factor;
+            left[n] = last_value * left_factor;
+            right[n] = last_value * right_factor;
           }
+        /* sum up voices in the same order as the scalar code, the lanes only buffer a chunk */
+        for (int l = 0; l < LANES; l++)
+          for (unsigned int n = 0; n < n_chunk; n++)
+            {
+              left_out[offset + n] += left[n][l];
+              right_out[offset + n] += right[n][l];
+            }
+      }
+    store_lanes (lanes.master_phase, master_phase);
+    store_lanes (lanes.slave_phase, slave_phase);
+    store_lanes (lanes.last_value, last_value);
+    store_lanes (lanes.current_level, current_level);
+    store_lanes (lanes.last_dc, last_dc);
+    store_lanes (lanes.dc_delta, dc_delta);
+    lanes.dc_steps = lane_dc_steps;
+    lanes.future_pos = future_pos;
+
+    for (int l = 0; l < LANES; l++)
+      {
+        UnisonVoice& voice = voices[l];
+        voice.master_phase  = lanes.master_phase[l];
+        voice.slave_phase   = lanes.slave_phase[l];
+        voice.last_value    = lanes.last_value[l];
+        voice.current_level = lanes.current_level[l];
+        voice.last_dc       = lanes.last_dc[l];
+        voice.dc_delta      = lanes.dc_delta[l];
+        voice.dc_steps      = lanes.dc_steps;
+        voice.state         = lanes.state[l];
+        voice.future_pos    = lanes.future_pos;
+        for (int i = 0; i < WIDTH * 2; i++)
+          voice.future[i] = lanes.future[i][l];
       }
+    return true;
   }
 };
 
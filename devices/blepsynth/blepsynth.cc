@@ -4,6 +4,7 @@
 #include "bse/bsenote.hh"
 #include "devices/blepsynth/bleposc.hh"
 #include "devices/blepsynth/laddervcf.hh"
+#include "devices/blepsynth/envelope.hh"
 #include "devices/blepsynth/linearsmooth.hh"
 #include "bse/internal.hh"
 
@@ -11,189 +12,6 @@ namespace Bse {
 
 using namespace AudioSignal;
 
-// based on liquidsfz envelope.hh
-
-namespace {
-
-class Envelope
-{
-public:
-  enum class Shape { EXPONENTIAL, LINEAR };
-private:
-  /* values in seconds */
-  float delay_ = 0;
-  float attack_ = 0;
-  float hold_ = 0;
-  float decay_ = 0;
-  float sustain_ = 0; /* <- percent */
-  float release_ = 0;
-
-  int delay_len_ = 0;
-  int attack_len_ = 0;
-  int hold_len_ = 0;
-  int decay_len_ = 0;
-  int release_len_ = 0;
-  float sustain_level_ = 0;
-
-  enum class State { DELAY, ATTACK, HOLD, DECAY, SUSTAIN, RELEASE, DONE };
-
-  State state_ = State::DONE;
-  Shape shape_ = Shape::EXPONENTIAL;
-
-  struct SlopeParams {
-    int len;
-
-    double factor;
-    double delta;
-    double end;
-  } params_;
-
-  double level_ = 0;
-
-public:
-  void
-  set_shape (Shape shape)
-  {
-    shape_ = shape;
-  }
-  void
-  set_delay (float f)
-  {
-    delay_ = f;
-  }
-  void
-  set_attack (float f)
-  {
-    attack_ = f;
-  }
-  void
-  set_hold (float f)
-  {
-    hold_ = f;
-  }
-  void
-  set_decay (float f)
-  {
-    decay_ = f;
-  }
-  void
-  set_sustain (float f)
-  {
-    sustain_ = f;
-  }
-  void
-  set_release (float f)
-  {
-    release_ = f;
-  }
-  void
-  start (int sample_rate)
-  {
-    delay_len_ = std::max (int (sample_rate * delay_), 1);
-    attack_len_ = std::max (int (sample_rate * attack_), 1);
-    hold_len_ = std::max (int (sample_rate * hold_), 1);
-    decay_len_ = std::max (int (sample_rate * decay_), 1);
-    sustain_level_ = std::clamp<float> (sustain_ * 0.01, 0, 1); // percent->level
-    release_len_ = std::max (int (sample_rate * release_), 1);
-
-    level_ = 0;
-    state_ = State::DELAY;
-
-    compute_slope_params (delay_len_, 0, 0, State::DELAY);
-  }
-  void
-  stop()
-  {
-    state_ = State::RELEASE;
-    compute_slope_params (release_len_, level_, 0, State::RELEASE);
-  }
-  bool
-  done()
-  {
-    return state_ == State::DONE;
-  }
-  void
-  compute_slope_params (int len, float start_x, float end_x, State param_state)
-  {
-    params_.end = end_x;
-
-    if (param_state == State::ATTACK || param_state == State::DELAY || param_state == State::HOLD || shape_ == Shape::LINEAR)
-      {
-        // linear
-        params_.len    = len;
-        params_.delta  = (end_x - start_x) / params_.len;
-        params_.factor = 1;
-      }
-    else
-      {
-        assert_return (param_state == State::DECAY || param_state == State::RELEASE);
-
-        // exponential
-
-        /* true exponential decay doesn't ever reach zero; therefore we need to
-         * fade out early
-         */
-        const double RATIO = 0.001; // -60dB or 0.1% of the original height;
-
-        /* compute iterative exponential decay parameters from inputs:
-         *
-         *   - len:           half life time
-         *   - RATIO:         target ratio (when should we reach zero)
-         *   - start_x/end_x: level at start/end of the decay slope
-         *
-         * iterative computation of next value (should be done params.len times):
-         *
-         *    value = value * params.factor + params.delta
-         */
-        const double f = -log ((RATIO + 1) / RATIO) / len;
-        params_.len    = len;
-        params_.factor = exp (f);
-        params_.delta  = (end_x - RATIO * (start_x - end_x)) * (1 - params_.factor);
-      }
-  }
-
-  float
-  get_next()
-  {
-    if (state_ == State::SUSTAIN || state_ == State::DONE)
-      return level_;
-
-    level_ = level_ * params_.factor + params_.delta;
-    params_.len--;
-    if (!params_.len)
-      {
-        level_ = params_.end;
-
-        if (state_ == State::DELAY)
-          {
-            compute_slope_params (attack_len_, 0, 1, State::ATTACK);
-            state_ = State::ATTACK;
-          }
-        else if (state_ == State::ATTACK)
-          {
-            compute_slope_params (hold_len_, 1, 1, State::HOLD);
-            state_ = State::HOLD;
-          }
-        else if (state_ == State::HOLD)
-          {
-            compute_slope_params (decay_len_, 1, sustain_level_, State::DECAY);
-            state_ = State::DECAY;
-          }
-        else if (state_ == State::DECAY)
-          {
-            state_ = State::SUSTAIN;
-          }
-        else if (state_ == State::RELEASE)
-          {
-            state_ = State::DONE;
-          }
-      }
-    return level_;
-  }
-};
-
-} // Anon
-
 // == BlepSynth ==
 // subtractive synth based on band limited steps (MinBLEP):
 // - aliasing-free square/saw and similar sounds including hard sync
@@ -541,101 +359,141 @@ class BlepSynth : public AudioSignal::Processor {
     floatfill (left_out, 0.f, n_frames);
     floatfill (right_out, 0.f, n_frames);
 
-    for (auto& voice : active_voices_)
+    const float mix_norm = get_param (pid_mix_) * 0.01;
+    const float v1 = 1 - mix_norm;
+    const float v2 = mix_norm;
+    bool run_filter = true;
+    LadderVCFMode mode = LadderVCFMode::LP4;
+    switch (bse_ftoi (get_param (pid_mode_)))
       {
-        float osc1_left_out[n_frames];
-        float osc1_right_out[n_frames];
-        float osc2_left_out[n_frames];
-        float osc2_right_out[n_frames];
-
-        update_osc (voice->osc1_, osc_params[0]);
-        update_osc (voice->osc2_, osc_params[1]);
-        voice->osc1_.process_sample_stereo (osc1_left_out, osc1_right_out, n_frames);
-        voice->osc2_.process_sample_stereo (osc2_left_out, osc2_right_out, n_frames);
+      case 4: mode = LadderVCFMode::LP4;
+        break;
+      case 3: mode = LadderVCFMode::LP3;
+        break;
+      case 2: mode = LadderVCFMode::LP2;
+        break;
+      case 1: mode = LadderVCFMode::LP1;
+        break;
+      default: run_filter = false;
+        break;
+      }
+    double cutoff = get_param (pid_cutoff_) * inyquist();
+    double resonance = get_param (pid_resonance_) * 0.01;
+    double key_track = get_param (pid_key_track_) * 0.01;
+    double cut_mod = get_param (pid_fil_cut_mod_) / 12.; /* convert semitones to octaves */
+
+    /* voices are rendered in groups, so that envelopes and filters can run in SIMD lanes */
+    constexpr uint GROUP_SIZE = BlepUtils::SIMD_LANES;
+    for (size_t first = 0; first < active_voices_.size(); first += GROUP_SIZE)
+      {
+        Voice **group = &active_voices_[first];
+        const uint n_voices = std::min<size_t> (GROUP_SIZE, active_voices_.size() - first);
 
-        // apply volume envelope & mix
-        float mix_left_out[n_frames];
-        float mix_right_out[n_frames];
-        const float mix_norm = get_param (pid_mix_) * 0.01;
-        const float v1 = 1 - mix_norm;
-        const float v2 = mix_norm;
-        for (uint i = 0; i < n_frames; i++)
+        // mix oscillators, channel c of voice v is stored in mix_out[2 * v + c]
+        float mix_out[2 * GROUP_SIZE][n_frames];
+        for (uint v = 0; v < n_voices; v++)
           {
-            mix_left_out[i]  = osc1_left_out[i] * v1 + osc2_left_out[i] * v2;
-            mix_right_out[i] = osc1_right_out[i] * v1 + osc2_right_out[i] * v2;
+            Voice *voice = group[v];
+            float osc1_left_out[n_frames];
+            float osc1_right_out[n_frames];
+            float osc2_left_out[n_frames];
+            float osc2_right_out[n_frames];
+
+            update_osc (voice->osc1_, osc_params[0]);
+            update_osc (voice->osc2_, osc_params[1]);
+            voice->osc1_.process_sample_stereo (osc1_left_out, osc1_right_out, n_frames);
+            voice->osc2_.process_sample_stereo (osc2_left_out, osc2_right_out, n_frames);
+
+            float *mix_left_out = mix_out[2 * v];
+            float *mix_right_out = mix_out[2 * v + 1];
+            for (uint i = 0; i < n_frames; i++)
+              {
+                mix_left_out[i]  = osc1_left_out[i] * v1 + osc2_left_out[i] * v2;
+                mix_right_out[i] = osc1_right_out[i] * v1 + osc2_right_out[i] * v2;
+              }
           }
-        bool run_filter = true;
-        switch (bse_ftoi (get_param (pid_mode_)))
+        Envelope *envelopes[GROUP_SIZE];
+        float env_out[GROUP_SIZE][n_frames];
+        float *env_outputs[GROUP_SIZE];
+        for (uint v = 0; v < n_voices; v++)
           {
-          case 4: voice->vcf_.set_mode (LadderVCFMode::LP4);
-            break;
-          case 3: voice->vcf_.set_mode (LadderVCFMode::LP3);
-            break;
-          case 2: voice->vcf_.set_mode (LadderVCFMode::LP2);
-            break;
-          case 1: voice->vcf_.set_mode (LadderVCFMode::LP1);
-            break;
-          default: run_filter = false;
-            break;
+            envelopes[v] = &group[v]->fil_envelope_;
+            env_outputs[v] = env_out[v];
           }
-        /* --------- run ladder filter - processing in place is ok --------- */
-
-        /* TODO: under some conditions we could enable SSE in LadderVCF (alignment and block_size) */
-        const float *inputs[2]  = { mix_left_out, mix_right_out };
-        float       *outputs[2] = { mix_left_out, mix_right_out };
-        double cutoff = get_param (pid_cutoff_) * inyquist();
-        double resonance = get_param (pid_resonance_) * 0.01;
-        double key_track = get_param (pid_key_track_) * 0.01;
+        Envelope::get_next_lanes (envelopes, n_voices, env_outputs, n_frames);
 
-        if (fabs (voice->last_cutoff_ - cutoff) > 1e-7 || fabs (voice->last_key_track_ - key_track) > 1e-7)
+        float freq_in[GROUP_SIZE][n_frames];
+        const float *freq_ins[GROUP_SIZE];
+        LadderVCFNonLinear *vcfs[GROUP_SIZE];
+        for (uint v = 0; v < n_voices; v++)
           {
-            const bool reset = voice->last_cutoff_ < -1000;
-
-            // original strategy for key tracking: cutoff * exp (amount * log (key / 261.63))
-            // but since cutoff_smooth_ is already in log2-frequency space, we can do it better
-
-            voice->cutoff_smooth_.set (fast_log2 (cutoff) + key_track * fast_log2 (voice->freq_ / 261.63), reset);
-            voice->last_cutoff_ = cutoff;
-            voice->last_key_track_ = key_track;
+            Voice *voice = group[v];
+            if (run_filter)
+              voice->vcf_.set_mode (mode);
+
+            if (fabs (voice->last_cutoff_ - cutoff) > 1e-7 || fabs (voice->last_key_track_ - key_track) > 1e-7)
+              {
+                const bool reset = voice->last_cutoff_ < -1000;
+
+                // original strategy for key tracking: cutoff * exp (amount * log (key / 261.63))
+                // but since cutoff_smooth_ is already in log2-frequency space, we can do it better
+
+                voice->cutoff_smooth_.set (fast_log2 (cutoff) + key_track * fast_log2 (voice->freq_ / 261.63), reset);
+                voice->last_cutoff_ = cutoff;
+                voice->last_key_track_ = key_track;
+              }
+            if (fabs (voice->last_cut_mod_ - cut_mod) > 1e-7)
+              {
+                const bool reset = voice->last_cut_mod_ < -1000;
+
+                voice->cut_mod_smooth_.set (cut_mod, reset);
+                voice->last_cut_mod_ = cut_mod;
+              }
+            /* TODO: possible improvements:
+             *  - exponential smoothing (get rid of exp2f)
+             *  - don't do anything if cutoff_smooth_->steps_ == 0 (add accessor)
+             */
+            for (uint i = 0; i < n_frames; i++)
+              freq_in[v][i] = fast_exp2 (voice->cutoff_smooth_.get_next() + env_out[v][i] * voice->cut_mod_smooth_.get_next());
+            freq_ins[v] = freq_in[v];
+
+            voice->vcf_.set_drive (get_param (pid_drive_));
+            vcfs[v] = &voice->vcf_;
           }
-        double cut_mod = get_param (pid_fil_cut_mod_) / 12.; /* convert semitones to octaves */
-        if (fabs (voice->last_cut_mod_ - cut_mod) > 1e-7)
-          {
-            const bool reset = voice->last_cut_mod_ < -1000;
 
-            voice->cut_mod_smooth_.set (cut_mod, reset);
-            voice->last_cut_mod_ = cut_mod;
-          }
-        /* TODO: possible improvements:
-         *  - exponential smoothing (get rid of exp2f)
-         *  - don't do anything if cutoff_smooth_->steps_ == 0 (add accessor)
-         */
-        float freq_in[n_frames];
-        for (uint i = 0; i < n_frames; i++)
-          freq_in[i] = fast_exp2 (voice->cutoff_smooth_.get_next() + voice->fil_envelope_.get_next() * voice->cut_mod_smooth_.get_next());
-        voice->vcf_.set_drive (get_param (pid_drive_));
-
-        float no_out[n_frames];
-        if (!run_filter)
+        /* --------- run ladder filters - processing in place is ok --------- */
+        const float *inputs[2 * GROUP_SIZE];
+        float       *outputs[2 * GROUP_SIZE];
+        float        no_out[n_frames];
+        for (uint c = 0; c < 2 * n_voices; c++)
           {
+            inputs[c] = mix_out[c];
             // we keep running the filter even if it is disabled in order to have
             // sane filter signal to switch to when the filter is enabled again
-            outputs[0] = no_out;
-            outputs[1] = no_out;
+            outputs[c] = run_filter ? mix_out[c] : no_out;
           }
-        voice->vcf_.run_block (n_frames, cutoff, resonance, inputs, outputs, true, true, freq_in, nullptr, nullptr, nullptr);
+        LadderVCFNonLinear::run_block_lanes (vcfs, n_voices, n_frames, cutoff, resonance, inputs, outputs, freq_ins);
 
-        // apply volume envelope
-        for (uint i = 0; i < n_frames; i++)
-          {
-            float amp = 0.25 * voice->envelope_.get_next();
-            left_out[i] += mix_left_out[i] * amp;
-            right_out[i] += mix_right_out[i] * amp;
-          }
-        if (voice->envelope_.done())
+        // apply volume envelope & mix
+        for (uint v = 0; v < n_voices; v++)
+          envelopes[v] = &group[v]->envelope_;
+        Envelope::get_next_lanes (envelopes, n_voices, env_outputs, n_frames);
+        for (uint v = 0; v < n_voices; v++)
           {
-            voice->state_ = Voice::IDLE;
-            need_free = true;
+            Voice *voice = group[v];
+            const float *mix_left_out = mix_out[2 * v];
+            const float *mix_right_out = mix_out[2 * v + 1];
+            for (uint i = 0; i < n_frames; i++)
+              {
+                float amp = 0.25 * env_out[v][i];
+                left_out[i] += mix_left_out[i] * amp;
+                right_out[i] += mix_right_out[i] * amp;
+              }
+            if (voice->envelope_.done())
+              {
+                voice->state_ = Voice::IDLE;
+                need_free = true;
+              }
           }
       }
     if (need_free)
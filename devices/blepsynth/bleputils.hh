@@ -8,6 +8,18 @@
 namespace Bse {
 namespace BlepUtils {
 
+/* vectors for processing voices or unison partners in SIMD lanes; these are only
+ * used for locals, members and references, never passed or returned by value
+ */
+#ifdef __AVX__
+constexpr int SIMD_LANES = 4;
+#else
+constexpr int SIMD_LANES = 2;   /* gcc splits wider vectors into stack accesses without AVX */
+#endif
+typedef double LaneF64 __attribute__ ((vector_size (SIMD_LANES * sizeof (double))));
+typedef float  LaneF32 __attribute__ ((vector_size (SIMD_LANES * sizeof (float))));
+typedef int64  LaneI64 __attribute__ ((vector_size (SIMD_LANES * sizeof (int64))));
+
 inline double
 bessel_i0 (double x)
 {
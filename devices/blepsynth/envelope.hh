@@ -0,0 +1,274 @@
+// Licensed GNU LGPL v2.1 or later: http://www.gnu.org/licenses/lgpl.html
+#ifndef __BSE_DEVICES_ENVELOPE_HH__
+#define __BSE_DEVICES_ENVELOPE_HH__
+
+// based on liquidsfz envelope.hh
+
+#include <bse/bcore.hh>
+#include "devices/blepsynth/bleputils.hh"
+
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+
+namespace Bse {
+
+class Envelope
+{
+public:
+  enum class Shape { EXPONENTIAL, LINEAR };
+private:
+  /* values in seconds */
+  float delay_ = 0;
+  float attack_ = 0;
+  float hold_ = 0;
+  float decay_ = 0;
+  float sustain_ = 0; /* <- percent */
+  float release_ = 0;
+
+  int delay_len_ = 0;
+  int attack_len_ = 0;
+  int hold_len_ = 0;
+  int decay_len_ = 0;
+  int release_len_ = 0;
+  float sustain_level_ = 0;
+
+  enum class State { DELAY, ATTACK, HOLD, DECAY, SUSTAIN, RELEASE, DONE };
+
+  State state_ = State::DONE;
+  Shape shape_ = Shape::EXPONENTIAL;
+
+  struct SlopeParams {
+    int len;
+
+    double factor;
+    double delta;
+    double end;
+  } params_;
+
+  double level_ = 0;
+
+public:
+  void
+  set_shape (Shape shape)
+  {
+    shape_ = shape;
+  }
+  void
+  set_delay (float f)
+  {
+    delay_ = f;
+  }
+  void
+  set_attack (float f)
+  {
+    attack_ = f;
+  }
+  void
+  set_hold (float f)
+  {
+    hold_ = f;
+  }
+  void
+  set_decay (float f)
+  {
+    decay_ = f;
+  }
+  void
+  set_sustain (float f)
+  {
+    sustain_ = f;
+  }
+  void
+  set_release (float f)
+  {
+    release_ = f;
+  }
+  void
+  start (int sample_rate)
+  {
+    delay_len_ = std::max (int (sample_rate * delay_), 1);
+    attack_len_ = std::max (int (sample_rate * attack_), 1);
+    hold_len_ = std::max (int (sample_rate * hold_), 1);
+    decay_len_ = std::max (int (sample_rate * decay_), 1);
+    sustain_level_ = std::clamp<float> (sustain_ * 0.01, 0, 1); // percent->level
+    release_len_ = std::max (int (sample_rate * release_), 1);
+
+    level_ = 0;
+    state_ = State::DELAY;
+
+    compute_slope_params (delay_len_, 0, 0, State::DELAY);
+  }
+  void
+  stop()
+  {
+    state_ = State::RELEASE;
+    compute_slope_params (release_len_, level_, 0, State::RELEASE);
+  }
+  bool
+  done()
+  {
+    return state_ == State::DONE;
+  }
+  void
+  compute_slope_params (int len, float start_x, float end_x, State param_state)
+  {
+    params_.end = end_x;
+
+    if (param_state == State::ATTACK || param_state == State::DELAY || param_state == State::HOLD || shape_ == Shape::LINEAR)
+      {
+        // linear
+        params_.len    = len;
+        params_.delta  = (end_x - start_x) / params_.len;
+        params_.factor = 1;
+      }
+    else
+      {
+        BSE_ASSERT_RETURN (param_state == State::DECAY || param_state == State::RELEASE);
+
+        // exponential
+
+        /* true exponential decay doesn't ever reach zero; therefore we need to
+         * fade out early
+         */
+        const double RATIO = 0.001; // -60dB or 0.1% of the original height;
+
+        /* compute iterative exponential decay parameters from inputs:
+         *
+         *   - len:           half life time
+         *   - RATIO:         target ratio (when should we reach zero)
+         *   - start_x/end_x: level at start/end of the decay slope
+         *
+         * iterative computation of next value (should be done params.len times):
+         *
+         *    value = value * params.factor + params.delta
+         */
+        const double f = -log ((RATIO + 1) / RATIO) / len;
+        params_.len    = len;
+        params_.factor = exp (f);
+        params_.delta  = (end_x - RATIO * (start_x - end_x)) * (1 - params_.factor);
+      }
+  }
+
+  float
+  get_next()
+  {
+    if (state_ == State::SUSTAIN || state_ == State::DONE)
+      return level_;
+
+    level_ = level_ * params_.factor + params_.delta;
+    params_.len--;
+    if (!params_.len)
+      {
+        level_ = params_.end;
+
+        if (state_ == State::DELAY)
+          {
+            compute_slope_params (attack_len_, 0, 1, State::ATTACK);
+            state_ = State::ATTACK;
+          }
+        else if (state_ == State::ATTACK)
+          {
+            compute_slope_params (hold_len_, 1, 1, State::HOLD);
+            state_ = State::HOLD;
+          }
+        else if (state_ == State::HOLD)
+          {
+            compute_slope_params (decay_len_, 1, sustain_level_, State::DECAY);
+            state_ = State::DECAY;
+          }
+        else if (state_ == State::DECAY)
+          {
+            state_ = State::SUSTAIN;
+          }
+        else if (state_ == State::RELEASE)
+          {
+            state_ = State::DONE;
+          }
+      }
+    return level_;
+  }
+
+  /* run the envelopes of several voices side by side, the levels of up to SIMD_LANES
+   * envelopes are updated in vector lanes; the output is identical to get_next()
+   */
+  static void
+  get_next_lanes (Envelope **envelopes, uint n_envelopes, float **outputs, uint n_samples)
+  {
+    constexpr uint LANES = BlepUtils::SIMD_LANES;
+
+    uint e = 0;
+    for (; e + LANES <= n_envelopes; e += LANES)
+      do_get_next_lanes (envelopes + e, outputs + e, n_samples);
+    for (; e < n_envelopes; e++)
+      for (uint i = 0; i < n_samples; i++)
+        outputs[e][i] = envelopes[e]->get_next();
+  }
+private:
+  static void
+  do_get_next_lanes (Envelope **envelopes, float **outputs, uint n_samples)
+  {
+    using BlepUtils::LaneF64;
+    using BlepUtils::LaneF32;
+    constexpr uint LANES = BlepUtils::SIMD_LANES;
+
+    uint i = 0;
+    while (i < n_samples)
+      {
+        /* all lanes can step without a state change as long as no slope ends */
+        uint steps = n_samples - i;
+        double level_lanes[LANES], factor_lanes[LANES], delta_lanes[LANES];
+        for (uint l = 0; l < LANES; l++)
+          {
+            const Envelope& env = *envelopes[l];
+            if (env.state_ == State::SUSTAIN || env.state_ == State::DONE)
+              {
+                factor_lanes[l] = 1;
+                delta_lanes[l] = 0;
+              }
+            else
+              {
+                factor_lanes[l] = env.params_.factor;
+                delta_lanes[l] = env.params_.delta;
+                steps = std::min<uint> (steps, env.params_.len - 1);
+              }
+            level_lanes[l] = env.level_;
+          }
+        if (!steps)
+          {
+            for (uint l = 0; l < LANES; l++)
+              outputs[l][i] = envelopes[l]->get_next();
+            i++;
+            continue;
+          }
+        LaneF64 level, factor, delta;
+        memcpy (&level, level_lanes, sizeof (level));
+        memcpy (&factor, factor_lanes, sizeof (factor));
+        memcpy (&delta, delta_lanes, sizeof (delta));
+        for (uint k = i; k < i + steps; k++)
+          {
+            level = level * factor + delta;
+
+            const LaneF32 out = __builtin_convertvector (level, LaneF32);
+            float out_lanes[LANES];
+            memcpy (out_lanes, &out, sizeof (out_lanes));
+            for (uint l = 0; l < LANES; l++)
+              outputs[l][k] = out_lanes[l];
+          }
+        memcpy (level_lanes, &level, sizeof (level));
+        for (uint l = 0; l < LANES; l++)
+          {
+            Envelope& env = *envelopes[l];
+            env.level_ = level_lanes[l];
+            if (env.state_ != State::SUSTAIN && env.state_ != State::DONE)
+              env.params_.len -= steps;
+          }
+        i += steps;
+      }
+  }
+};
+
+}
+
+#endif /* __BSE_DEVICES_ENVELOPE_HH__ */
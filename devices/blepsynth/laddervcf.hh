@@ -3,6 +3,7 @@
 #define __BSE_DEVICES_LADDER_VCF_HH__
 
 #include <bse/bseresampler.hh>
+#include "devices/blepsynth/bleputils.hh"
 
 namespace Bse {
 
@@ -11,10 +12,12 @@ enum class LadderVCFMode { LP1, LP2, LP3, LP4 };
 template<bool OVERSAMPLE, bool NON_LINEAR>
 class LadderVCF
 {
-  struct Channel {
-    double x1, x2, x3, x4;
-    double y1, y2, y3, y4;
-
+  template<class Value>
+  struct Stages {
+    Value x1, x2, x3, x4;
+    Value y1, y2, y3, y4;
+  };
+  struct Channel : Stages<double> {
     // NOTE: Bse currently doesn't enforce SSE alignment so we force FPU resampling
     Resampler2 res_up   { Resampler2::UP,   Resampler2::PREC_48DB, false };
     Resampler2 res_down { Resampler2::DOWN, Resampler2::PREC_48DB, false };
@@ -120,14 +123,75 @@ private:
    * Oscillator and Filter Algorithms for Virtual Analog Synthesis.
    * Computer Music Journal. 30. 19-31. 10.1162/comj.2006.30.2.19.
    */
-  template<LadderVCFMode MODE, int CHANNEL_MASK> inline void
-  run (double *values, double fc, double res)
+  template<class Value> static void
+  compute_coefficients (Value& fc, Value& res, Value& g, Value& gg)
   {
     fc = M_PI * fc;
-    const double g = 0.9892 * fc - 0.4342 * fc * fc + 0.1381 * fc * fc * fc - 0.0202 * fc * fc * fc * fc;
-    const double gg = g * g;
+    g = 0.9892 * fc - 0.4342 * fc * fc + 0.1381 * fc * fc * fc - 0.0202 * fc * fc * fc * fc;
+    gg = g * g;
 
     res *= 1.0029 + 0.0526 * fc - 0.0926 * fc * fc + 0.0218 * fc * fc * fc;
+  }
+  static void
+  distort_lanes (BlepUtils::LaneF64& x)
+  {
+    if (NON_LINEAR)
+      {
+        /* same as distort(), the comparisons match std::clamp() */
+        const BlepUtils::LaneF64 lower = BlepUtils::LaneF64{} - 1.0, upper = BlepUtils::LaneF64{} + 1.0;
+        x = x < lower ? lower : (upper < x ? upper : x);
+        x = x - x * x * x * (1.0 / 3);
+      }
+  }
+  /* one sample through the four stages of a channel, or of several channels in SIMD lanes */
+  template<LadderVCFMode MODE, class Value> void
+  run_stages (Stages<Value>& c, Value& value, const Value& g, const Value& gg, const Value& res,
+              const Value& pre_scale, const Value& post_scale)
+  {
+    const Value x = value * pre_scale;
+    const double g_comp = 0.5; // passband gain correction
+    Value x0 = x - (c.y4 - g_comp * x) * res * 4;
+    if constexpr (std::is_same<Value, double>::value)
+      x0 = distort (x0);
+    else
+      distort_lanes (x0);
+    x0 = x0 * gg * gg * (1.0 / 1.3 / 1.3 / 1.3 / 1.3);
+
+    c.y1 = x0 + c.x1 * 0.3 + c.y1 * (1 - g);
+    c.x1 = x0;
+
+    c.y2 = c.y1 + c.x2 * 0.3 + c.y2 * (1 - g);
+    c.x2 = c.y1;
+
+    c.y3 = c.y2 + c.x3 * 0.3 + c.y3 * (1 - g);
+    c.x3 = c.y2;
+
+    c.y4 = c.y3 + c.x4 * 0.3 + c.y4 * (1 - g);
+    c.x4 = c.y3;
+
+    switch (MODE)
+      {
+        case LadderVCFMode::LP1:
+          value = c.y1 / (gg * g * (1.0 / (1.3 * 1.3 * 1.3))) * post_scale;
+          break;
+        case LadderVCFMode::LP2:
+          value = c.y2 / (gg * (1.0 / (1.3 * 1.3))) * post_scale;
+          break;
+        case LadderVCFMode::LP3:
+          value = c.y3 / (g * (1.0 / 1.3)) * post_scale;
+          break;
+        case LadderVCFMode::LP4:
+          value = c.y4 * post_scale;
+          break;
+        default:
+          BSE_ASSERT_RETURN_UNREACHED();
+      }
+  }
+  template<LadderVCFMode MODE, int CHANNEL_MASK> inline void
+  run (double *values, double fc, double res)
+  {
+    double g, gg;
+    compute_coefficients (fc, res, g, gg);
 
     constexpr uint oversample_count = OVERSAMPLE ? 2 : 1;
     for (uint os = 0; os < oversample_count; os++)
@@ -135,42 +199,7 @@ private:
         for (uint i = 0; i < channels.size(); i++)
           {
             if (need_channel<CHANNEL_MASK> (i))
-              {
-                Channel& c = channels[i];
-                const double x = values[i] * pre_scale;
-                const double g_comp = 0.5; // passband gain correction
-                const double x0 = distort (x - (c.y4 - g_comp * x) * res * 4) * gg * gg * (1.0 / 1.3 / 1.3 / 1.3 / 1.3);
-
-                c.y1 = x0 + c.x1 * 0.3 + c.y1 * (1 - g);
-                c.x1 = x0;
-
-                c.y2 = c.y1 + c.x2 * 0.3 + c.y2 * (1 - g);
-                c.x2 = c.y1;
-
-                c.y3 = c.y2 + c.x3 * 0.3 + c.y3 * (1 - g);
-                c.x3 = c.y2;
-
-                c.y4 = c.y3 + c.x4 * 0.3 + c.y4 * (1 - g);
-                c.x4 = c.y3;
-
-                switch (MODE)
-                  {
-                    case LadderVCFMode::LP1:
-                      values[i] = c.y1 / (gg * g * (1.0 / (1.3 * 1.3 * 1.3))) * post_scale;
-                      break;
-                    case LadderVCFMode::LP2:
-                      values[i] = c.y2 / (gg * (1.0 / (1.3 * 1.3))) * post_scale;
-                      break;
-                    case LadderVCFMode::LP3:
-                      values[i] = c.y3 / (g * (1.0 / 1.3)) * post_scale;
-                      break;
-                    case LadderVCFMode::LP4:
-                      values[i] = c.y4 * post_scale;
-                      break;
-                    default:
-                      BSE_ASSERT_RETURN_UNREACHED();
-                  }
-              }
+              run_stages<MODE> (static_cast<Stages<double>&> (channels[i]), values[i], g, gg, res, pre_scale, post_scale);
           }
         values += channels.size();
       }
@@ -286,6 +315,112 @@ private:
         default: BSE_ASSERT_RETURN_UNREACHED();
       }
   }
+  template<LadderVCFMode MODE> static void
+  do_run_lanes (LadderVCF    **filters,
+                uint           n_samples,
+                double         fc,
+                double         res,
+                const float  **inputs,
+                float        **outputs,
+                const float  **freq_in)
+  {
+    using BlepUtils::LaneF64;
+    constexpr int LANES = BlepUtils::SIMD_LANES;
+    constexpr uint oversample_count = OVERSAMPLE ? 2 : 1;
+
+    /* lane l runs channel l % 2 of filter l / 2 */
+    float over_samples[LANES][oversample_count * n_samples];
+    const float *lane_in[LANES];
+    float *lane_out[LANES];
+    double stages_lanes[8][LANES], pre_scale_lanes[LANES], post_scale_lanes[LANES];
+    for (int l = 0; l < LANES; l++)
+      {
+        LadderVCF& filter = *filters[l / 2];
+        Channel& c = filter.channels[l % 2];
+        if (OVERSAMPLE)
+          {
+            c.res_up.process_block (inputs[l], n_samples, over_samples[l]);
+            lane_in[l] = lane_out[l] = over_samples[l];
+          }
+        else
+          {
+            lane_in[l] = inputs[l];
+            lane_out[l] = outputs[l];
+          }
+        const double stage_values[8] = { c.x1, c.x2, c.x3, c.x4, c.y1, c.y2, c.y3, c.y4 };
+        for (int s = 0; s < 8; s++)
+          stages_lanes[s][l] = stage_values[s];
+        pre_scale_lanes[l] = filter.pre_scale;
+        post_scale_lanes[l] = filter.post_scale;
+      }
+    auto load = [] (LaneF64& v, const double *lanes) { memcpy (&v, lanes, sizeof (v)); };
+    auto store = [] (double *lanes, const LaneF64& v) { memcpy (lanes, &v, sizeof (v)); };
+    Stages<LaneF64> stages;
+    load (stages.x1, stages_lanes[0]);
+    load (stages.x2, stages_lanes[1]);
+    load (stages.x3, stages_lanes[2]);
+    load (stages.x4, stages_lanes[3]);
+    load (stages.y1, stages_lanes[4]);
+    load (stages.y2, stages_lanes[5]);
+    load (stages.y3, stages_lanes[6]);
+    load (stages.y4, stages_lanes[7]);
+    LaneF64 pre_scale, post_scale;
+    load (pre_scale, pre_scale_lanes);
+    load (post_scale, post_scale_lanes);
+
+    float freq_scale = OVERSAMPLE ? 0.5 : 1.0;
+    fc *= freq_scale;
+
+    for (uint i = 0; i < n_samples; i++)
+      {
+        LaneF64 mod_fc, mod_res = LaneF64{} + res, g, gg;
+        for (int l = 0; l < LANES; l += 2)
+          {
+            float nyquist = filters[l / 2]->rate * 0.5;
+            double filter_fc = fc;
+
+            if (freq_in[l / 2])
+              filter_fc = BSE_SIGNAL_TO_FREQ (freq_in[l / 2][i]) * freq_scale / nyquist;
+
+            mod_fc[l] = mod_fc[l + 1] = std::clamp (filter_fc, 0.0, 1.0);
+          }
+        compute_coefficients (mod_fc, mod_res, g, gg);
+
+        for (uint os = 0; os < oversample_count; os++)
+          {
+            const uint pos = i * oversample_count + os;
+            double value_lanes[LANES];
+            for (int l = 0; l < LANES; l++)
+              value_lanes[l] = lane_in[l][pos];
+
+            LaneF64 values;
+            load (values, value_lanes);
+            filters[0]->template run_stages<MODE> (stages, values, g, gg, mod_res, pre_scale, post_scale);
+            store (value_lanes, values);
+
+            for (int l = 0; l < LANES; l++)
+              lane_out[l][pos] = value_lanes[l];
+          }
+      }
+
+    store (stages_lanes[0], stages.x1);
+    store (stages_lanes[1], stages.x2);
+    store (stages_lanes[2], stages.x3);
+    store (stages_lanes[3], stages.x4);
+    store (stages_lanes[4], stages.y1);
+    store (stages_lanes[5], stages.y2);
+    store (stages_lanes[6], stages.y3);
+    store (stages_lanes[7], stages.y4);
+    for (int l = 0; l < LANES; l++)
+      {
+        Channel& c = filters[l / 2]->channels[l % 2];
+        double *stage_values[8] = { &c.x1, &c.x2, &c.x3, &c.x4, &c.y1, &c.y2, &c.y3, &c.y4 };
+        for (int s = 0; s < 8; s++)
+          *stage_values[s] = stages_lanes[s][l];
+        if (OVERSAMPLE)
+          c.res_down.process_block (over_samples[l], 2 * n_samples, outputs[l]);
+      }
+  }
 public:
   void
   run_block (uint           n_samples,
@@ -321,6 +456,44 @@ public:
                                break;
     }
   }
+  /* run_block() for several filters with both channels and no modulation besides freq_in, the filters
+   * run side by side in SIMD lanes; inputs and outputs hold left and right channel of each filter
+   */
+  static void
+  run_block_lanes (LadderVCF    **filters,
+                   uint           n_filters,
+                   uint           n_samples,
+                   double         fc,
+                   double         res,
+                   const float  **inputs,
+                   float        **outputs,
+                   const float  **freq_in)
+  {
+    constexpr uint GROUP = BlepUtils::SIMD_LANES / 2;
+    uint f = 0;
+    for (; f + GROUP <= n_filters; f += GROUP)
+      {
+        const LadderVCFMode mode = filters[f]->mode;
+        bool same_mode = true;
+        for (uint i = 1; i < GROUP; i++)
+          same_mode = same_mode && filters[f + i]->mode == mode;
+        if (!same_mode)
+          break;
+        switch (mode)
+          {
+            case LadderVCFMode::LP4: do_run_lanes<LadderVCFMode::LP4> (filters + f, n_samples, fc, res, inputs + 2 * f, outputs + 2 * f, freq_in + f);
+                                     break;
+            case LadderVCFMode::LP3: do_run_lanes<LadderVCFMode::LP3> (filters + f, n_samples, fc, res, inputs + 2 * f, outputs + 2 * f, freq_in + f);
+                                     break;
+            case LadderVCFMode::LP2: do_run_lanes<LadderVCFMode::LP2> (filters + f, n_samples, fc, res, inputs + 2 * f, outputs + 2 * f, freq_in + f);
+                                     break;
+            case LadderVCFMode::LP1: do_run_lanes<LadderVCFMode::LP1> (filters + f, n_samples, fc, res, inputs + 2 * f, outputs + 2 * f, freq_in + f);
+                                     break;
+          }
+      }
+    for (; f < n_filters; f++)
+      filters[f]->run_block (n_samples, fc, res, inputs + 2 * f, outputs + 2 * f, true, true, freq_in[f], nullptr, nullptr, nullptr);
+  }
 };
 
 // fast linear model of the filter
@@ -1,22 +1,18 @@
 // Licensed GNU LGPL v2.1 or later: http://www.gnu.org/licenses/lgpl.html
 #include "bse/processor.hh"
 #include "bse/bseieee754.hh"
+#include "devices/freeverb/revblock.hh"
 #include "bse/internal.hh"
 
 namespace {
 
-#include "revmodel.hpp"
-#include "revmodel.cpp"
-#include "allpass.cpp"
-#include "comb.cpp"
-
 using namespace Bse;
 using namespace AudioSignal;
 
 class Freeverb : public AudioSignal::Processor {
   IBusId stereoin;
   OBusId stereout;
-  revmodel model;
+  revblock model;
   void
   query_info (ProcessorInfo &info) const override
   {
@@ -82,11 +78,11 @@ class Freeverb : public AudioSignal::Processor {
   render (uint n_frames) override
   {
     adjust_params (false);
-    float *input0 = const_cast<float*> (ifloats (stereoin, 0));
-    float *input1 = const_cast<float*> (ifloats (stereoin, 1));
+    const float *input0 = ifloats (stereoin, 0);
+    const float *input1 = ifloats (stereoin, 1);
     float *output0 = oblock (stereout, 0);
     float *output1 = oblock (stereout, 1);
-    model.processreplace (input0, input1, output0, output1, n_frames, 1);
+    model.processreplace (input0, input1, output0, output1, n_frames);
   }
 };
 static auto freeverb = Bse::enroll_asp<Freeverb>();
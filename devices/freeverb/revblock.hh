@@ -0,0 +1,251 @@
+// Licensed GNU LGPL v2.1 or later: http://www.gnu.org/licenses/lgpl.html
+#ifndef __BSE_DEVICES_FREEVERB_REVBLOCK_HH__
+#define __BSE_DEVICES_FREEVERB_REVBLOCK_HH__
+
+#include "tuning.h"
+#include <algorithm>
+#include <vector>
+#include <cfloat>
+#include <cmath>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace Bse {
+
+/// Freeverb reverb model that processes whole blocks, with the left and right comb filters in SIMD lanes.
+class revblock
+{
+  static constexpr int NLANES = 2 * numcombs;           // left combs, then right combs
+  static constexpr int MAXCHUNK = 128;                  // must not exceed the shortest delay line
+  static_assert (MAXCHUNK <= allpasstuningL4 && MAXCHUNK <= combtuningL1, "chunk size exceeds delay lines");
+  static_assert (NLANES % 4 == 0, "combs must fill SIMD lanes");
+  struct DelayLine {
+    float *buffer = nullptr;
+    int    size = 0;
+    int    idx = 0;
+  };
+  DelayLine          combs_[NLANES];
+  DelayLine          allpassesL_[numallpasses], allpassesR_[numallpasses];
+  alignas (16) float filterstore_[NLANES] = { 0, };
+  std::vector<float> storage_;
+  float gain_ = 0, roomsize_ = 0, roomsize1_ = 0, damp_ = 0, damp1_ = 0, damp2_ = 0;
+  float wet_ = 0, wet1_ = 0, wet2_ = 0, dry_ = 0, width_ = 0, mode_ = 0;
+  int   dampmode_ = 0;
+  static inline float
+  undenormal (float v)
+  {
+    return fabsf (v) >= FLT_MIN ? v : 0.0f;     // same as undenormalise(), without branches
+  }
+  void
+  update()
+  {
+    // mirrors revmodel::update() and comb::setdamp()
+    wet1_ = wet_ * (width_ / 2 + 0.5f);
+    wet2_ = wet_ * ((1 - width_) / 2);
+    const bool frozen = mode_ >= freezemode;
+    roomsize1_ = frozen ? 1 : roomsize_;
+    const float damp1 = frozen ? 0 : damp_;
+    gain_ = frozen ? muted : fixedgain;
+    damp1_ = damp1;
+    damp2_ = 1 - damp1;
+    if (dampmode_ == -1)
+      damp1_ = -damp1_;
+    else if (dampmode_ == 0)
+      damp1_ = 0;
+  }
+  static void
+  process_allpasses (DelayLine *allpasses, float *values, int n)
+  {
+    for (int i = 0; i < numallpasses; i++)
+      {
+        DelayLine &ap = allpasses[i];
+        for (int k = 0; k < n; )
+          {
+            // contiguous segment up to the ring buffer wrap, no dependencies within a chunk
+            const int l = std::min (n - k, ap.size - ap.idx);
+            float *buffer = ap.buffer + ap.idx;
+            int j = 0;
+#ifdef __SSE2__
+            const __m128 absmask = _mm_castsi128_ps (_mm_set1_epi32 (0x7fffffff)), fltmin = _mm_set1_ps (FLT_MIN);
+            const __m128 signmask = _mm_castsi128_ps (_mm_set1_epi32 (int (0x80000000))), feedback = _mm_set1_ps (0.5f);
+            for (; j + 4 <= l; j += 4)
+              {
+                __m128 bufout = _mm_loadu_ps (buffer + j);
+                bufout = _mm_and_ps (bufout, _mm_cmpge_ps (_mm_and_ps (bufout, absmask), fltmin));
+                const __m128 input = _mm_loadu_ps (values + k + j);
+                _mm_storeu_ps (values + k + j, _mm_add_ps (_mm_xor_ps (input, signmask), bufout));
+                _mm_storeu_ps (buffer + j, _mm_add_ps (input, _mm_mul_ps (bufout, feedback)));
+              }
+#endif
+            for (; j < l; j++)
+              {
+                const float bufout = undenormal (buffer[j]);
+                const float input = values[k + j];
+                values[k + j] = -input + bufout;
+                buffer[j] = input + bufout * 0.5f;
+              }
+            k += l;
+            ap.idx += l;
+            if (ap.idx >= ap.size)
+              ap.idx = 0;
+          }
+      }
+  }
+  void
+  process_chunk (const float *inputL, const float *inputR, float *outputL, float *outputR, int n)
+  {
+    // comb major layout, so delay lines are copied and outputs summed with contiguous vectors
+    alignas (16) float delayed[NLANES][MAXCHUNK];
+    alignas (16) float feed[NLANES][MAXCHUNK];
+    alignas (16) float input[MAXCHUNK], outL[MAXCHUNK], outR[MAXCHUNK];
+    for (int k = 0; k < n; k++)
+      input[k] = (inputL[k] + inputR[k]) * gain_;
+    for (int c = 0; c < NLANES; c++)
+      {
+        const DelayLine &comb = combs_[c];
+        const int l = std::min (n, comb.size - comb.idx);
+        std::copy (comb.buffer + comb.idx, comb.buffer + comb.idx + l, delayed[c]);
+        std::copy (comb.buffer, comb.buffer + n - l, delayed[c] + l);
+      }
+    // run the damping recursion of 4 combs per vector, 4 samples at a time
+    int k = 0;
+#ifdef __SSE2__
+    const __m128 absmask = _mm_castsi128_ps (_mm_set1_epi32 (0x7fffffff)), fltmin = _mm_set1_ps (FLT_MIN);
+    const __m128 damp1 = _mm_set1_ps (damp1_), damp2 = _mm_set1_ps (damp2_), feedback = _mm_set1_ps (roomsize1_);
+    auto undenormal4 = [absmask, fltmin] (__m128 v) {
+      return _mm_and_ps (v, _mm_cmpge_ps (_mm_and_ps (v, absmask), fltmin));
+    };
+    __m128 fs[NLANES / 4];
+    for (int v = 0; v < NLANES / 4; v++)
+      fs[v] = _mm_load_ps (filterstore_ + v * 4);
+    for (; k + 4 <= n; k += 4)
+      for (int v = 0; v < NLANES / 4; v++)
+        {
+          const int c = v * 4;
+          __m128 o0 = _mm_load_ps (&delayed[c + 0][k]), o1 = _mm_load_ps (&delayed[c + 1][k]);
+          __m128 o2 = _mm_load_ps (&delayed[c + 2][k]), o3 = _mm_load_ps (&delayed[c + 3][k]);
+          _MM_TRANSPOSE4_PS (o0, o1, o2, o3);   // now one vector per sample, one lane per comb
+          __m128 *o[4] = { &o0, &o1, &o2, &o3 }, f[4];
+          for (int j = 0; j < 4; j++)
+            {
+              *o[j] = undenormal4 (*o[j]);
+              fs[v] = undenormal4 (_mm_add_ps (_mm_mul_ps (*o[j], damp2), _mm_mul_ps (fs[v], damp1)));
+              f[j] = _mm_add_ps (_mm_set1_ps (input[k + j]), _mm_mul_ps (fs[v], feedback));
+            }
+          _MM_TRANSPOSE4_PS (o0, o1, o2, o3);
+          _MM_TRANSPOSE4_PS (f[0], f[1], f[2], f[3]);
+          _mm_store_ps (&delayed[c + 0][k], o0);
+          _mm_store_ps (&delayed[c + 1][k], o1);
+          _mm_store_ps (&delayed[c + 2][k], o2);
+          _mm_store_ps (&delayed[c + 3][k], o3);
+          for (int j = 0; j < 4; j++)
+            _mm_store_ps (&feed[c + j][k], f[j]);
+        }
+    for (int v = 0; v < NLANES / 4; v++)
+      _mm_store_ps (filterstore_ + v * 4, fs[v]);
+#endif
+    for (; k < n; k++)
+      for (int c = 0; c < NLANES; c++)
+        {
+          const float output = undenormal (delayed[c][k]);
+          filterstore_[c] = undenormal (output * damp2_ + filterstore_[c] * damp1_);
+          delayed[c][k] = output;
+          feed[c][k] = input[k] + filterstore_[c] * roomsize1_;
+        }
+    for (int c = 0; c < NLANES; c++)
+      {
+        DelayLine &comb = combs_[c];
+        const int l = std::min (n, comb.size - comb.idx);
+        std::copy (feed[c], feed[c] + l, comb.buffer + comb.idx);
+        std::copy (feed[c] + l, feed[c] + n, comb.buffer);
+        comb.idx = l < n ? n - l : comb.idx + n;
+        if (comb.idx >= comb.size)
+          comb.idx = 0;
+      }
+    // accumulate comb outputs in the same order as revmodel
+    std::fill (outL, outL + n, 0.0f);
+    std::fill (outR, outR + n, 0.0f);
+    for (int c = 0; c < numcombs; c++)
+      for (int k = 0; k < n; k++)
+        {
+          outL[k] += delayed[c][k];
+          outR[k] += delayed[numcombs + c][k];
+        }
+    process_allpasses (allpassesL_, outL, n);
+    process_allpasses (allpassesR_, outR, n);
+    for (int k = 0; k < n; k++)
+      {
+        const float l = outL[k] * wet1_ + outR[k] * wet2_ + inputL[k] * dry_;
+        const float r = outR[k] * wet1_ + outL[k] * wet2_ + inputR[k] * dry_;
+        outputL[k] = l;         // inputs and outputs may alias
+        outputR[k] = r;
+      }
+  }
+public:
+  revblock()
+  {
+    const int combtuning[NLANES] = { combtuningL1, combtuningL2, combtuningL3, combtuningL4,
+                                     combtuningL5, combtuningL6, combtuningL7, combtuningL8,
+                                     combtuningR1, combtuningR2, combtuningR3, combtuningR4,
+                                     combtuningR5, combtuningR6, combtuningR7, combtuningR8 };
+    const int allpasstuningL[numallpasses] = { allpasstuningL1, allpasstuningL2, allpasstuningL3, allpasstuningL4 };
+    const int allpasstuningR[numallpasses] = { allpasstuningR1, allpasstuningR2, allpasstuningR3, allpasstuningR4 };
+    size_t total = 0;
+    for (int c = 0; c < NLANES; c++)
+      total += combtuning[c];
+    for (int i = 0; i < numallpasses; i++)
+      total += allpasstuningL[i] + allpasstuningR[i];
+    storage_.resize (total);
+    float *mem = storage_.data();
+    auto assign = [&mem] (DelayLine &line, int size) {
+      line.buffer = mem;
+      line.size = size;
+      mem += size;
+    };
+    for (int c = 0; c < NLANES; c++)
+      assign (combs_[c], combtuning[c]);
+    for (int i = 0; i < numallpasses; i++)
+      {
+        assign (allpassesL_[i], allpasstuningL[i]);
+        assign (allpassesR_[i], allpasstuningR[i]);
+      }
+    setwet (initialwet);
+    setroomsize (initialroom);
+    setdry (initialdry);
+    setdamp (initialdamp, +1);
+    setwidth (initialwidth);
+    setmode (initialmode);
+    mute();
+  }
+  void
+  mute()
+  {
+    if (getmode() >= freezemode)
+      return;
+    std::fill (storage_.begin(), storage_.end(), 0.0f);
+  }
+  void
+  processreplace (const float *inputL, const float *inputR, float *outputL, float *outputR, long numsamples)
+  {
+    for (long offset = 0; offset < numsamples; offset += MAXCHUNK)
+      process_chunk (inputL + offset, inputR + offset, outputL + offset, outputR + offset,
+                     std::min (numsamples - offset, long (MAXCHUNK)));
+  }
+  void  setroomsize (float value)       { roomsize_ = value * scaleroom + offsetroom; update(); }
+  float getroomsize ()                  { return (roomsize_ - offsetroom) / scaleroom; }
+  void  setdamp (float value, int mode) { damp_ = value * scaledamp; dampmode_ = mode; update(); }
+  float getdamp ()                      { return damp_ / scaledamp; }
+  void  setwet (float value)            { wet_ = value * scalewet; update(); }
+  float getwet ()                       { return wet_ / scalewet; }
+  void  setdry (float value)            { dry_ = value * scaledry; }
+  float getdry ()                       { return dry_ / scaledry; }
+  void  setwidth (float value)          { width_ = value; update(); }
+  float getwidth ()                     { return width_; }
+  void  setmode (float value)           { mode_ = value; update(); }
+  float getmode ()                      { return mode_ >= freezemode ? 1 : 0; }
+};
+
+} // Bse
+
+#endif // __BSE_DEVICES_FREEVERB_REVBLOCK_HH__
@@ -1730,7 +1730,27 @@ export let shm_array_float32 = undefined;	// assigned by shm_receive
 export let shm_array_float64 = undefined;	// assigned by shm_receive
 shm_receive (null);
 
+const SHM_DELTA_MAGIC = 0x41544c44; // "DLTA", see bseserver.cc
+
+/// Apply delta frame runs (bpos, blength, bytes) to the last full frame.
+function shm_receive_delta (arraybuffer) {
+  const header = new Uint32Array (arraybuffer, 0, 2);
+  if (!shm_array_active || header[1] != shm_array_buffer.byteLength)
+    return; // out of sync, wait for the next full frame
+  const bytes = new Uint8Array (shm_array_buffer);
+  let pos = 8;
+  while (pos + 8 <= arraybuffer.byteLength)
+    {
+      const [ bpos, blength ] = new Uint32Array (arraybuffer, pos, 2);
+      pos += 8;
+      bytes.set (new Uint8Array (arraybuffer, pos, blength), bpos);
+      pos += ((blength + 3) / 4 ^0) * 4;
+    }
+}
+
 export function shm_receive (arraybuffer) {
+  if (arraybuffer && arraybuffer.byteLength >= 8 && new Uint32Array (arraybuffer, 0, 1)[0] == SHM_DELTA_MAGIC)
+    return shm_receive_delta (arraybuffer);
   shm_array_active = frame_handler_active && arraybuffer && shm_array_binary_size <= arraybuffer.byteLength;
   if (shm_array_active)
     shm_array_buffer = arraybuffer;
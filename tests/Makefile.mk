@@ -10,12 +10,14 @@ tests/suite.sources		::= $(strip	\
 	tests/basics.cc				\
 	tests/aida-types.cc			\
 	tests/benchmarks.cc			\
+	tests/blepsynthtest.cc			\
 	tests/blocktests.cc			\
 	tests/checkserialize.cc			\
 	tests/explore-tests.cc			\
 	tests/filterdesign.cc			\
 	tests/filtertest.cc			\
 	tests/firhandle.cc			\
+	tests/freeverbtest.cc			\
 	tests/ipc.cc				\
 	tests/loophandle.cc			\
 	tests/misctests.cc			\
@@ -2,7 +2,16 @@
 #include <bse/testing.hh>
 #include <bse/unicode.hh>
 #include <bse/memory.hh>
+#include <bse/combo.hh>
+#include <bse/gsldatautils.hh>
+#include <bse/bseladspa.hh>
+#include <bse/bseplugin.hh>
+#include "devices/blepsynth/bleposc.hh"
 #include <cmath>
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
 
 static constexpr size_t RUNS = 1;
 static constexpr double MAXTIME = 0.15;
@@ -369,3 +378,321 @@ aligned_allocator_bench31_fast_mem_alloc()
 TEST_BENCH (aligned_allocator_bench31_fast_mem_alloc);
 
 } // Anon
+
+// == AudioSignal::Engine ==
+namespace { // Anon
+using namespace Bse;
+using namespace Bse::AudioSignal;
+
+class BenchLoad : public AudioSignal::Processor {
+  IBusId stereoin;
+  OBusId stereout;
+  double phase_ = 0;
+  void
+  query_info (ProcessorInfo &info) const override
+  {
+    info.uri = "Bse.Tests.BenchLoad";
+    info.label = "BenchLoad";
+  }
+  void
+  configure (uint n_ibusses, const SpeakerArrangement *ibusses, uint n_obusses, const SpeakerArrangement *obusses) override
+  {
+    remove_all_buses();
+    stereoin = add_input_bus  ("Stereo In",  SpeakerArrangement::STEREO);
+    stereout = add_output_bus ("Stereo Out", SpeakerArrangement::STEREO);
+  }
+  void
+  reset () override
+  {
+    phase_ = 0;
+  }
+  void
+  render (uint n_frames) override
+  {
+    for (uint c = 0; c < 2; c++)
+      {
+        const float *input = ifloats (stereoin, c);
+        float *output = oblock (stereout, c);
+        for (uint i = 0; i < n_frames; i++)
+          {
+            phase_ += 0.0001;
+            output[i] = 0.5 * input[i] + 0.01 * std::sin (phase_ + input[i]);
+          }
+      }
+  }
+};
+static auto bench_load = Bse::enroll_asp<BenchLoad>();
+
+static void
+engine_render_bench (uint n_chains, uint chain_length, const char *what)
+{
+  constexpr const uint RATE = 48000, BLOCKS = 64, BLOCK_SIZE = 128;
+  AudioTiming timing { 120, 0 };
+  Engine engine (RATE, BLOCK_SIZE, timing, [] () {});
+  std::vector<ChainP> chains;
+  for (uint i = 0; i < n_chains; i++)
+    {
+      ChainP chain = std::dynamic_pointer_cast<Chain> (Processor::registry_create (engine, "Bse.AudioSignal.Chain"));
+      TASSERT (chain != nullptr);
+      for (uint j = 0; j < chain_length; j++)
+        chain->insert (Processor::registry_create (engine, "Bse.Tests.BenchLoad"));
+      engine.add_root (chain);
+      chains.push_back (chain);
+    }
+  auto render_loop = [&engine] () {
+    for (size_t j = 0; j < BLOCKS; j++)
+      engine.render_block (BLOCK_SIZE);
+  };
+  Bse::Test::Timer timer (MAXTIME);
+  const double audio_time = BLOCKS * BLOCK_SIZE / double (RATE);
+  engine.set_render_threads (0);
+  engine.make_schedule();
+  const double serial_time = timer.benchmark (render_loop);
+  const uint n_threads = std::max (2, this_thread_online_cpus()) - 1;
+  engine.set_render_threads (n_threads);
+  engine.make_schedule();
+  const double parallel_time = timer.benchmark (render_loop);
+  Bse::printerr ("  BENCH    Engine::render_block %-6s %3ux%-3u serial: %7.1fx realtime  %2u+1 threads: %7.1fx realtime  speedup: %5.2f\n",
+                 what, n_chains, chain_length, audio_time / serial_time, n_threads, audio_time / parallel_time,
+                 serial_time / parallel_time);
+  engine.set_render_threads (0);
+  for (auto chain : chains)
+    engine.del_root (chain);
+}
+
+static void
+engine_render_bench_wide()
+{
+  engine_render_bench (48, 4, "wide");
+}
+TEST_BENCH (engine_render_bench_wide);
+
+static void
+engine_render_bench_deep()
+{
+  engine_render_bench (4, 48, "deep");
+}
+TEST_BENCH (engine_render_bench_deep);
+
+static void
+engine_block_size_bench()
+{
+  constexpr const uint RATE = 48000, N_FRAMES = 64 * 1024;
+  AudioTiming timing { 120, 0 };
+  for (uint block_size : { 128, 256, 512, 1024 })
+    {
+      Engine engine (RATE, block_size, timing, [] () {});
+      std::vector<ChainP> chains;
+      for (uint i = 0; i < 16; i++)
+        {
+          ChainP chain = std::dynamic_pointer_cast<Chain> (Processor::registry_create (engine, "Bse.AudioSignal.Chain"));
+          TASSERT (chain != nullptr);
+          for (uint j = 0; j < 4; j++)
+            chain->insert (Processor::registry_create (engine, "Bse.Tests.BenchLoad"));
+          engine.add_root (chain);
+          chains.push_back (chain);
+        }
+      engine.make_schedule();
+      auto render_loop = [&engine, block_size] () {
+        for (size_t j = 0; j < N_FRAMES / block_size; j++)
+          engine.render_block (block_size);
+      };
+      Bse::Test::Timer timer (MAXTIME);
+      const double audio_time = N_FRAMES / double (RATE);
+      const double render_time = timer.benchmark (render_loop);
+      Bse::printerr ("  BENCH    Engine::render_block %4u frames/block: %7.1fx realtime  %6.2f Mframes/s\n",
+                     block_size, audio_time / render_time, N_FRAMES / render_time / 1000000.0);
+      for (auto chain : chains)
+        engine.del_root (chain);
+    }
+}
+TEST_BENCH (engine_block_size_bench);
+
+static void
+engine_reschedule_bench()
+{
+  constexpr const uint RATE = 48000, BLOCK_SIZE = 128, CHAIN_LENGTH = 8, REPEATS = 16;
+  AudioTiming timing { 120, 0 };
+  auto make_chain = [] (Engine &engine) {
+    ChainP chain = std::dynamic_pointer_cast<Chain> (Processor::registry_create (engine, "Bse.AudioSignal.Chain"));
+    TASSERT (chain != nullptr);
+    for (uint j = 0; j < CHAIN_LENGTH; j++)
+      chain->insert (Processor::registry_create (engine, "Bse.Tests.BenchLoad"));
+    return chain;
+  };
+  for (uint n_procs : { 64, 256, 1024, 4096 })
+    {
+      Engine engine (RATE, BLOCK_SIZE, timing, [] () {});
+      std::vector<ChainP> chains;
+      for (uint i = 0; i < n_procs / CHAIN_LENGTH; i++)
+        {
+          chains.push_back (make_chain (engine));
+          engine.add_root (chains.back());
+        }
+      engine.make_schedule();
+      // full rebuild, as needed after disconnecting scheduled Processors
+      uint64 full_nsecs = -1;
+      for (uint r = 0; r < REPEATS; r++)
+        {
+          const uint64 t0 = timestamp_benchmark();
+          engine.reschedule();
+          engine.make_schedule();
+          full_nsecs = std::min (full_nsecs, timestamp_benchmark() - t0);
+        }
+      // incremental extension by a single chain
+      uint64 extend_nsecs = -1;
+      for (uint r = 0; r < REPEATS; r++)
+        {
+          ChainP extra = make_chain (engine);
+          const uint64 t0 = timestamp_benchmark();
+          engine.add_root (extra);
+          engine.make_schedule();
+          extend_nsecs = std::min (extend_nsecs, timestamp_benchmark() - t0);
+          TASSERT (engine.in_schedule (*extra));
+          engine.del_root (extra);
+          engine.make_schedule();
+          TASSERT (!engine.in_schedule (*extra));
+        }
+      Bse::printerr ("  BENCH    Engine::make_schedule %4u processors  full: %8.1fus  add chain: %6.1fus\n",
+                     n_procs, full_nsecs / 1000.0, extend_nsecs / 1000.0);
+      for (auto chain : chains)
+        engine.del_root (chain);
+    }
+}
+TEST_BENCH (engine_reschedule_bench);
+
+// == BlepSynth Tests ==
+static void
+blep_unison_bench()
+{
+  // 32 voice polyphony, 2 oscillators per voice with 16 unison voices each
+  constexpr const uint RATE = 48000, BLOCK_SIZE = 128, N_FRAMES = 16 * 1024;
+  std::vector<Bse::BlepUtils::OscImpl> oscs (32 * 2);
+  for (size_t i = 0; i < oscs.size(); i++)
+    {
+      oscs[i].set_rate (RATE);
+      oscs[i].frequency_base = 110 * (1 + i % 24 / 12.0);
+      oscs[i].set_unison (16, 10, 0.5);
+    }
+  float left[BLOCK_SIZE], right[BLOCK_SIZE], freq_mod[BLOCK_SIZE];
+  for (uint i = 0; i < BLOCK_SIZE; i++)
+    freq_mod[i] = 0.01 * sin (i * 0.05);
+  for (bool simd_lanes : { false, true })
+    for (bool modulated : { false, true })
+      {
+        for (auto &osc : oscs)
+          osc.simd_lanes = simd_lanes;
+        auto render_loop = [&] () {
+          for (size_t j = 0; j < N_FRAMES / BLOCK_SIZE; j++)
+            for (auto &osc : oscs)
+              osc.process_sample_stereo (left, right, BLOCK_SIZE, nullptr, modulated ? freq_mod : nullptr);
+        };
+        Bse::Test::Timer timer (MAXTIME);
+        const double audio_time = N_FRAMES / double (RATE);
+        const double render_time = timer.benchmark (render_loop);
+        Bse::printerr ("  BENCH    BlepOsc 32 voices x 2 osc x 16 unison%s%s: %6.2fx realtime\n",
+                       simd_lanes ? " lanes " : " scalar", modulated ? " +fmod" : "      ", audio_time / render_time);
+      }
+}
+TEST_BENCH (blep_unison_bench);
+
+// == Sample Format Conversion ==
+static const GslWaveFormatType conv_formats[] = {
+  GSL_WAVE_FORMAT_UNSIGNED_8, GSL_WAVE_FORMAT_SIGNED_8, GSL_WAVE_FORMAT_ALAW, GSL_WAVE_FORMAT_ULAW,
+  GSL_WAVE_FORMAT_UNSIGNED_12, GSL_WAVE_FORMAT_SIGNED_12, GSL_WAVE_FORMAT_UNSIGNED_16, GSL_WAVE_FORMAT_SIGNED_16,
+  GSL_WAVE_FORMAT_SIGNED_24, GSL_WAVE_FORMAT_SIGNED_24_PAD4, GSL_WAVE_FORMAT_SIGNED_32, GSL_WAVE_FORMAT_FLOAT,
+};
+
+static void
+sample_conversion_bench()
+{
+  constexpr const uint N_VALUES = 16 * 1024;
+  std::vector<float> values (N_VALUES), floats (N_VALUES);
+  std::vector<uint8> bytes (N_VALUES * 4);
+  for (uint i = 0; i < N_VALUES; i++)
+    values[i] = sin (i * 0.01);
+  const char *simd_name = gsl_conv_simd_impl_name();
+  for (auto format : conv_formats)
+    {
+      const bool law = format == GSL_WAVE_FORMAT_ALAW || format == GSL_WAVE_FORMAT_ULAW;
+      double encode[2] = { 0, 0 }, decode[2] = { 0, 0 };
+      for (bool simd : { false, true })
+        {
+          gsl_conv_simd_disable (!simd);
+          auto encode_loop = [&] () {
+            gsl_conv_from_float_clip (format, G_BIG_ENDIAN, values.data(), bytes.data(), N_VALUES);
+          };
+          auto decode_loop = [&] () {
+            gsl_conv_to_float (format, G_BIG_ENDIAN, bytes.data(), floats.data(), N_VALUES);
+          };
+          Bse::Test::Timer timer (MAXTIME);
+          if (!law)
+            encode[simd] = N_VALUES / timer.benchmark (encode_loop) / M;
+          decode[simd] = N_VALUES / timer.benchmark (decode_loop) / M;
+        }
+      gsl_conv_simd_disable (false);
+      Bse::printerr ("  BENCH    gsl_conv %-14s big-endian  encode: %7.1f -> %7.1f  decode: %7.1f -> %7.1f MSamples/s (%s)\n",
+                     gsl_wave_format_to_string (format), encode[0], encode[1], decode[0], decode[1], simd_name);
+    }
+}
+TEST_BENCH (sample_conversion_bench);
+
+static void
+registry_startup_bench()
+{
+  // The registry caches only pay off in new processes, so the real startup paths are timed in
+  // fresh test processes, first with an empty cache directory (cold), then with a filled one (warm)
+  if (const char *phase = getenv ("BSE_REGISTRY_BENCH"))
+    {
+      uint n_plugins = 0, n_ladspa = 0;
+      const uint64 t0 = timestamp_benchmark();
+      for (SfiRing *ring = bse_plugin_path_list_files (true, true); ring; )
+        {
+          char *name = (char*) sfi_ring_pop_head (&ring);
+          n_plugins += bse_plugin_check_load (name) == NULL;
+          g_free (name);
+        }
+      const uint64 t1 = timestamp_benchmark();
+      for (const String &file : bse_ladspa_plugin_path_list_files())
+        n_ladspa += bse_ladspa_plugin_check_load (file.c_str()) == NULL;
+      const uint64 t2 = timestamp_benchmark();
+      const size_t n_processors = Processor::registry_list().size(); // runs Processor::registry_init()
+      const uint64 t3 = timestamp_benchmark();
+      Bse::printerr ("  BENCH    Registry %s: %3u plugins %8.1fus  %3u LADSPA %8.1fus  %3u Processors %8.1fus\n", phase,
+                     n_plugins, (t1 - t0) / 1000.0, n_ladspa, (t2 - t1) / 1000.0, n_processors, (t3 - t2) / 1000.0);
+      return;
+    }
+  char cachehome[] = "/tmp/registry-bench-XXXXXX";
+  TASSERT (mkdtemp (cachehome) != NULL);
+  const String exe = Path::realpath ("/proc/self/exe");
+  for (const char *phase : { "cold", "warm" })
+    {
+      // prepare the environment before fork(), the child may only exec
+      StringVector env { string_format ("XDG_CACHE_HOME=%s", cachehome), string_format ("BSE_REGISTRY_BENCH=%s", phase) };
+      for (char **e = environ; *e; e++)
+        if (strncmp (*e, "XDG_CACHE_HOME=", 15) != 0 && strncmp (*e, "BSE_REGISTRY_BENCH=", 19) != 0)
+          env.push_back (*e);
+      std::vector<char*> envp;
+      for (String &e : env)
+        envp.push_back (&e[0]);
+      envp.push_back (nullptr);
+      const char *const argv[] = { exe.c_str(), "--bench", "registry_startup_bench", nullptr };
+      const pid_t child = fork();
+      if (child == 0)
+        {
+          const int devnull = open ("/dev/null", O_WRONLY);
+          dup2 (devnull, 1);            // keep the BENCH line on stderr, silence the test runner
+          execve (argv[0], (char**) argv, envp.data());
+          _exit (127);
+        }
+      TASSERT (child > 0);
+      int wstatus = 0;
+      TASSERT (waitpid (child, &wstatus, 0) == child);
+      TASSERT (WIFEXITED (wstatus) && WEXITSTATUS (wstatus) == 0);
+    }
+  std::error_code ec;
+  std::filesystem::remove_all (cachehome, ec);
+}
+TEST_BENCH (registry_startup_bench);
+
+} // Anon
@@ -0,0 +1,163 @@
+// Licensed GNU LGPL v2.1 or later: http://www.gnu.org/licenses/lgpl.html
+#include <bse/testing.hh>
+#include "bse/bsemathsignal.hh"
+#include "devices/blepsynth/bleposc.hh"
+#include "devices/blepsynth/laddervcf.hh"
+#include "devices/blepsynth/envelope.hh"
+
+namespace { // Anon
+
+using namespace Bse;
+
+// the SIMD lanes are checked against the scalar code, which serves as reference
+static double
+max_diff (const std::vector<float>& a, const std::vector<float>& b)
+{
+  double maxdiff = 0;
+  for (size_t i = 0; i < a.size(); i++)
+    maxdiff = std::max<double> (maxdiff, fabs (a[i] - b[i]));
+  return maxdiff;
+}
+
+static void
+blep_osc_lanes_test()
+{
+  const size_t N = 48000 / 4;
+  const uint block_sizes[] = { 128, 1, 7, 300, 33, 64 };
+  std::vector<float> freq_mod (N), shape_mod (N);
+  for (size_t i = 0; i < N; i++)
+    {
+      freq_mod[i] = 0.3 * sin (i * 0.001);
+      shape_mod[i] = Test::random_frange (-1, +1);
+    }
+  for (uint unison : { 1, 3, 4, 5, 16 })
+    for (bool modulated : { false, true })
+      {
+        BlepUtils::OscImpl simd;
+        simd.set_rate (48000);
+        simd.frequency_base = 220;
+        simd.shape_base = 0.3;
+        simd.sub_base = 0.4;
+        simd.sync_base = modulated ? 7 : 0;
+        simd.set_unison (unison, 10, 0.5);      // randomizes the unison phases
+        BlepUtils::OscImpl scalar = simd;
+        scalar.simd_lanes = false;
+        std::vector<float> sL (N), sR (N), vL (N), vR (N);
+        for (size_t offset = 0, b = 0; offset < N; b++)
+          {
+            const size_t n = std::min (size_t (block_sizes[b % BSE_ARRAY_SIZE (block_sizes)]), N - offset);
+            const float *fmod = modulated ? &freq_mod[offset] : nullptr;
+            const float *smod = modulated ? &shape_mod[offset] : nullptr;
+            scalar.process_sample_stereo (&sL[offset], &sR[offset], n, nullptr, fmod, smod);
+            simd.process_sample_stereo (&vL[offset], &vR[offset], n, nullptr, fmod, smod);
+            offset += n;
+          }
+        double energy = 0;
+        for (size_t i = 0; i < N; i++)
+          energy += sL[i] * sL[i];
+        TASSERT (energy > 1);   // oscillator produced output at all
+        TCMP (max_diff (sL, vL), <=, 1e-5);
+        TCMP (max_diff (sR, vR), <=, 1e-5);
+      }
+}
+TEST_ADD (blep_osc_lanes_test);
+
+static void
+ladder_vcf_lanes_test()
+{
+  const uint N_FILTERS = 5, N = 48000 / 4, BLOCK_SIZE = 100;
+  std::vector<float> input (N);
+  for (auto& v : input)
+    v = Test::random_frange (-1, +1);
+  for (LadderVCFMode mode : { LadderVCFMode::LP1, LadderVCFMode::LP2, LadderVCFMode::LP3, LadderVCFMode::LP4 })
+    {
+      std::vector<LadderVCFNonLinear> simd (N_FILTERS), scalar (N_FILTERS);
+      LadderVCFNonLinear *filters[N_FILTERS];
+      for (uint f = 0; f < N_FILTERS; f++)
+        {
+          simd[f].set_mode (mode);
+          scalar[f].set_mode (mode);
+          simd[f].set_drive (f * 6);
+          scalar[f].set_drive (f * 6);
+          filters[f] = &simd[f];
+        }
+      std::vector<float> sout (2 * N_FILTERS * N), vout (2 * N_FILTERS * N);
+      for (uint offset = 0; offset < N; offset += BLOCK_SIZE)
+        {
+          float freq_in[N_FILTERS][BLOCK_SIZE];
+          const float *freq_ins[N_FILTERS], *inputs[2 * N_FILTERS];
+          float *soutputs[2 * N_FILTERS], *voutputs[2 * N_FILTERS];
+          for (uint f = 0; f < N_FILTERS; f++)
+            {
+              for (uint i = 0; i < BLOCK_SIZE; i++)
+                freq_in[f][i] = BSE_SIGNAL_FROM_FREQ (500 + 200 * f + 300 * sin ((offset + i) * 0.002));
+              freq_ins[f] = f == 1 ? nullptr : freq_in[f];      // filter 1 runs with the fixed cutoff
+              for (uint c = 0; c < 2; c++)
+                {
+                  inputs[2 * f + c] = &input[offset];
+                  soutputs[2 * f + c] = &sout[(2 * f + c) * N + offset];
+                  voutputs[2 * f + c] = &vout[(2 * f + c) * N + offset];
+                }
+            }
+          for (uint f = 0; f < N_FILTERS; f++)
+            scalar[f].run_block (BLOCK_SIZE, 0.1, 0.8, inputs + 2 * f, soutputs + 2 * f, true, true, freq_ins[f], nullptr, nullptr, nullptr);
+          LadderVCFNonLinear::run_block_lanes (filters, N_FILTERS, BLOCK_SIZE, 0.1, 0.8, inputs, voutputs, freq_ins);
+        }
+      TCMP (max_diff (sout, vout), <=, 1e-5);
+    }
+}
+TEST_ADD (ladder_vcf_lanes_test);
+
+static void
+envelope_lanes_test()
+{
+  const uint N_ENVELOPES = 7, N = 48000 / 2;
+  const uint block_sizes[] = { 128, 1, 7, 300, 33, 64 };
+  std::vector<Envelope> simd (N_ENVELOPES);
+  Envelope *envelopes[N_ENVELOPES];
+  for (uint e = 0; e < N_ENVELOPES; e++)
+    {
+      Envelope& env = simd[e];
+      env.set_delay (e * 0.001);
+      env.set_attack (0.01 + e * 0.005);
+      env.set_hold (e % 2 * 0.01);
+      env.set_decay (0.02 + e * 0.01);
+      env.set_sustain (10 * e);
+      env.set_release (0.05);
+      if (e % 3 == 0)
+        env.set_shape (Envelope::Shape::LINEAR);
+      env.start (48000);
+      envelopes[e] = &env;
+    }
+  std::vector<Envelope> scalar = simd;
+  std::vector<float> sout (N_ENVELOPES * N), vout (N_ENVELOPES * N);
+  bool released = false;
+  for (size_t offset = 0, b = 0; offset < N; b++)
+    {
+      const size_t n = std::min (size_t (block_sizes[b % BSE_ARRAY_SIZE (block_sizes)]), N - offset);
+      if (!released && offset >= N / 2)         // release every other envelope half way through
+        {
+          for (uint e = 0; e < N_ENVELOPES; e += 2)
+            {
+              simd[e].stop();
+              scalar[e].stop();
+            }
+          released = true;
+        }
+      float *outputs[N_ENVELOPES];
+      for (uint e = 0; e < N_ENVELOPES; e++)
+        {
+          outputs[e] = &vout[e * N + offset];
+          for (size_t i = 0; i < n; i++)
+            sout[e * N + offset + i] = scalar[e].get_next();
+        }
+      Envelope::get_next_lanes (envelopes, N_ENVELOPES, outputs, n);
+      offset += n;
+    }
+  for (uint e = 0; e < N_ENVELOPES; e++)
+    TCMP (simd[e].done(), ==, scalar[e].done());
+  TCMP (max_diff (sout, vout), <=, 1e-6);
+}
+TEST_ADD (envelope_lanes_test);
+
+} // Anon
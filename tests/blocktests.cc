@@ -209,6 +209,41 @@ test_scale (void)
   TPASS ("BlockScale");
 }
 
+static void
+test_odd_sizes (void)
+{
+  // exercise vector tails and unaligned blocks
+  float fblock1[160], fblock2[160], fblock3[160];
+  for (guint offset = 0; offset < 4; offset++)
+    for (guint n = 0; n <= 67; n++)
+      {
+        float *ovalues = fblock1 + offset, *ivalues = fblock2 + offset;
+        build_ascending_random_block (160, fblock2);
+        Bse::Block::fill (160, fblock1, 1.f);
+        Bse::Block::add (n, ovalues, ivalues);
+        Bse::Block::mul (n, ovalues, ivalues);
+        for (guint i = 0; i < 160; i++)
+          if (i < offset || i >= offset + n)
+            TASSERT (fblock1[i] == 1.f);
+          else
+            TASSERT (fblock1[i] == (1.f + fblock2[i]) * fblock2[i]);
+        Bse::Block::fill (160, fblock3, 0.f);
+        Bse::Block::interleave2 (n, fblock3, ivalues, 1);
+        Bse::Block::interleave2_add (n, fblock3, ivalues, 1);
+        for (guint i = 0; i < 160; i++)
+          TASSERT (fblock3[i] == (i & 1 && i / 2 < n ? 2 * ivalues[i / 2] : 0.f));
+        const float correct_min_value = n ? ivalues[0] : 0, correct_max_value = n ? ivalues[n - 1] : 0;
+        block_shuffle (n, ivalues);
+        float min_value = 0, max_value = 0, square_sum = 0;
+        for (guint i = 0; i < n; i++)
+          square_sum += ivalues[i] * ivalues[i];
+        const float sum = Bse::Block::range_and_square_sum (n, ivalues, min_value, max_value);
+        TASSERT (fabs (sum - square_sum) <= 1e-5 * square_sum);
+        TASSERT (min_value == correct_min_value && max_value == correct_max_value);
+      }
+  TPASS ("BlockOddSizes");
+}
+
 #define RUNS        11
 #define MAX_SECONDS 0.1
 const int BLOCK_SIZE = 1024;
@@ -225,7 +260,7 @@ bench_fill ()
   };
   Bse::Test::Timer timer (MAX_SECONDS);
   const double bench_time = timer.benchmark (loop);
-  TPASS ("Block::fill       # timing: fastest=%fs throughput=%.1fMB/s\n", bench_time, bytes_per_loop / bench_time / 1048576.);
+  TPASS ("%-6s Block::fill       # timing: fastest=%fs throughput=%.1fMB/s\n", Bse::Block::impl_name(), bench_time, bytes_per_loop / bench_time / 1048576.);
 }
 
 static inline void
@@ -242,7 +277,7 @@ bench_copy (void)
   };
   Bse::Test::Timer timer (MAX_SECONDS);
   const double bench_time = timer.benchmark (loop);
-  TPASS ("Block::copy       # timing: fastest=%fs throughput=%.1fMB/s\n", bench_time, bytes_per_loop / bench_time / 1048576.);
+  TPASS ("%-6s Block::copy       # timing: fastest=%fs throughput=%.1fMB/s\n", Bse::Block::impl_name(), bench_time, bytes_per_loop / bench_time / 1048576.);
 }
 
 static inline void
@@ -259,7 +294,7 @@ bench_add (void)
   };
   Bse::Test::Timer timer (MAX_SECONDS);
   const double bench_time = timer.benchmark (loop);
-  TPASS ("Block::add        # timing: fastest=%fs throughput=%.1fMB/s\n", bench_time, bytes_per_loop / bench_time / 1048576.);
+  TPASS ("%-6s Block::add        # timing: fastest=%fs throughput=%.1fMB/s\n", Bse::Block::impl_name(), bench_time, bytes_per_loop / bench_time / 1048576.);
 }
 
 static inline void
@@ -276,7 +311,7 @@ bench_sub (void)
   };
   Bse::Test::Timer timer (MAX_SECONDS);
   const double bench_time = timer.benchmark (loop);
-  TPASS ("Block::sub        # timing: fastest=%fs throughput=%.1fMB/s\n", bench_time, bytes_per_loop / bench_time / 1048576.);
+  TPASS ("%-6s Block::sub        # timing: fastest=%fs throughput=%.1fMB/s\n", Bse::Block::impl_name(), bench_time, bytes_per_loop / bench_time / 1048576.);
 }
 
 static inline void
@@ -293,7 +328,7 @@ bench_mul (void)
   };
   Bse::Test::Timer timer (MAX_SECONDS);
   const double bench_time = timer.benchmark (loop);
-  TPASS ("Block::mul        # timing: fastest=%fs throughput=%.1fMB/s\n", bench_time, bytes_per_loop / bench_time / 1048576.);
+  TPASS ("%-6s Block::mul        # timing: fastest=%fs throughput=%.1fMB/s\n", Bse::Block::impl_name(), bench_time, bytes_per_loop / bench_time / 1048576.);
 }
 
 static inline void
@@ -310,7 +345,7 @@ bench_scale (void)
   };
   Bse::Test::Timer timer (MAX_SECONDS);
   const double bench_time = timer.benchmark (loop);
-  TPASS ("Block::scale      # timing: fastest=%fs throughput=%.1fMB/s\n", bench_time, bytes_per_loop / bench_time / 1048576.);
+  TPASS ("%-6s Block::scale      # timing: fastest=%fs throughput=%.1fMB/s\n", Bse::Block::impl_name(), bench_time, bytes_per_loop / bench_time / 1048576.);
 }
 
 static inline void
@@ -335,7 +370,7 @@ bench_range (void)
   const double bench_time = timer.benchmark (loop);
   assert_return (min_value == correct_min_value);
   assert_return (max_value == correct_max_value);
-  TPASS ("Block::range      # timing: fastest=%fs throughput=%.1fMB/s\n", bench_time, bytes_per_loop / bench_time / 1048576.);
+  TPASS ("%-6s Block::range      # timing: fastest=%fs throughput=%.1fMB/s\n", Bse::Block::impl_name(), bench_time, bytes_per_loop / bench_time / 1048576.);
 }
 
 static inline void
@@ -351,7 +386,7 @@ bench_square_sum (void)
   };
   Bse::Test::Timer timer (MAX_SECONDS);
   const double bench_time = timer.benchmark (loop);
-  TPASS ("Block::sum²       # timing: fastest=%fs throughput=%.1fMB/s\n", bench_time, bytes_per_loop / bench_time / 1048576.);
+  TPASS ("%-6s Block::sum²       # timing: fastest=%fs throughput=%.1fMB/s\n", Bse::Block::impl_name(), bench_time, bytes_per_loop / bench_time / 1048576.);
 }
 
 static inline void
@@ -376,7 +411,7 @@ bench_range_and_square_sum (void)
   const double bench_time = timer.benchmark (loop);
   assert_return (min_value == correct_min_value);
   assert_return (max_value == correct_max_value);
-  TPASS ("Block::range+sum² # timing: fastest=%fs throughput=%.1fMB/s\n", bench_time, bytes_per_loop / bench_time / 1048576.);
+  TPASS ("%-6s Block::range+sum² # timing: fastest=%fs throughput=%.1fMB/s\n", Bse::Block::impl_name(), bench_time, bytes_per_loop / bench_time / 1048576.);
 }
 
 static void
@@ -388,6 +423,7 @@ run_tests()
   test_sub();
   test_mul();
   test_scale();
+  test_odd_sizes();
   /* the next two functions test the range_and_square_sum function, too */
   test_range();
   test_square_sum();
@@ -410,16 +446,19 @@ test_blockutils()
   Bse::String machine = sv.size() >= 2 ? sv[1] : "Unknown";
   printout ("  NOTE     Running on: %s+%s\n", machine.c_str(), bse_block_impl_name());
 
-  TNOTE ("Running Default Block Ops");
-  TASSERT (Bse::Block::default_singleton() == Bse::Block::current_singleton());
-  run_tests(); /* run tests on FPU */
-
-  /* check for possible specialization */
-  if (Bse::Block::default_singleton() == Bse::Block::current_singleton())
-    return;   /* nothing changed */
+  // the widest implementation supported by the CPU is selected during bse initialization
+  const std::vector<Bse::Block::Impl*> impls = Bse::Block::available_singletons();
+  TASSERT (impls.back() == Bse::Block::default_singleton());
+  TASSERT (impls.back() == Bse::Block::current_singleton());
 
-  TNOTE ("Running Intrinsic Block Ops");
-  TASSERT (Bse::Block::default_singleton() != Bse::Block::current_singleton());
-  run_tests(); /* run tests with intrinsics */
+  // run tests and benchmarks for every implementation to compare them
+  for (auto impl : impls)
+    {
+      Bse::Block::select_singleton (impl);
+      TNOTE ("Running %s Block Ops", Bse::Block::impl_name());
+      run_tests();
+    }
+  Bse::Block::select_singleton (nullptr);
+  TASSERT (impls.back() == Bse::Block::current_singleton());
 }
 TEST_ADD (test_blockutils);
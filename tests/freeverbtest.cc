@@ -0,0 +1,59 @@
+// Licensed GNU LGPL v2.1 or later: http://www.gnu.org/licenses/lgpl.html
+#include <bse/testing.hh>
+#include "devices/freeverb/revblock.hh"
+
+namespace { // Anon
+
+// scalar reference model, as shipped by Jezar
+#include "devices/freeverb/revmodel.hpp"
+#include "devices/freeverb/revmodel.cpp"
+#include "devices/freeverb/allpass.cpp"
+#include "devices/freeverb/comb.cpp"
+
+using namespace Bse;
+
+static void
+freeverb_block_test()
+{
+  const size_t N = 2 * 48000;
+  std::vector<float> inL (N), inR (N);
+  for (size_t i = 0; i < N; i++)       // burst of noise and a sine, followed by the reverb tail
+    {
+      inL[i] = i < N / 8 ? Test::random_frange (-1, +1) : 0;
+      inR[i] = i < N / 8 ? sin (i * 0.05) : 0;
+    }
+  const uint block_sizes[] = { 1, 7, 128, 300, 1024, 33, 64 };
+  // damping modes: 1 = "Signflip 2000", 0 = "VLC Damping", -1 = "Normal Damping"
+  for (int mode : { 1, 0, -1 })
+    {
+      std::unique_ptr<revmodel> scalar (new revmodel());
+      std::unique_ptr<revblock> simd (new revblock());
+      scalar->setdamp (0.7, mode);
+      simd->setdamp (0.7, mode);
+      scalar->setroomsize (0.9);
+      simd->setroomsize (0.9);
+      scalar->setwidth (0.6);
+      simd->setwidth (0.6);
+      scalar->setdry (0.25);
+      simd->setdry (0.25);
+      std::vector<float> sL (N), sR (N), vL (N), vR (N);
+      for (size_t offset = 0, b = 0; offset < N; b++)
+        {
+          const size_t n = std::min (size_t (block_sizes[b % BSE_ARRAY_SIZE (block_sizes)]), N - offset);
+          scalar->processreplace (&inL[offset], &inR[offset], &sL[offset], &sR[offset], n, 1);
+          simd->processreplace (&inL[offset], &inR[offset], &vL[offset], &vR[offset], n);
+          offset += n;
+        }
+      double maxdiff = 0, energy = 0;
+      for (size_t i = 0; i < N; i++)
+        {
+          maxdiff = std::max (maxdiff, std::max (fabs (sL[i] - vL[i]), fabs (sR[i] - vR[i])));
+          energy += sL[i] * sL[i];
+        }
+      TASSERT (energy > 1);     // reverb produced output at all
+      TCMP (maxdiff, <=, 1e-6);
+    }
+}
+TEST_ADD (freeverb_block_test);
+
+} // Anon
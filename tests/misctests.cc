@@ -6,6 +6,10 @@
 #include <bse/bsecxxplugin.hh> // for generated types
 #include "jsonipc/testjsonipc.cc" // test_jsonipc
 #include <bse/signalmath.hh>
+#include <bse/bsemidievent.hh>
+#include <bse/midievent.hh>
+#include <bse/combo.hh>
+#include <bse/bseengine.hh>
 
 static void
 test_jsonipc_functions()
@@ -330,6 +334,204 @@ fast_math_bench()
 }
 TEST_BENCH (fast_math_bench);
 
+static void
+midi_event_pool_test()
+{
+  // recycled events must come back zero initialized
+  BseMidiEvent *events[64];
+  for (uint i = 0; i < 64; i++)
+    events[i] = bse_midi_event_note_on (1 + i % 16, i, 440, 0.5);
+  for (uint i = 0; i < 64; i++)
+    bse_midi_free_event (events[i]);
+  for (uint i = 0; i < 64; i++)
+    {
+      events[i] = bse_midi_alloc_event();
+      TASSERT (events[i]->status == 0 && events[i]->channel == 0 && events[i]->delta_time == 0);
+      TASSERT (events[i]->data.note.frequency == 0 && events[i]->next_pending == NULL);
+      events[i]->status = BSE_MIDI_NOTE_OFF;
+    }
+  for (uint i = 0; i < 64; i++)
+    bse_midi_free_event (events[i]);
+}
+TEST_ADD (midi_event_pool_test);
+
+static void
+event_stream_test()
+{
+  using namespace Bse::AudioSignal;
+  EventStream estream (4);
+  TASSERT (estream.capacity() == 4 && estream.empty());
+  estream.append (-2, make_note_on (1, 60, 1));
+  estream.append (5, make_note_on (1, 62, 1));
+  estream.append (0, make_note_off (1, 60, 1));         // out of order, inserted sorted
+  estream.append (5, make_note_off (1, 62, 1));         // same frame, after earlier events
+  TASSERT (estream.size() == 4 && estream.last_frame() == 5);
+  const int16 frames[] = { -2, 0, 5, 5 };
+  const uint8 keys[] = { 60, 60, 62, 62 };
+  const Event *ev = estream.begin();
+  for (size_t i = 0; i < estream.size(); i++)
+    TASSERT (ev[i].frame == frames[i] && ev[i].key == keys[i]);
+  TASSERT (ev[2].type == Event::NOTE_ON && ev[3].type == Event::NOTE_OFF);
+  // full streams drop events instead of allocating
+  estream.append (7, make_note_on (1, 64, 1));
+  TASSERT (estream.size() == 4 && estream.overflows() == 1);
+  estream.reserve (8);
+  TASSERT (estream.size() == 4 && estream.overflows() == 0 && estream.begin()->key == 60);
+  estream.clear();
+  TASSERT (estream.empty() && estream.capacity() == 8);
+  // frames cover blocks larger than 128
+  estream.append (1023, make_note_on (1, 64, 1));
+  estream.append (200, make_note_off (1, 64, 1));
+  TASSERT (estream.size() == 2 && estream.begin()->frame == 200 && estream.last_frame() == 1023);
+}
+TEST_ADD (event_stream_test);
+
+// == Processor parameter events ==
+using namespace Bse::AudioSignal;
+
+template<bool SAMPLE_ACCURATE>
+class ParamProbe : public AudioSignal::Processor {
+  OBusId stereout;
+  void
+  query_info (ProcessorInfo &info) const override
+  {
+    info.uri = SAMPLE_ACCURATE ? "Bse.Tests.ParamProbe.SampleAccurate" : "Bse.Tests.ParamProbe";
+    info.label = "ParamProbe";
+  }
+  void
+  initialize () override
+  {
+    pid_level = add_param ("Level", "Lvl", 0, 100, 50);
+  }
+  void
+  configure (uint n_ibusses, const SpeakerArrangement *ibusses, uint n_obusses, const SpeakerArrangement *obusses) override
+  {
+    remove_all_buses();
+    stereout = add_output_bus ("Stereo Out", SpeakerArrangement::STEREO);
+    if (SAMPLE_ACCURATE)
+      prepare_param_events();
+  }
+  void
+  reset () override
+  {}
+  void
+  render (uint n_frames) override
+  {
+    float *output = oblock (stereout, 0);
+    double level = get_param (pid_level);
+    uint i = 0;
+    for (const ParamEvent &ev : get_param_events())
+      {
+        for (; i < ev.frame; i++)
+          output[i] = level;
+        level = ev.value;
+      }
+    for (; i < n_frames; i++)
+      output[i] = level;
+    floatfill (oblock (stereout, 1), 0.f, n_frames);
+  }
+public:
+  ParamId pid_level = {};
+};
+static auto param_probe = Bse::enroll_asp<ParamProbe<false>>();
+static auto param_probe_sa = Bse::enroll_asp<ParamProbe<true>>();
+
+static void
+engine_param_events_test()
+{
+  constexpr const uint RATE = 48000, BLOCK_SIZE = 128;
+  AudioTiming timing { 120, 0 };
+  Engine engine (RATE, BLOCK_SIZE, timing, [] () {});
+  for (bool sample_accurate : { false, true })
+    {
+      const char *uri = sample_accurate ? "Bse.Tests.ParamProbe.SampleAccurate" : "Bse.Tests.ParamProbe";
+      ProcessorP proc = Processor::registry_create (engine, uri);
+      TASSERT (proc != nullptr);
+      const ParamId pid = ParamId (1);             // first parameter added by initialize()
+      TASSERT (engine.in_schedule (*proc) == false);
+      engine.add_root (proc);
+      engine.make_schedule();
+      TASSERT (engine.in_schedule (*proc) == true);
+      // schedule two changes within the next block and one in the block after it
+      const uint64 start = engine.frame_counter();
+      Processor::param_schedule_mt (proc, pid, 25, start + 32);
+      Processor::param_schedule_mt (proc, pid, 75, start + 96);
+      Processor::param_schedule_mt (proc, pid, 100, start + BLOCK_SIZE + 10);
+      engine.render_block (BLOCK_SIZE);
+      const float *output = proc->ofloats (OBusId (1), 0);
+      if (sample_accurate)
+        {
+          TCMP (output[0], ==, 50);
+          TCMP (output[31], ==, 50);
+          TCMP (output[32], ==, 25);
+          TCMP (output[95], ==, 25);
+          TCMP (output[96], ==, 75);
+        }
+      else
+        {
+          TCMP (output[0], ==, 75);
+          TCMP (output[96], ==, 75);
+        }
+      TCMP (output[BLOCK_SIZE - 1], ==, 75);
+      TCMP (Processor::param_peek_mt (proc, pid), ==, 75);
+      engine.render_block (BLOCK_SIZE);
+      TCMP (output[9], ==, sample_accurate ? 75 : 100);
+      TCMP (output[10], ==, 100);
+      TCMP (Processor::param_peek_mt (proc, pid), ==, 100);
+      // out of range values are clamped like set_param()
+      Processor::param_schedule_mt (proc, pid, 1000);
+      engine.render_block (BLOCK_SIZE);
+      TCMP (output[0], ==, 100);
+      Processor::param_schedule_mt (proc, pid, -1);
+      engine.render_block (BLOCK_SIZE);
+      TCMP (output[0], ==, 0);
+      engine.del_root (proc);
+      engine.make_schedule();
+      TASSERT (engine.in_schedule (*proc) == false);
+      // processors outside of the schedule are assigned right away
+      Processor::param_apply_mt (proc, pid, 60);
+      TCMP (Processor::param_peek_mt (proc, pid), ==, 60);
+    }
+}
+TEST_ADD (engine_param_events_test);
+
+// == Engine job statistics ==
+static void
+engine_job_stats_test()
+{
+  constexpr const uint N_TRANS = 5, N_JOBS = 7;
+  static BseEngineTelemetry telemetry;  // the master thread may still write to it after removal
+  BseEngineJobStats before, after;
+  bse_engine_telemetry (&telemetry);
+  bse_engine_job_stats (&before);
+  for (uint t = 0; t < N_TRANS; t++)
+    {
+      BseTrans *trans = bse_trans_open();
+      for (uint j = 0; j < N_JOBS; j++)
+        bse_trans_add (trans, bse_job_nop());
+      bse_trans_commit (trans);
+    }
+  bse_engine_wait_on_trans();
+  // counters are updated at the end of the dispatch cycle that executed the jobs, after the telemetry
+  const volatile guint32 &telemetry_jobs = telemetry.n_jobs;
+  const guint32 expected_jobs = before.n_jobs + N_TRANS * N_JOBS;
+  for (uint i = 0; i < 5000 && gint32 (telemetry_jobs - expected_jobs) < 0; i++)
+    g_usleep (1000);
+  bse_engine_telemetry (NULL);
+  bse_engine_job_stats (&after);
+  const guint64 n_transactions = after.n_transactions - before.n_transactions;
+  TCMP (n_transactions, >=, N_TRANS);
+  TCMP (after.n_jobs - before.n_jobs, >=, N_TRANS * N_JOBS);
+  TCMP (after.n_dispatches, >, before.n_dispatches);
+  TCMP (after.max_dispatch_jobs, >=, N_JOBS);   // a transaction executes within a single dispatch cycle
+  TCMP (after.latency_total, >, before.latency_total);
+  TCMP (after.latency_max * n_transactions, >=, after.latency_total - before.latency_total);
+  TCMP (guint32 (telemetry.n_jobs - before.n_jobs), >=, N_TRANS * N_JOBS);
+  TCMP (guint32 (telemetry.n_transactions - before.n_transactions), >=, N_TRANS);
+  TCMP (telemetry.max_dispatch_jobs, >=, N_JOBS);
+}
+TEST_ADD (engine_job_stats_test);
+
 #if 0
 int
 main (gint   argc,
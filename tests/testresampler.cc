@@ -906,6 +906,101 @@ TEST_PERF (testresampler_check_performance_sub24);
 static void testresampler_check_performance_over24()    { run_perf (RES_OVERSAMPLE, 24); }
 TEST_PERF (testresampler_check_performance_over24);
 
+// == ResamplerN tests ==
+/* resample sine signals across the passband and return the maximum error in dB */
+static double
+resamplern_max_error_db (double in_rate, double out_rate, int bits, bool use_sse, uint block_size)
+{
+  ResamplerN resampler (in_rate, out_rate, Resampler2::find_precision_for_bits (bits), use_sse);
+  const double nyquist = 0.5 * min (in_rate, out_rate), fmax = 0.8 * nyquist;
+  const uint n_input = 8192;
+  vector<float> input (n_input), output (resampler.output_length (n_input) + 1);
+  double max_error = 0;
+  for (double freq = 50; freq < fmax; freq += fmax / 11)
+    {
+      resampler.reset();
+      for (uint i = 0; i < n_input; i++)
+        input[i] = sin (2 * M_PI * freq * i / in_rate);
+      uint n_output = 0;
+      for (uint i = 0; i < n_input; i += block_size)
+        n_output += resampler.process_block (&input[i], min (block_size, n_input - i), &output[n_output]);
+      /* output sample k is located at input time k / out_rate, skip the zero padded edges */
+      const uint skip = resampler.output_length (resampler.order()) + 1;
+      for (uint k = skip; k + skip < n_output; k++)
+        max_error = max (max_error, fabs (output[k] - sin (2 * M_PI * freq * k / out_rate)));
+    }
+  return 20 * log (max_error) / log (10);
+}
+
+static void
+testresampler_check_resamplern_precision()
+{
+  const struct { int bits; double threshold; } checks[] = {
+    { 8, 39 }, { 12, 66 }, { 16, 88 }, { 20, 112 }, { 24, 119 },
+  };
+  for (auto rates : { std::make_pair (44100., 48000.), std::make_pair (48000., 44100.), std::make_pair (22050., 96000.) })
+    for (auto check : checks)
+      for (bool use_sse : { false, true })
+        {
+          const double error_db = resamplern_max_error_db (rates.first, rates.second, check.bits, use_sse, check.bits * 5);
+          if (options.verbose)
+            printf ("ResamplerN %.0f -> %.0f, %d bits%s: %.1f dB\n", rates.first, rates.second, check.bits, use_sse ? " SSE" : "", error_db);
+          TCMP (error_db, <, -check.threshold);
+        }
+}
+TEST_ADD (testresampler_check_resamplern_precision);
+
+static void
+testresampler_check_resamplern_seeking()
+{
+  /* random access via process_frames() must match streaming output */
+  ResamplerN resampler (8000, 44100, Resampler2::PREC_96DB);
+  TCMP (resampler.phases(), ==, 441u);
+  TCMP (resampler.step(), ==, 80u);
+  vector<float> input (4000), output (resampler.output_length (input.size()) + 1), frames (1000);
+  for (auto &v : input)
+    v = g_random_double_range (-1, 1);
+  uint n_output = 0;
+  for (uint i = 0; i < input.size(); i += 100)
+    n_output += resampler.process_block (&input[i], 100, &output[n_output]);
+  TCMP (n_output, ==, resampler.output_length (input.size() - resampler.lookahead()));
+  const int64 first = 12345;
+  vector<float> window (resampler.input_length (first, frames.size()));
+  for (size_t i = 0; i < window.size(); i++)
+    window[i] = input[resampler.input_index (first) - resampler.history() + i];
+  resampler.process_frames (&window[0], first, frames.size(), &frames[0]);
+  for (size_t i = 0; i < frames.size(); i++)
+    TCMP (frames[i], ==, output[first + i]);
+}
+TEST_ADD (testresampler_check_resamplern_seeking);
+
+static void
+testresampler_check_resamplern_performance()
+{
+  const uint n_input = 48000, block_size = 256;
+  vector<float> input (n_input), output (n_input * 2);
+  for (uint i = 0; i < n_input; i++)
+    input[i] = sin (i * 0.05);
+  for (int bits : { 1, 8, 16, 24 })
+    for (auto rates : { std::make_pair (44100., 48000.), std::make_pair (48000., 44100.) })
+      {
+        ResamplerN resampler (rates.first, rates.second, Resampler2::find_precision_for_bits (bits));
+        const double start_time = gettime();
+        uint64 n_output = 0, runs = 0;
+        while (gettime() - start_time < 0.1)
+          {
+            for (uint i = 0; i < n_input; i += block_size)
+              n_output += resampler.process_block (&input[i], block_size, &output[0]);
+            runs++;
+          }
+        const double seconds = gettime() - start_time;
+        printf ("  BENCH    ResamplerN %.0f -> %.0f, %2d bits, %2u taps%s: %7.2f Msamples/s, %6.1fx realtime\n",
+                rates.first, rates.second, bits, resampler.order(), resampler.sse_enabled() ? " SSE" : "    ",
+                n_output / seconds / 1000000, runs * n_input / rates.first / seconds);
+      }
+}
+TEST_BENCH (testresampler_check_resamplern_performance);
+
 int
 test_resampler (int argc, char **argv)
 {
@@ -1,6 +1,10 @@
 // Licensed GNU LGPL v2.1 or later: http://www.gnu.org/licenses/lgpl.html
 #include <bse/gslwavechunk.hh>
 #include <bse/gsldatahandle.hh>
+#include <bse/gsldatautils.hh>
+#include <bse/gslfilehash.hh>
+#include <bse/gsldatahandle-vorbis.hh>
+#include <bse/gslvorbis-enc.hh>
 #include <bse/bsemain.hh>
 #include <bse/testing.hh>
 #include <stdio.h>
@@ -10,6 +14,7 @@
 #include <sys/stat.h>
 #include <fcntl.h>
 #include <math.h>
+#include <thread>
 
 using namespace Bse;
 
@@ -378,3 +383,425 @@ multi_channel_tests()
     }
 }
 TEST_ADD (multi_channel_tests);
+
+static void
+data_cache_readahead_test()
+{
+  const size_t n_nodes = 64, node_size = BSE_DCACHE_BLOCK_SIZE / sizeof (GslDataType);
+  const size_t n_values = n_nodes * node_size;
+  float *values = (float*) malloc (n_values * sizeof (float));
+  for (size_t i = 0; i < n_values; i++)
+    values[i] = i;
+  GslDataHandle *dhandle = gsl_data_handle_new_mem (1, 32, 44100, 440, n_values, values, free); // I/O threads may hold a reference
+  GslDataCache *dcache = gsl_data_cache_new (dhandle, 1);
+  gsl_data_handle_unref (dhandle);
+  gsl_data_cache_open (dcache);
+  // stream sequentially through all nodes, like GslWaveChunk playback
+  for (size_t offset = 0; offset < n_values; offset += node_size / 4)
+    {
+      GslDataCacheNode *dnode = gsl_data_cache_ref_node (dcache, offset, GSL_DATA_CACHE_DEMAND_LOAD);
+      TASSERT (dnode && dnode->data);
+      TASSERT (dnode->data[offset - dnode->offset] == offset);
+      gsl_data_cache_unref_node (dcache, dnode);
+    }
+  const GslDataCacheStats stats = gsl_data_cache_get_stats (dcache);
+  TASSERT (stats.n_hits + stats.n_misses + stats.n_stalls == 4 * n_nodes);
+  TASSERT (stats.n_misses + stats.n_prefetched <= n_nodes);   // no node is read twice
+  gsl_data_cache_close (dcache);
+  gsl_data_cache_unref (dcache);
+}
+TEST_ADD (data_cache_readahead_test);
+
+static void
+data_cache_budget_test()
+{
+  const size_t n_nodes = 64, node_size = BSE_DCACHE_BLOCK_SIZE / sizeof (GslDataType);
+  const size_t n_values = n_nodes * node_size;
+  float *values = (float*) malloc (n_values * sizeof (float));
+  for (size_t i = 0; i < n_values; i++)
+    values[i] = -float (i);
+  GslDataHandle *dhandle = gsl_data_handle_new_mem (1, 32, 44100, 440, n_values, values, free);
+  GslDataCache *dcache = gsl_data_cache_new (dhandle, 1);
+  gsl_data_handle_unref (dhandle);
+  gsl_data_cache_open (dcache);
+  const uint64 saved_budget = gsl_data_cache_get_memory_budget();
+  gsl_data_cache_set_memory_budget (n_values * sizeof (float) / 4);
+  for (size_t offset = 0; offset < n_values; offset += node_size)
+    {
+      GslDataCacheNode *dnode = gsl_data_cache_ref_node (dcache, offset, GSL_DATA_CACHE_DEMAND_LOAD);
+      TASSERT (dnode && dnode->data[offset - dnode->offset] == -float (offset));
+      gsl_data_cache_unref_node (dcache, dnode);
+    }
+  // eviction after unref_node() is left to an I/O thread, setting the budget evicts synchronously
+  gsl_data_cache_set_memory_budget (n_values * sizeof (float) / 4);
+  // revisit the start, which must have been evicted and is read again
+  GslDataCacheNode *dnode = gsl_data_cache_ref_node (dcache, 0, GSL_DATA_CACHE_DEMAND_LOAD);
+  TASSERT (dnode && dnode->data[0] == 0);
+  gsl_data_cache_unref_node (dcache, dnode);
+  const GslDataCacheStats stats = gsl_data_cache_get_stats (dcache);
+  TASSERT (stats.n_evicted > 0);
+  TASSERT (stats.n_bytes < n_values * sizeof (float));
+  gsl_data_cache_set_memory_budget (saved_budget);
+  gsl_data_cache_close (dcache);
+  gsl_data_cache_unref (dcache);
+}
+TEST_ADD (data_cache_budget_test);
+
+struct CountingHandle {
+  GslDataHandle     dhandle;
+  const float      *values;
+  int64             n_values;
+  std::atomic<int>  n_reads;
+};
+static Bse::Error
+counting_handle_open (GslDataHandle *dhandle, GslDataHandleSetup *setup)
+{
+  CountingHandle *chandle = (CountingHandle*) dhandle;
+  setup->n_channels = 1;
+  setup->n_values = chandle->n_values;
+  setup->bit_depth = 32;
+  setup->mix_freq = 44100;
+  setup->needs_cache = TRUE;
+  dhandle->content_id = 0x7e57c0de;     // like a decoder for the same file
+  return Bse::Error::NONE;
+}
+static int64
+counting_handle_read (GslDataHandle *dhandle, int64 voffset, int64 n_values, float *values)
+{
+  CountingHandle *chandle = (CountingHandle*) dhandle;
+  chandle->n_reads++;
+  n_values = MIN (n_values, chandle->n_values - voffset);
+  memcpy (values, chandle->values + voffset, n_values * sizeof (float));
+  return n_values;
+}
+static void
+counting_handle_close (GslDataHandle *dhandle)
+{}
+static void
+counting_handle_destroy (GslDataHandle *dhandle)
+{
+  gsl_data_handle_common_free (dhandle);
+  delete (CountingHandle*) dhandle;
+}
+static GslDataHandleFuncs counting_handle_vtable = {
+  counting_handle_open,
+  counting_handle_read,
+  counting_handle_close,
+  NULL,
+  NULL,
+  counting_handle_destroy,
+};
+
+static void
+data_cache_pcm_tier_test()
+{
+  const size_t n_nodes = 32, node_size = BSE_DCACHE_BLOCK_SIZE / sizeof (GslDataType);
+  const size_t n_values = n_nodes * node_size;
+  std::vector<float> values (n_values);
+  for (size_t i = 0; i < n_values; i++)
+    values[i] = i * 0.5;
+  CountingHandle *chandles[2];
+  for (auto &chandle : chandles)
+    {
+      chandle = new CountingHandle();
+      TASSERT (gsl_data_handle_common_init (&chandle->dhandle, "counting-handle"));
+      chandle->dhandle.vtable = &counting_handle_vtable;
+      chandle->values = values.data();
+      chandle->n_values = n_values;
+    }
+  // keep only a few decoded nodes in memory, the rest is spilled to the scratch file
+  gsl_data_cache_set_pcm_budget (8 * BSE_DCACHE_BLOCK_SIZE, 64 * 1024 * 1024);
+  const uint64 saved_budget = gsl_data_cache_get_memory_budget();
+  GslDataCache *dcache = gsl_data_cache_new (&chandles[0]->dhandle, 1);
+  gsl_data_cache_open (dcache);
+  auto play_loop = [] (GslDataCache *dcache, size_t n_values) {
+    for (size_t offset = 0; offset < n_values; offset += node_size / 2)
+      {
+        GslDataCacheNode *dnode = gsl_data_cache_ref_node (dcache, offset, GSL_DATA_CACHE_DEMAND_LOAD);
+        TASSERT (dnode && dnode->data[offset - dnode->offset] == offset * 0.5);
+        gsl_data_cache_unref_node (dcache, dnode);
+      }
+  };
+  play_loop (dcache, n_values);
+  const int n_decoded = chandles[0]->n_reads;
+  TASSERT (n_decoded > 0);
+  // further loop iterations after eviction of all nodes need no decoding
+  for (int i = 0; i < 3; i++)
+    {
+      gsl_data_cache_set_memory_budget (0);
+      gsl_data_cache_set_memory_budget (saved_budget);
+      play_loop (dcache, n_values);
+    }
+  TASSERT (chandles[0]->n_reads == n_decoded);
+  GslDataCacheStats stats = gsl_data_cache_get_stats (dcache);
+  TASSERT (stats.n_pcm_hits >= n_nodes);
+  stats = gsl_data_cache_get_stats (NULL);
+  TASSERT (stats.n_pcm_scratch > 0);
+  // another handle for the same contents shares the decoded nodes
+  GslDataCache *dcache2 = gsl_data_cache_new (&chandles[1]->dhandle, 1);
+  gsl_data_cache_open (dcache2);
+  play_loop (dcache2, n_values);
+  TASSERT (chandles[1]->n_reads == 0);
+  gsl_data_cache_close (dcache2);
+  gsl_data_cache_unref (dcache2);
+  gsl_data_cache_close (dcache);
+  gsl_data_cache_unref (dcache);
+  for (auto &chandle : chandles)
+    gsl_data_handle_unref (&chandle->dhandle);
+  gsl_data_cache_set_pcm_budget (BSE_DCACHE_PCM_MEMORY, BSE_DCACHE_PCM_SCRATCH);
+}
+TEST_ADD (data_cache_pcm_tier_test);
+
+static void
+mapped_wave_handle_test()
+{
+  const size_t n_values = 4096, header = 44;
+  char fname[] = "/tmp/testwavechunk-XXXXXX";
+  const int fd = mkstemp (fname);
+  TASSERT (fd >= 0);
+  // a fake header followed by int16 samples, followed by host order float samples
+  guint8 hbytes[header] = { 0, };
+  TASSERT (write (fd, hbytes, header) == ssize_t (header));
+  int16 *svalues = (int16*) malloc (n_values * sizeof (int16));
+  float *fvalues = (float*) malloc (n_values * sizeof (float));
+  for (size_t i = 0; i < n_values; i++)
+    {
+      svalues[i] = GINT16_TO_LE (int16 (i * 8 - 16384));
+      fvalues[i] = i * 0.25;
+    }
+  TASSERT (write (fd, svalues, n_values * sizeof (int16)) == ssize_t (n_values * sizeof (int16)));
+  TASSERT (write (fd, fvalues, n_values * sizeof (float)) == ssize_t (n_values * sizeof (float)));
+  close (fd);
+  GslDataHandle *shandle = gsl_wave_handle_new (fname, 1, GSL_WAVE_FORMAT_SIGNED_16, G_LITTLE_ENDIAN,
+                                                44100, 440, header, n_values, NULL);
+  GslDataHandle *fhandle = gsl_wave_handle_new (fname, 1, GSL_WAVE_FORMAT_FLOAT, G_BYTE_ORDER,
+                                                44100, 440, header + n_values * sizeof (int16), -1, NULL);
+  TASSERT (gsl_data_handle_open (shandle) == Bse::Error::NONE);
+  TASSERT (gsl_data_handle_open (fhandle) == Bse::Error::NONE);
+  unlink (fname);       // the shared mapping keeps the contents accessible
+  TASSERT (gsl_data_handle_n_values (shandle) == int64 (n_values));
+  TASSERT (gsl_data_handle_n_values (fhandle) == int64 (n_values));
+  float buffer[256];
+  for (size_t offset = 0; offset < n_values; offset += 256)
+    {
+      int64 l = gsl_data_handle_read (shandle, offset, 256, buffer);
+      TASSERT (l == 256);
+      for (size_t i = 0; i < 256; i++)
+        TASSERT (buffer[i] == int16 ((offset + i) * 8 - 16384) * (1. / 32768.));
+      l = gsl_data_handle_read (fhandle, offset, 256, buffer);
+      TASSERT (l == 256);
+      TASSERT (memcmp (buffer, fvalues + offset, sizeof (buffer)) == 0);
+    }
+  int64 n_mapped = 0;
+  const float *mapped = gsl_wave_handle_mapped_floats (fhandle, 17, &n_mapped);
+  if (mapped)   // mmap() may be unavailable
+    {
+      TASSERT (n_mapped == int64 (n_values - 17));
+      TASSERT (memcmp (mapped, fvalues + 17, n_mapped * sizeof (float)) == 0);
+    }
+  TASSERT (gsl_wave_handle_mapped_floats (shandle, 0, &n_mapped) == NULL && n_mapped == 0);
+  gsl_data_handle_close (shandle);
+  gsl_data_handle_close (fhandle);
+  gsl_data_handle_unref (shandle);
+  gsl_data_handle_unref (fhandle);
+  free (svalues);
+  free (fvalues);
+}
+TEST_ADD (mapped_wave_handle_test);
+
+static void
+hashed_file_read_test()
+{
+  const size_t n_bytes = 256 * 1024;
+  char fname[] = "/tmp/testwavechunk-XXXXXX";
+  const int fd = mkstemp (fname);
+  TASSERT (fd >= 0);
+  std::vector<guint8> data (n_bytes);
+  for (size_t i = 0; i < n_bytes; i++)
+    data[i] = (i * 2654435761u) >> 13;
+  TASSERT (write (fd, data.data(), n_bytes) == ssize_t (n_bytes));
+  close (fd);
+  GslHFile *hfile = gsl_hfile_open (fname);
+  TASSERT (hfile != NULL);
+  unlink (fname);
+  // concurrent readers share one descriptor and need no file position
+  std::atomic<int> n_errors { 0 };
+  std::atomic<guint64> n_read { 0 };
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++)
+    threads.push_back (std::thread ([&, t] () {
+          for (int k = 0; k < 64; k++)
+            {
+              guint8 block[1000];
+              const GslLong offset = (k * 7919 + t * 104729) % n_bytes;
+              const GslLong l = gsl_hfile_pread (hfile, offset, sizeof (block), block);
+              if (l != MIN (GslLong (sizeof (block)), GslLong (n_bytes) - offset) || memcmp (block, &data[offset], l) != 0)
+                n_errors++;
+              n_read += MAX (l, 0);
+            }
+        }));
+  for (auto &thread : threads)
+    thread.join();
+  TASSERT (n_errors == 0);
+  GslHFileStats stats;
+  gsl_hfile_stats (hfile, &stats);
+  TASSERT (stats.n_reads == 4 * 64);
+  TASSERT (stats.n_bytes == n_read);
+  gsl_hfile_close (hfile);
+  // writable files are not mapped, reads after a truncation yield zeros
+  char tname[] = "/tmp/testwavechunk-XXXXXX";
+  const int tfd = mkstemp (tname);
+  TASSERT (tfd >= 0);
+  TASSERT (write (tfd, data.data(), n_bytes) == ssize_t (n_bytes));
+  hfile = gsl_hfile_open (tname);
+  TASSERT (hfile != NULL);
+  TASSERT (gsl_hfile_mmap (hfile) == NULL);
+  TASSERT (ftruncate (tfd, n_bytes / 2) == 0);
+  close (tfd);
+  unlink (tname);
+  guint8 block[1000];
+  TASSERT (gsl_hfile_pread (hfile, n_bytes / 2 - 500, sizeof (block), block) == 500);
+  TASSERT (memcmp (block, &data[n_bytes / 2 - 500], 500) == 0);
+  TASSERT (gsl_hfile_pread (hfile, n_bytes - 600, sizeof (block), block) == 600);
+  for (size_t i = 0; i < 600; i++)
+    TASSERT (block[i] == 0);
+  TASSERT (gsl_hfile_mmap (hfile) == NULL);
+  gsl_hfile_close (hfile);
+  // read-only files are mapped
+  char rname[] = "/tmp/testwavechunk-XXXXXX";
+  const int rfd = mkstemp (rname);
+  TASSERT (rfd >= 0);
+  TASSERT (write (rfd, data.data(), n_bytes) == ssize_t (n_bytes));
+  TASSERT (fchmod (rfd, 0444) == 0);
+  close (rfd);
+  hfile = gsl_hfile_open (rname);
+  TASSERT (hfile != NULL);
+  const guint8 *mdata = gsl_hfile_mmap (hfile);
+  TASSERT (mdata != NULL);
+  TASSERT (memcmp (mdata, data.data(), n_bytes) == 0);
+  TASSERT (gsl_hfile_mmap (hfile) == mdata);
+  gsl_hfile_close (hfile);
+  unlink (rname);
+}
+TEST_ADD (hashed_file_read_test);
+
+static void
+sample_conversion_test()
+{
+  // SIMD conversions must be bit identical to the scalar code, including rounding and clipping
+  constexpr const uint N_VALUES = 1037;
+  std::vector<float> values (N_VALUES), fscalar (N_VALUES), fsimd (N_VALUES);
+  std::vector<uint8> bscalar (N_VALUES * 4), bsimd (N_VALUES * 4);
+  for (uint i = 0; i < N_VALUES; i++)
+    values[i] = i % 3 ? g_random_double_range (-1.5, 1.5) : (int (i) - 512 + 0.5) / (128 << i % 4 * 4);
+  for (uint f = GSL_WAVE_FORMAT_NONE + 1; f < GSL_WAVE_FORMAT_LAST; f++)
+    for (uint byte_order : { G_LITTLE_ENDIAN, G_BIG_ENDIAN })
+      {
+        const GslWaveFormatType format = GslWaveFormatType (f);
+        if (!GSL_WAVE_FORMAT_IS_LAW (format))   // the law formats are decode only
+          {
+            gsl_conv_simd_disable (true);
+            const uint nscalar = gsl_conv_from_float_clip (format, byte_order, values.data(), bscalar.data(), N_VALUES);
+            gsl_conv_simd_disable (false);
+            const uint nsimd = gsl_conv_from_float_clip (format, byte_order, values.data(), bsimd.data(), N_VALUES);
+            TCMP (nscalar, ==, nsimd);
+            TASSERT (memcmp (bscalar.data(), bsimd.data(), nscalar) == 0);
+          }
+        else
+          for (uint i = 0; i < N_VALUES; i++)
+            bscalar[i] = g_random_int();
+        gsl_conv_simd_disable (true);
+        gsl_conv_to_float (format, byte_order, bscalar.data(), fscalar.data(), N_VALUES);
+        gsl_conv_simd_disable (false);
+        gsl_conv_to_float (format, byte_order, bscalar.data(), fsimd.data(), N_VALUES);
+        TASSERT (memcmp (fscalar.data(), fsimd.data(), N_VALUES * sizeof (float)) == 0);
+      }
+}
+TEST_ADD (sample_conversion_test);
+
+static void
+seek_index_cache_test()
+{
+  char fname[] = "/tmp/testwavechunk-XXXXXX";
+  const int fd = mkstemp (fname);
+  TASSERT (fd >= 0);
+  const char junk[] = "0123456789abcdef";
+  TASSERT (write (fd, junk, sizeof (junk)) == ssize_t (sizeof (junk)));
+  GslHFile *hfile = gsl_hfile_open (fname);
+  TASSERT (hfile != NULL);
+  // round trip, indexes are distinguished by tag
+  const std::vector<guint64> index = { 0, 0, 4096, 1024, 8192, 2048, ~guint64 (0) };
+  std::vector<guint64> loaded;
+  gsl_hfile_index_store (hfile, "test:1", index);
+  TASSERT (gsl_hfile_index_load (hfile, "test:1", loaded) && loaded == index);
+  TASSERT (!gsl_hfile_index_load (hfile, "test:2", loaded));
+  const guint64 content_id = gsl_hfile_content_id (hfile, "test:1");
+  TASSERT (content_id != 0 && content_id != gsl_hfile_content_id (hfile, "test:2"));
+  // an open handle keeps describing the contents it was opened with
+  TASSERT (write (fd, junk, sizeof (junk)) == ssize_t (sizeof (junk)));
+  close (fd);
+  TASSERT (gsl_hfile_index_load (hfile, "test:1", loaded) && loaded == index);
+  TASSERT (gsl_hfile_content_id (hfile, "test:1") == content_id);
+  // reopening the modified file invalidates its indexes and content ids
+  GslHFile *hfile2 = gsl_hfile_open (fname);
+  TASSERT (hfile2 != NULL && hfile2 != hfile);
+  TASSERT (!gsl_hfile_index_load (hfile2, "test:1", loaded));
+  TASSERT (gsl_hfile_content_id (hfile2, "test:1") != content_id);
+  gsl_hfile_close (hfile2);
+  gsl_hfile_close (hfile);
+  unlink (fname);
+}
+TEST_ADD (seek_index_cache_test);
+
+static void
+vorbis_index_seek_test()
+{
+  // encode a few seconds of a sweep, so every block differs
+  const guint mix_freq = 44100, n_values = mix_freq * 4;
+  std::vector<float> pcm (n_values);
+  for (guint i = 0; i < n_values; i++)
+    pcm[i] = 0.5 * sin (i * (0.01 + i * 1e-7));
+  char fname[] = "/tmp/testwavechunk-XXXXXX";
+  const int fd = mkstemp (fname);
+  TASSERT (fd >= 0);
+  GslVorbisEncoder *enc = gsl_vorbis_encoder_new ();
+  gsl_vorbis_encoder_set_quality (enc, 3);
+  gsl_vorbis_encoder_set_n_channels (enc, 1);
+  gsl_vorbis_encoder_set_sample_freq (enc, mix_freq);
+  TASSERT (gsl_vorbis_encoder_setup_stream (enc, gsl_vorbis_make_serialno()) == 0);
+  gsl_vorbis_encoder_write_pcm (enc, n_values, pcm.data());
+  gsl_vorbis_encoder_pcm_done (enc);
+  while (!gsl_vorbis_encoder_ogg_eos (enc))
+    {
+      guint8 buf[16 * 1024];
+      const guint l = gsl_vorbis_encoder_read_ogg (enc, sizeof (buf), buf);
+      TASSERT (write (fd, buf, l) == ssize_t (l));
+    }
+  gsl_vorbis_encoder_destroy (enc);
+  close (fd);
+  // decode sequentially, then compare against reads that seek through the page index
+  GslDataHandle *dhandle = gsl_data_handle_new_ogg_vorbis_muxed (fname, 0, 440);
+  TASSERT (dhandle != NULL);
+  TASSERT (gsl_data_handle_open (dhandle) == 0);
+  const int64 length = gsl_data_handle_length (dhandle);
+  TASSERT (length >= n_values);
+  std::vector<float> decoded (length);
+  for (int64 n = 0; n < length; )
+    {
+      const int64 l = gsl_data_handle_read (dhandle, n, length - n, &decoded[n]);
+      TASSERT (l > 0);
+      n += l;
+    }
+  for (int64 offset : { int64 (length * 3 / 4), int64 (length / 3), int64 (17), int64 (length / 2 + 4711), int64 (length - 100) })
+    {
+      float block[1024];
+      const int64 l = gsl_data_handle_read (dhandle, offset, 1024, block);
+      TASSERT (l > 0);
+      for (int64 i = 0; i < l; i++)
+        TCMP (fabs (block[i] - decoded[offset + i]), <, 1e-6);
+    }
+  gsl_data_handle_close (dhandle);
+  gsl_data_handle_unref (dhandle);
+  unlink (fname);
+}
+TEST_ADD (vorbis_index_seek_test);
@@ -2,6 +2,7 @@
 #include "bsetool.hh"
 #include <bse/bse.hh>
 #include <sys/resource.h>
+#include <sys/wait.h>
 #include <unistd.h>
 #include <stdio.h>
 
@@ -268,44 +269,137 @@ static CommandRegistry standard_synth_cmd (standard_synth_options, standard_synt
 // == render2wav ==
 static ArgDescription render2wav_options[] = {
   { "-s, --seconds", "<seconds>", "Number of seconds to record", "0" },
+  { "-j, --jobs",    "<jobs>",    "Number of projects to render in parallel, 0 for all CPUs", "1" },
+  { "--realtime",    "",          "Render through the configured PCM driver in realtime", "" },
   { "<bse-file>",    "",          "The BSE file for audio rendering", "" },
   { "<wav-file>",    "",          "The WAV file to use for audio output", "" },
+  { "[files...]",    "",          "Further pairs of BSE and WAV files to render", "" },
 };
 
+static StringVector bse_startup_args; // --bse-* arguments consumed by Bse::init_args()
+
 static String
-render2wav (const ArgParser &ap)
+render2wav_project (const String &bsefile, const String &wavfile, double n_seconds, bool realtime)
 {
-  const String bsefile = ap["bse-file"];
-  const String wavfile = ap["wav-file"];
-  const double n_seconds = string_to_double (ap["seconds"]);
   auto project = BSE_SERVER.create_project (bsefile);
   project->auto_deactivate (0);
   auto err = project->restore_from_file (bsefile);
   if (err != 0)
-    return bse_error_blurb (err);
+    return string_format ("%s: %s", bsefile, bse_error_blurb (err));
+  BSE_SERVER.offline_rendering (!realtime);
   BSE_SERVER.start_recording (wavfile, n_seconds);
+  const uint64 start_stamp = Bse::TickStamp::current();
+  const uint64 start_usecs = timestamp_realtime();
   err = project->play();
+  if (err != 0)
+    return string_format ("%s: %s", bsefile, bse_error_blurb (err));
   printq ("Recording %s to %s...\n", bsefile, wavfile);
   printq (".");
+  uint64 last_usecs = 0;
   int counter = 0;
   while (project->is_playing())
     {
-      if (counter == 0)
-        printq ("\b*");
-      else if (counter == 25)
-        printq ("\bo");
-      if (g_main_context_pending (bse_main_context))
-        g_main_context_iteration (bse_main_context, false);
-      else
-        usleep (10 * 1000);
-      counter = (counter + 1) % 50;
+      const uint64 now_usecs = timestamp_realtime();
+      if (now_usecs >= last_usecs + 200 * 1000)
+        {
+          printq (counter ? "\bo" : "\b*");
+          counter ^= 1;
+          last_usecs = now_usecs;
+        }
+      // block until the engine, sequencer or recorder post new work
+      g_main_context_iteration (bse_main_context, true);
     }
+  const double elapsed = (timestamp_realtime() - start_usecs) * 0.000001;
+  const double rendered = (Bse::TickStamp::current() - start_stamp) / double (bse_engine_sample_freq());
   printq ("\n");
+  printq ("%s: rendered %.2f seconds in %.2f seconds, realtime factor: %.2f\n",
+          wavfile, rendered, elapsed, rendered / std::max (elapsed, 0.000001));
+  return "";
+}
 
+static String
+render2wav_parallel (const std::vector<std::pair<String,String>> &files, size_t n_jobs, const ArgParser &ap)
+{
+  // fork+exec one bsetool process per project, each process runs its own engine
+  std::vector<StringVector> cmdlines;
+  for (const auto &pair : files)
+    {
+      StringVector args = { executable_path() };
+      args.insert (args.end(), bse_startup_args.begin(), bse_startup_args.end());
+      if (!BseTool::verbose)
+        args.push_back ("--quiet");
+      args.push_back ("render2wav");
+      args.push_back ("--seconds=" + ap["seconds"]);
+      if (string_to_bool (ap["realtime"]))
+        args.push_back ("--realtime");
+      args.push_back ("--");
+      args.push_back (pair.first);
+      args.push_back (pair.second);
+      cmdlines.push_back (args);
+    }
+  const uint64 start_usecs = timestamp_realtime();
+  std::vector<pid_t> children;
+  size_t next = 0, n_failed = 0;
+  while (next < cmdlines.size() || children.size())
+    {
+      if (next < cmdlines.size() && children.size() < n_jobs)
+        {
+          std::vector<char*> argv;
+          for (const String &arg : cmdlines[next])
+            argv.push_back (const_cast<char*> (arg.c_str()));
+          argv.push_back (nullptr);
+          const pid_t pid = fork();
+          if (pid == 0)
+            {
+              execv (argv[0], argv.data());
+              _exit (127);
+            }
+          if (pid < 0)
+            return string_format ("failed to fork: %s", strerror (errno));
+          children.push_back (pid);
+          next++;
+          continue;
+        }
+      int status = 0;
+      const pid_t pid = waitpid (-1, &status, 0);
+      if (pid < 0 && errno == EINTR)
+        continue;
+      if (pid < 0)
+        return string_format ("failed to wait for child process: %s", strerror (errno));
+      auto it = std::find (children.begin(), children.end(), pid);
+      if (it == children.end())
+        continue;
+      children.erase (it);
+      if (!WIFEXITED (status) || WEXITSTATUS (status) != 0)
+        n_failed++;
+    }
+  printq ("Rendered %u projects with %u jobs in %.2f seconds\n", files.size(), n_jobs,
+          (timestamp_realtime() - start_usecs) * 0.000001);
+  if (n_failed)
+    return string_format ("failed to render %u of %u projects", n_failed, files.size());
   return "";
 }
 
-static CommandRegistry render2wav_cmd (render2wav_options, render2wav, "render2wav", "Render audio from a .bse file into a WAV file");
+static String
+render2wav (const ArgParser &ap)
+{
+  std::vector<std::pair<String,String>> files;
+  files.push_back ({ ap["bse-file"], ap["wav-file"] });
+  const StringVector &dynamics = ap.dynamics();
+  if (dynamics.size() & 1)
+    return string_format ("missing WAV file for: %s", dynamics.back());
+  for (size_t i = 0; i + 1 < dynamics.size(); i += 2)
+    files.push_back ({ dynamics[i], dynamics[i + 1] });
+  const double n_seconds = string_to_double (ap["seconds"]);
+  const bool realtime = string_to_bool (ap["realtime"]);
+  if (files.size() == 1)
+    return render2wav_project (files[0].first, files[0].second, n_seconds, realtime);
+  const int64 jobs = string_to_int (ap["jobs"]);
+  const size_t n_jobs = jobs > 0 ? jobs : this_thread_online_cpus();
+  return render2wav_parallel (files, n_jobs, ap);
+}
+
+static CommandRegistry render2wav_cmd (render2wav_options, render2wav, "render2wav", "Render audio from .bse files into WAV files, faster than realtime");
 
 
 // == check-load ==
@@ -543,7 +637,12 @@ bsetool_main (int argc_int, char *argv[])
 int
 main (int argc, char *argv[])
 {
+  const std::vector<char*> cmdline (argv, argv + argc);
   Bse::StringVector args = Bse::init_args (&argc, argv);
+  // keep the --bse-* arguments around for child processes spawned by render2wav
+  for (size_t i = 1; i < cmdline.size(); i++)
+    if (std::find (argv + 1, argv + argc, cmdline[i]) == argv + argc)
+      bse_startup_args.push_back (cmdline[i]);
   Bse::init_async ("bsetool", args);
   const auto ret = Bse::jobs += [argc, argv] () {
     return bsetool_main (argc, argv);
@@ -5,6 +5,7 @@
 #include <bse/bseloader.hh>
 #include <bse/gslvorbis-enc.hh>
 #include <bse/gsldatahandle-vorbis.hh>
+#include <bse/bseresampler.hh>
 #include <bse/testing.hh>
 #include "../topbuildid.hh"
 #include "bse/internal.hh"
@@ -2745,6 +2746,87 @@ public:
   }
 } cmd_downsample2 ("downsample2");
 
+class Resample : public Command {
+private:
+  vector<gfloat> m_freq_list;
+  bool           m_all_chunks;
+  int            m_precision_bits;
+  double         m_mix_freq;
+public:
+  Resample (const char *command_name) :
+    Command (command_name),
+    m_all_chunks (false),
+    m_precision_bits (24),
+    m_mix_freq (0)
+  {
+  }
+  void
+  blurb (bool bshort)
+  {
+    printout ("--mix-freq <freq> [options]\n");
+    if (bshort)
+      return;
+    printout ("    Resample wave data to an arbitrary sampling frequency.\n");
+    printout ("    --mix-freq <freq>       set the new sampling frequency\n");
+    printout ("    --precision <bits>      set resampler precision bits [%d]\n", m_precision_bits);
+    printout ("                            supported precisions: 1, 8, 12, 16, 20, 24\n");
+    printout ("                            1 is a special value for linear interpolation\n");
+    printout ("    -f <osc-freq>           oscillator frequency to select a wave chunk\n");
+    printout ("    -m <midi-note>          alternative way to specify oscillator frequency\n");
+    printout ("    --chunk-key <key>       select wave chunk using chunk key from list-chunks\n");
+    printout ("    --all-chunks            resample all chunks\n");
+    /*       "**********1*********2*********3*********4*********5*********6*********7*********" */
+  }
+  guint
+  parse_args (guint  argc,
+              char **argv)
+  {
+    bool seen_selection = false;
+
+    for (guint i = 1; i < argc; i++)
+      {
+	const gchar *str = NULL;
+	if (parse_chunk_selection (argv, i, argc, m_all_chunks, m_freq_list))
+          seen_selection = true;
+	else if (parse_str_option (argv, i, "--precision", &str, argc))
+	  m_precision_bits = atoi (str);
+	else if (parse_str_option (argv, i, "--mix-freq", &str, argc))
+	  m_mix_freq = g_ascii_strtod (str, NULL);
+      }
+    if (!seen_selection) /* default to all chunks */
+      m_all_chunks = true;
+    return (m_mix_freq <= 0); // missing args
+  }
+  bool
+  exec (Wave *wave)
+  {
+    /* get the wave into storage order */
+    wave->sort();
+    for (list<WaveChunk>::iterator it = wave->chunks.begin(); it != wave->chunks.end(); it++)
+      if (m_all_chunks || wave->match (*it, m_freq_list))
+        {
+          WaveChunk *chunk = &*it;
+          GslDataHandle *dhandle = chunk->dhandle;
+          Bse::info ("RESAMPLE: chunk %f: mix_freq=%f -> mix_freq=%f",
+                     gsl_data_handle_osc_freq (chunk->dhandle),
+                     gsl_data_handle_mix_freq (chunk->dhandle),
+                     m_mix_freq);
+          Bse::info ("  using resampler precision: %s\n",
+                     Bse::Resampler2::precision_name (Bse::Resampler2::find_precision_for_bits (m_precision_bits)));
+
+          Bse::Error error = chunk->change_dhandle (bse_data_handle_new_resample (dhandle, m_mix_freq, m_precision_bits), 0, 0);
+          if (error != 0)
+            {
+              app_error ("chunk % 7.2f/%.0f: %s",
+                         gsl_data_handle_osc_freq (chunk->dhandle), gsl_data_handle_mix_freq (chunk->dhandle),
+                         bse_error_blurb (error));
+              _exit (1);
+            }
+        }
+    return true;
+  }
+} cmd_resample ("resample");
+
 class Export : public Command {
 public:
   vector<gfloat> freq_list;